@@ -21,6 +21,7 @@
 
 #include "gui/EventRecorder.h"
 
+#include "common/config-manager.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 
@@ -42,19 +43,18 @@ namespace Audio {
  */
 class Channel {
 public:
-	Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream, DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent);
+	Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream, DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent, RateConverterQuality quality);
 	~Channel();
 
 	/**
 	 * Mixes the channel's samples into the given buffer.
 	 *
-	 * @param data buffer where to mix the data
+	 * @param data buffer of 32-bit accumulators where to mix the data
 	 * @param len  number of sample *pairs*. So a value of
-	 *             10 means that the buffer contains twice 10 sample, each
-	 *             16 bits, for a total of 40 bytes.
+	 *             10 means that the buffer contains twice 10 samples.
 	 * @return number of sample pairs processed (which can still be silence!)
 	 */
-	int mix(int16 *data, uint len);
+	int mix(st_mix_t *data, uint len);
 
 	/**
 	 * Queries whether the channel is still playing or not.
@@ -177,10 +177,14 @@ private:
 #pragma mark -
 
 MixerImpl::MixerImpl(uint sampleRate, uint outBufSize)
-	: _mutex(), _sampleRate(sampleRate), _outBufSize(outBufSize), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
+	: _mutex(), _sampleRate(sampleRate), _outBufSize(outBufSize), _mixerReady(false), _handleSeed(0), _soundTypeSettings(),
+	  _mixBuffer(nullptr), _mixBufferSize(0), _rateConverterQuality(kRateConverterDefault) {
 
 	assert(sampleRate > 0);
 
+	if (ConfMan.hasKey("resampler_quality"))
+		_rateConverterQuality = (RateConverterQuality)CLIP<int>(ConfMan.getInt("resampler_quality"), kRateConverterDefault, kRateConverterHigh);
+
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		_channels[i] = nullptr;
 }
@@ -188,6 +192,8 @@ MixerImpl::MixerImpl(uint sampleRate, uint outBufSize)
 MixerImpl::~MixerImpl() {
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		delete _channels[i];
+
+	free(_mixBuffer);
 }
 
 void MixerImpl::setReady(bool ready) {
@@ -268,7 +274,7 @@ void MixerImpl::playStream(
 #endif
 
 	// Create the channel
-	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent);
+	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent, _rateConverterQuality);
 	chan->setVolume(volume);
 	chan->setBalance(balance);
 	insertChannel(handle, chan);
@@ -287,8 +293,17 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 	// Since the mixer callback has been called, the mixer must be ready...
 	_mixerReady = true;
 
+	// Channels are accumulated in 32 bits and clamped once at the end
+	if (2 * len > _mixBufferSize) {
+		free(_mixBuffer);
+		_mixBufferSize = 2 * len;
+		_mixBuffer = (st_mix_t *)malloc(_mixBufferSize * sizeof(st_mix_t));
+		if (!_mixBuffer)
+			error("[MixerImpl::mixCallback] Cannot allocate memory for mix buffer");
+	}
+
 	//  zero the buf
-	memset(buf, 0, 2 * len * sizeof(int16));
+	memset(_mixBuffer, 0, 2 * len * sizeof(st_mix_t));
 
 	// mix all channels
 	int res = 0, tmp;
@@ -298,13 +313,15 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 				delete _channels[i];
 				_channels[i] = nullptr;
 			} else if (!_channels[i]->isPaused()) {
-				tmp = _channels[i]->mix(buf, len);
+				tmp = _channels[i]->mix(_mixBuffer, len);
 
 				if (tmp > res)
 					res = tmp;
 			}
 		}
 
+	clampMixBuffer(buf, _mixBuffer, 2 * len);
+
 	return res;
 }
 
@@ -515,7 +532,7 @@ int MixerImpl::getVolumeForSoundType(SoundType type) const {
 #pragma mark -
 
 Channel::Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream,
-				 DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent)
+				 DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent, RateConverterQuality quality)
 	: _type(type), _mixer(mixer), _id(id), _permanent(permanent), _volume(Mixer::kMaxChannelVolume),
 	  _balance(0), _pauseLevel(0), _samplesConsumed(0), _samplesDecoded(0), _mixerTimeStamp(0),
 	  _pauseStartTime(0), _pauseTime(0), _converter(nullptr), _volL(0), _volR(0),
@@ -524,7 +541,7 @@ Channel::Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream,
 	assert(stream);
 
 	// Get a rate converter instance
-	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), reverseStereo);
+	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), reverseStereo, quality);
 }
 
 Channel::~Channel() {
@@ -634,7 +651,7 @@ void Channel::loop() {
 	}
 }
 
-int Channel::mix(int16 *data, uint len) {
+int Channel::mix(st_mix_t *data, uint len) {
 	assert(_stream);
 
 	int res = 0;
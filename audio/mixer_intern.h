@@ -25,6 +25,7 @@
 #include "common/scummsys.h"
 #include "common/mutex.h"
 #include "audio/mixer.h"
+#include "audio/rate.h"
 
 namespace Audio {
 
@@ -78,6 +79,13 @@ private:
 	SoundTypeSettings _soundTypeSettings[4];
 	Channel *_channels[NUM_CHANNELS];
 
+	/** Intermediate 32-bit buffer all channels are mixed into before clamping. */
+	st_mix_t *_mixBuffer;
+	uint _mixBufferSize;
+
+	/** Quality of the rate converters used for new channels. */
+	RateConverterQuality _rateConverterQuality;
+
 
 public:
 
@@ -30,10 +30,20 @@
 #include "audio/audiostream.h"
 #include "audio/rate.h"
 #include "audio/mixer.h"
+#include "common/algorithm.h"
 #include "common/frac.h"
+#include "common/math.h"
 #include "common/textconsole.h"
 #include "common/util.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define AUDIO_RATE_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define AUDIO_RATE_NEON
+#endif
+
 namespace Audio {
 
 
@@ -56,6 +66,19 @@ enum {
 	FRAC_HALF_LOW = (1L << (FRAC_BITS_LOW-1))
 };
 
+/**
+ * Add a single scaled sample to the output buffer. The 16-bit variant clamps
+ * on every call, the 32-bit variant only accumulates and leaves clamping to
+ * clampMixBuffer().
+ */
+static inline void mixSample(st_sample_t &a, int b) {
+	clampedAdd(a, b);
+}
+
+static inline void mixSample(st_mix_t &a, int b) {
+	a += b;
+}
+
 /**
  * Audio rate converter based on simple resampling. Used when no
  * interpolation is required.
@@ -78,7 +101,14 @@ protected:
 
 public:
 	SimpleRateConverter(st_rate_t inrate, st_rate_t outrate);
-	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) override;
+	template<typename T>
+	int flowInternal(AudioStream &input, T *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r);
+	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) override {
+		return flowInternal(input, obuf, osamp, vol_l, vol_r);
+	}
+	int flow(AudioStream &input, st_mix_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) override {
+		return flowInternal(input, obuf, osamp, vol_l, vol_r);
+	}
 	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) override {
 		return ST_SUCCESS;
 	}
@@ -111,8 +141,9 @@ SimpleRateConverter<stereo, reverseStereo>::SimpleRateConverter(st_rate_t inrate
  * Return number of sample pairs processed.
  */
 template<bool stereo, bool reverseStereo>
-int SimpleRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
-	st_sample_t *ostart, *oend;
+template<typename T>
+int SimpleRateConverter<stereo, reverseStereo>::flowInternal(AudioStream &input, T *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+	T *ostart, *oend;
 
 	ostart = obuf;
 	oend = obuf + osamp * 2;
@@ -143,10 +174,10 @@ int SimpleRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 		opos += opos_inc;
 
 		// output left channel
-		clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+		mixSample(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
 
 		// output right channel
-		clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+		mixSample(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
 
 		obuf += 2;
 	}
@@ -184,7 +215,14 @@ protected:
 
 public:
 	LinearRateConverter(st_rate_t inrate, st_rate_t outrate);
-	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) override;
+	template<typename T>
+	int flowInternal(AudioStream &input, T *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r);
+	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) override {
+		return flowInternal(input, obuf, osamp, vol_l, vol_r);
+	}
+	int flow(AudioStream &input, st_mix_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) override {
+		return flowInternal(input, obuf, osamp, vol_l, vol_r);
+	}
 	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) override {
 		return ST_SUCCESS;
 	}
@@ -220,8 +258,9 @@ LinearRateConverter<stereo, reverseStereo>::LinearRateConverter(st_rate_t inrate
  * Return number of sample pairs processed.
  */
 template<bool stereo, bool reverseStereo>
-int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
-	st_sample_t *ostart, *oend;
+template<typename T>
+int LinearRateConverter<stereo, reverseStereo>::flowInternal(AudioStream &input, T *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+	T *ostart, *oend;
 
 	ostart = obuf;
 	oend = obuf + osamp * 2;
@@ -258,10 +297,10 @@ int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 						  out0);
 
 			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+			mixSample(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
 
 			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+			mixSample(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
 
 			obuf += 2;
 
@@ -273,6 +312,152 @@ int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 }
 
 
+#pragma mark -
+
+static bool s_useSIMDMixing = true;
+
+void setUseSIMDMixing(bool useSIMD) {
+	s_useSIMDMixing = useSIMD;
+}
+
+/**
+ * Vectorized mixing of a block of input samples into 32-bit accumulators.
+ *
+ * SSE2 is part of the x86-64 baseline and NEON of the AArch64 one, so the
+ * kernel is selected at compile time. Other targets (or volumes which do not
+ * fit in a signed 16-bit lane) use the scalar code in the converters.
+ *
+ * @return Number of sample pairs that were mixed, always a multiple of 4.
+ */
+template<bool stereo, bool reverseStereo>
+static st_size_t mixBlock(st_mix_t *obuf, const st_sample_t *ibuf, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r) {
+#if defined(AUDIO_RATE_SSE2) || defined(AUDIO_RATE_NEON)
+	if (!s_useSIMDMixing || vol_l > 0x7fff || vol_r > 0x7fff)
+		return 0;
+
+	// Output position 0 of each pair receives the left channel, unless the
+	// stereo image is reversed.
+	const int16 vol0 = reverseStereo ? vol_r : vol_l;
+	const int16 vol1 = reverseStereo ? vol_l : vol_r;
+	const st_size_t blocks = frames & ~3;
+#endif
+
+#if defined(AUDIO_RATE_SSE2)
+	const __m128i vol = _mm_set_epi16(vol1, vol0, vol1, vol0, vol1, vol0, vol1, vol0);
+	const __m128i round = _mm_set1_epi32(Audio::Mixer::kMaxMixerVolume - 1);
+
+	for (st_size_t i = 0; i < blocks; i += 4) {
+		__m128i in;
+		if (stereo) {
+			in = _mm_loadu_si128((const __m128i *)ibuf);
+			if (reverseStereo) {
+				in = _mm_shufflelo_epi16(in, _MM_SHUFFLE(2, 3, 0, 1));
+				in = _mm_shufflehi_epi16(in, _MM_SHUFFLE(2, 3, 0, 1));
+			}
+			ibuf += 8;
+		} else {
+			in = _mm_loadl_epi64((const __m128i *)ibuf);
+			in = _mm_unpacklo_epi16(in, in);
+			ibuf += 4;
+		}
+
+		const __m128i lo = _mm_mullo_epi16(in, vol);
+		const __m128i hi = _mm_mulhi_epi16(in, vol);
+		__m128i p0 = _mm_unpacklo_epi16(lo, hi);
+		__m128i p1 = _mm_unpackhi_epi16(lo, hi);
+
+		// Divide by kMaxMixerVolume, rounding towards zero like the scalar code
+		p0 = _mm_srai_epi32(_mm_add_epi32(p0, _mm_and_si128(_mm_srai_epi32(p0, 31), round)), 8);
+		p1 = _mm_srai_epi32(_mm_add_epi32(p1, _mm_and_si128(_mm_srai_epi32(p1, 31), round)), 8);
+
+		__m128i *out = (__m128i *)obuf;
+		_mm_storeu_si128(out,     _mm_add_epi32(_mm_loadu_si128(out),     p0));
+		_mm_storeu_si128(out + 1, _mm_add_epi32(_mm_loadu_si128(out + 1), p1));
+		obuf += 8;
+	}
+	return blocks;
+#elif defined(AUDIO_RATE_NEON)
+	const int16 volArray[8] = { vol0, vol1, vol0, vol1, vol0, vol1, vol0, vol1 };
+	const int16x8_t vol = vld1q_s16(volArray);
+	const int32x4_t round = vdupq_n_s32(Audio::Mixer::kMaxMixerVolume - 1);
+
+	for (st_size_t i = 0; i < blocks; i += 4) {
+		int16x8_t in;
+		if (stereo) {
+			in = vld1q_s16(ibuf);
+			if (reverseStereo)
+				in = vrev32q_s16(in);
+			ibuf += 8;
+		} else {
+			const int16x4_t mono = vld1_s16(ibuf);
+			const int16x4x2_t dup = vzip_s16(mono, mono);
+			in = vcombine_s16(dup.val[0], dup.val[1]);
+			ibuf += 4;
+		}
+
+		int32x4_t p0 = vmull_s16(vget_low_s16(in), vget_low_s16(vol));
+		int32x4_t p1 = vmull_s16(vget_high_s16(in), vget_high_s16(vol));
+
+		// Divide by kMaxMixerVolume, rounding towards zero like the scalar code
+		p0 = vshrq_n_s32(vaddq_s32(p0, vandq_s32(vshrq_n_s32(p0, 31), round)), 8);
+		p1 = vshrq_n_s32(vaddq_s32(p1, vandq_s32(vshrq_n_s32(p1, 31), round)), 8);
+
+		vst1q_s32(obuf,     vaddq_s32(vld1q_s32(obuf),     p0));
+		vst1q_s32(obuf + 4, vaddq_s32(vld1q_s32(obuf + 4), p1));
+		obuf += 8;
+	}
+	return blocks;
+#else
+	return 0;
+#endif
+}
+
+/**
+ * Output into a 16-bit buffer needs to be clamped per sample, so there is no
+ * vectorized path for it.
+ */
+template<bool stereo, bool reverseStereo>
+static inline st_size_t mixBlock(st_sample_t *obuf, const st_sample_t *ibuf, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r) {
+	return 0;
+}
+
+void clampMixBuffer(st_sample_t *obuf, const st_mix_t *ibuf, st_size_t len) {
+	st_size_t i = 0;
+
+#if defined(AUDIO_RATE_SSE2)
+#ifdef OUTPUT_UNSIGNED_AUDIO
+	const __m128i sign = _mm_set1_epi16((int16)0x8000);
+#endif
+	for (; s_useSIMDMixing && i + 8 <= len; i += 8) {
+		const __m128i a = _mm_loadu_si128((const __m128i *)(ibuf + i));
+		const __m128i b = _mm_loadu_si128((const __m128i *)(ibuf + i + 4));
+		__m128i out = _mm_packs_epi32(a, b);
+#ifdef OUTPUT_UNSIGNED_AUDIO
+		out = _mm_xor_si128(out, sign);
+#endif
+		_mm_storeu_si128((__m128i *)(obuf + i), out);
+	}
+#elif defined(AUDIO_RATE_NEON)
+	for (; s_useSIMDMixing && i + 8 <= len; i += 8) {
+		int16x8_t out = vcombine_s16(vqmovn_s32(vld1q_s32(ibuf + i)), vqmovn_s32(vld1q_s32(ibuf + i + 4)));
+#ifdef OUTPUT_UNSIGNED_AUDIO
+		out = veorq_s16(out, vdupq_n_s16((int16)0x8000));
+#endif
+		vst1q_s16(obuf + i, out);
+	}
+#endif
+
+	for (; i < len; i++) {
+		const int val = CLIP<int>(ibuf[i], ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+#ifdef OUTPUT_UNSIGNED_AUDIO
+		obuf[i] = ((int16)val) ^ 0x8000;
+#else
+		obuf[i] = val;
+#endif
+	}
+}
+
+
 #pragma mark -
 
 
@@ -289,13 +474,14 @@ public:
 		free(_buffer);
 	}
 
-	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) override {
+	template<typename T>
+	int flowInternal(AudioStream &input, T *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
 		assert(input.isStereo() == stereo);
 
 		st_sample_t *ptr;
-		st_size_t len;
+		int len;
 
-		st_sample_t *ostart = obuf;
+		T *ostart = obuf;
 
 		if (stereo)
 			osamp *= 2;
@@ -313,36 +499,358 @@ public:
 		// Read up to 'osamp' samples into our temporary buffer
 		len = input.readBuffer(_buffer, osamp);
 
-		// Mix the data into the output buffer
+		// Mix as much as possible using the vectorized path
 		ptr = _buffer;
+		const st_size_t done = (len > 0) ? mixBlock<stereo, reverseStereo>(obuf, ptr, len / (stereo ? 2 : 1), vol_l, vol_r) : 0;
+		ptr += done * (stereo ? 2 : 1);
+		len -= done * (stereo ? 2 : 1);
+		obuf += done * 2;
+
+		// Mix the remaining data into the output buffer
 		for (; len > 0; len -= (stereo ? 2 : 1)) {
 			st_sample_t out0, out1;
 			out0 = *ptr++;
 			out1 = (stereo ? *ptr++ : out0);
 
 			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+			mixSample(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
 
 			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+			mixSample(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
 
 			obuf += 2;
 		}
 		return (obuf - ostart) / 2;
 	}
 
+	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) override {
+		return flowInternal(input, obuf, osamp, vol_l, vol_r);
+	}
+
+	int flow(AudioStream &input, st_mix_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) override {
+		return flowInternal(input, obuf, osamp, vol_l, vol_r);
+	}
+
+	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) override {
+		return ST_SUCCESS;
+	}
+};
+
+
+#pragma mark -
+
+/**
+ * Number of fractional positions the sinc filter table is computed for. The
+ * position of the output stream is rounded to the nearest of these.
+ */
+enum {
+	SINC_PHASE_BITS = 8,
+	SINC_PHASES = (1 << SINC_PHASE_BITS),
+	SINC_PHASE_SHIFT = (FRAC_BITS_LOW - SINC_PHASE_BITS),
+	SINC_MAX_TAPS = 32,
+	SINC_COEF_BITS = 14
+};
+
+/**
+ * Zeroth order modified Bessel function of the first kind, used to compute
+ * the Kaiser window.
+ */
+static double besselI0(double x) {
+	double sum = 1.0, term = 1.0;
+	for (int k = 1; k < 32; k++) {
+		term *= (x / (2.0 * k)) * (x / (2.0 * k));
+		sum += term;
+		if (term < sum * 1e-12)
+			break;
+	}
+	return sum;
+}
+
+/**
+ * Polyphase filter coefficients for a number of taps and a cutoff.
+ *
+ * The table takes a moment to compute, so it is shared by all converters
+ * using the same filter, e.g. all channels of a game playing its sounds at
+ * the same rate. The list of tables isn't locked: the mixer is the only
+ * user of the sinc converters, and creates and deletes its channels with
+ * its mutex held.
+ */
+struct SincTable {
+	SincTable *next;
+	int refCount;
+
+	int taps;
+	/** ratio of the output and input rate, 1:1 for all upsampling rates */
+	st_rate_t outrate, inrate;
+
+	/** (SINC_PHASES + 1) phases of taps entries */
+	int16 *coefs;
+};
+
+static SincTable *s_sincTables = nullptr;
+
+static void computeSincTable(int16 *table, st_rate_t inrate, st_rate_t outrate, int taps) {
+	// Leave some room for the transition band, and move the cutoff below
+	// the output Nyquist frequency when downsampling.
+	const double rolloff = (taps >= 32) ? 0.95 : 0.90;
+	const double cutoff = rolloff * MIN<double>(1.0, (double)outrate / inrate);
+	const double beta = (taps >= 32) ? 9.0 : 7.0;
+	const double halfWidth = taps / 2;
+	const double i0Beta = besselI0(beta);
+
+	double weights[SINC_MAX_TAPS];
+
+	for (int phase = 0; phase <= SINC_PHASES; phase++) {
+		const double frac = (double)phase / SINC_PHASES;
+		double sum = 0.0;
+
+		for (int k = 0; k < taps; k++) {
+			// Distance from the interpolated position, which lies between
+			// the two samples in the middle of the window.
+			const double t = k - (taps / 2 - 1) - frac;
+			const double x = M_PI * cutoff * t;
+			const double sinc = (fabs(x) < 1e-9) ? 1.0 : sin(x) / x;
+			const double r = t / halfWidth;
+			const double window = (fabs(r) >= 1.0) ? 0.0 : besselI0(beta * sqrt(1.0 - r * r)) / i0Beta;
+
+			weights[k] = sinc * window;
+			sum += weights[k];
+		}
+
+		// Normalize every phase to unity gain, so DC is passed unchanged
+		int16 *coefs = table + phase * taps;
+		for (int k = 0; k < taps; k++)
+			coefs[k] = (int16)floor(weights[k] / sum * (1 << SINC_COEF_BITS) + 0.5);
+	}
+}
+
+static SincTable *acquireSincTable(st_rate_t inrate, st_rate_t outrate, int taps) {
+	// The filter only depends on the ratio of both rates when downsampling
+	if (outrate >= inrate) {
+		outrate = inrate = 1;
+	} else {
+		const st_rate_t div = Common::gcd(inrate, outrate);
+		outrate /= div;
+		inrate /= div;
+	}
+
+	for (SincTable *table = s_sincTables; table; table = table->next) {
+		if (table->taps == taps && table->outrate == outrate && table->inrate == inrate) {
+			table->refCount++;
+			return table;
+		}
+	}
+
+	SincTable *table = new SincTable();
+	table->next = s_sincTables;
+	table->refCount = 1;
+	table->taps = taps;
+	table->outrate = outrate;
+	table->inrate = inrate;
+	table->coefs = new int16[(SINC_PHASES + 1) * taps];
+	computeSincTable(table->coefs, inrate, outrate, taps);
+	s_sincTables = table;
+	return table;
+}
+
+static void releaseSincTable(SincTable *table) {
+	if (--table->refCount > 0)
+		return;
+
+	SincTable **link = &s_sincTables;
+	while (*link != table)
+		link = &(*link)->next;
+	*link = table->next;
+
+	delete[] table->coefs;
+	delete table;
+}
+
+/**
+ * Dot product of a window of input samples and one phase of the filter.
+ * The number of taps must be a multiple of 8.
+ */
+static inline int sincDot(const st_sample_t *x, const int16 *c, int taps) {
+#if defined(AUDIO_RATE_SSE2)
+	__m128i acc = _mm_setzero_si128();
+	for (int k = 0; k < taps; k += 8)
+		acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(x + k)), _mm_loadu_si128((const __m128i *)(c + k))));
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(acc);
+#elif defined(AUDIO_RATE_NEON)
+	int32x4_t acc = vdupq_n_s32(0);
+	for (int k = 0; k < taps; k += 8) {
+		acc = vmlal_s16(acc, vld1_s16(x + k), vld1_s16(c + k));
+		acc = vmlal_s16(acc, vld1_s16(x + k + 4), vld1_s16(c + k + 4));
+	}
+	int32x2_t sum = vadd_s32(vget_low_s32(acc), vget_high_s32(acc));
+	sum = vpadd_s32(sum, sum);
+	return vget_lane_s32(sum, 0);
+#else
+	int acc = 0;
+	for (int k = 0; k < taps; k++)
+		acc += x[k] * c[k];
+	return acc;
+#endif
+}
+
+/**
+ * Audio rate converter based on a polyphase windowed-sinc FIR filter.
+ *
+ * The filter is precomputed for SINC_PHASES fractional positions, each phase
+ * holding 'taps' coefficients. A Kaiser window is applied and the cutoff is
+ * lowered when downsampling, to avoid aliasing.
+ *
+ * The filter introduces a delay of taps / 2 input samples.
+ *
+ * Limited to sampling frequency <= 131071 Hz.
+ */
+template<bool stereo, bool reverseStereo>
+class SincRateConverter : public RateConverter {
+protected:
+	st_sample_t inBuf[INTERMEDIATE_BUFFER_SIZE];
+	const st_sample_t *inPtr;
+	int inLen;
+
+	/** fractional position of the output stream in input stream unit */
+	frac_t opos;
+
+	/** fractional position increment in the output stream */
+	frac_t opos_inc;
+
+	/** number of filter taps per phase */
+	const int _taps;
+
+	/** filter table, shared with the other converters using the same filter */
+	SincTable *_table;
+
+	/** filter coefficients, (SINC_PHASES + 1) phases of _taps entries */
+	const int16 *_coefs;
+
+	/**
+	 * Last _taps input samples per channel. Each sample is stored twice, so
+	 * that the window starting at _histPos is always contiguous.
+	 */
+	st_sample_t _hist0[2 * SINC_MAX_TAPS];
+	st_sample_t _hist1[2 * SINC_MAX_TAPS];
+	int _histPos;
+
+	inline st_sample_t filter(const st_sample_t *hist, const int16 *coefs) const {
+		const int val = (sincDot(hist + _histPos, coefs, _taps) + (1 << (SINC_COEF_BITS - 1))) >> SINC_COEF_BITS;
+		return CLIP<int>(val, ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+	}
+
+public:
+	SincRateConverter(st_rate_t inrate, st_rate_t outrate, int taps);
+	~SincRateConverter() {
+		releaseSincTable(_table);
+	}
+
+	template<typename T>
+	int flowInternal(AudioStream &input, T *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r);
+	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) override {
+		return flowInternal(input, obuf, osamp, vol_l, vol_r);
+	}
+	int flow(AudioStream &input, st_mix_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) override {
+		return flowInternal(input, obuf, osamp, vol_l, vol_r);
+	}
 	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) override {
 		return ST_SUCCESS;
 	}
 };
 
+/*
+ * Prepare processing.
+ */
+template<bool stereo, bool reverseStereo>
+SincRateConverter<stereo, reverseStereo>::SincRateConverter(st_rate_t inrate, st_rate_t outrate, int taps) : _taps(taps) {
+	if (inrate >= 131072 || outrate >= 131072) {
+		error("rate effect can only handle rates < 131072");
+	}
+
+	assert(taps <= SINC_MAX_TAPS && (taps % 8) == 0);
+
+	opos = FRAC_ONE_LOW;
+	opos_inc = (inrate << FRAC_BITS_LOW) / outrate;
+
+	memset(_hist0, 0, sizeof(_hist0));
+	memset(_hist1, 0, sizeof(_hist1));
+	_histPos = 0;
+
+	inLen = 0;
+
+	_table = acquireSincTable(inrate, outrate, taps);
+	_coefs = _table->coefs;
+}
+
+/*
+ * Processed signed long samples from ibuf to obuf.
+ * Return number of sample pairs processed.
+ */
+template<bool stereo, bool reverseStereo>
+template<typename T>
+int SincRateConverter<stereo, reverseStereo>::flowInternal(AudioStream &input, T *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+	T *ostart, *oend;
+
+	ostart = obuf;
+	oend = obuf + osamp * 2;
+
+	while (obuf < oend) {
+
+		// read enough input samples so that opos < 0
+		while ((frac_t)FRAC_ONE_LOW <= opos) {
+			// Check if we have to refill the buffer
+			if (inLen == 0) {
+				inPtr = inBuf;
+				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
+				if (inLen <= 0)
+					return (obuf - ostart) / 2;
+			}
+			inLen -= (stereo ? 2 : 1);
+			_hist0[_histPos] = _hist0[_histPos + _taps] = *inPtr++;
+			if (stereo)
+				_hist1[_histPos] = _hist1[_histPos + _taps] = *inPtr++;
+			if (++_histPos == _taps)
+				_histPos = 0;
+			opos -= FRAC_ONE_LOW;
+		}
+
+		// Loop as long as the outpos trails behind, and as long as there is
+		// still space in the output buffer.
+		while (opos < (frac_t)FRAC_ONE_LOW && obuf < oend) {
+			const int16 *coefs = _coefs + ((opos + (1 << (SINC_PHASE_SHIFT - 1))) >> SINC_PHASE_SHIFT) * _taps;
+
+			st_sample_t out0, out1;
+			out0 = filter(_hist0, coefs);
+			out1 = (stereo ? filter(_hist1, coefs) : out0);
+
+			// output left channel
+			mixSample(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+
+			// output right channel
+			mixSample(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+
+			obuf += 2;
+
+			// Increment output position
+			opos += opos_inc;
+		}
+	}
+	return (obuf - ostart) / 2;
+}
+
 
 #pragma mark -
 
 template<bool stereo, bool reverseStereo>
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate) {
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, RateConverterQuality quality) {
 	if (inrate != outrate) {
-		if ((inrate % outrate) == 0 && (inrate < 65536)) {
+		if (quality == kRateConverterHigh) {
+			return new SincRateConverter<stereo, reverseStereo>(inrate, outrate, 32);
+		} else if (quality == kRateConverterMedium) {
+			return new SincRateConverter<stereo, reverseStereo>(inrate, outrate, 16);
+		} else if ((inrate % outrate) == 0 && (inrate < 65536)) {
 			return new SimpleRateConverter<stereo, reverseStereo>(inrate, outrate);
 		} else {
 			return new LinearRateConverter<stereo, reverseStereo>(inrate, outrate);
@@ -355,14 +863,14 @@ RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate) {
 /**
  * Create and return a RateConverter object for the specified input and output rates.
  */
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo) {
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo, RateConverterQuality quality) {
 	if (stereo) {
 		if (reverseStereo)
-			return makeRateConverter<true, true>(inrate, outrate);
+			return makeRateConverter<true, true>(inrate, outrate, quality);
 		else
-			return makeRateConverter<true, false>(inrate, outrate);
+			return makeRateConverter<true, false>(inrate, outrate, quality);
 	} else
-		return makeRateConverter<false, false>(inrate, outrate);
+		return makeRateConverter<false, false>(inrate, outrate, quality);
 }
 
 } // End of namespace Audio
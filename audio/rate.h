@@ -36,6 +36,7 @@ namespace Audio {
 class AudioStream;
 
 typedef int16 st_sample_t;
+typedef int32 st_mix_t;
 typedef uint16 st_volume_t;
 typedef uint32 st_size_t;
 typedef uint32 st_rate_t;
@@ -81,10 +82,45 @@ public:
 	 */
 	virtual int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) = 0;
 
+	/**
+	 * Same as above, but mixes into a buffer of 32-bit accumulators without
+	 * clamping. The caller is responsible for clamping the result to 16 bits,
+	 * e.g. by using clampMixBuffer().
+	 *
+	 * @return Number of sample pairs written into the buffer.
+	 */
+	virtual int flow(AudioStream &input, st_mix_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) = 0;
+
 	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) = 0;
 };
 
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo = false);
+/**
+ * Quality of the converter used when the input and output rates differ.
+ */
+enum RateConverterQuality {
+	kRateConverterDefault = 0, ///< Nearest sample or linear interpolation
+	kRateConverterMedium = 1,  ///< 16-tap polyphase windowed sinc filter
+	kRateConverterHigh = 2     ///< 32-tap polyphase windowed sinc filter
+};
+
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo = false, RateConverterQuality quality = kRateConverterDefault);
+
+/**
+ * Clamp a buffer of 32-bit accumulators, as filled by RateConverter::flow,
+ * into 16-bit output samples.
+ *
+ * @param obuf Output buffer.
+ * @param ibuf Buffer of accumulated samples.
+ * @param len  Number of samples (not sample pairs) to convert.
+ */
+void clampMixBuffer(st_sample_t *obuf, const st_mix_t *ibuf, st_size_t len);
+
+/**
+ * Enable or disable the vectorized mixing of the rate converters, where the
+ * target supports it. The scalar code is used when disabled, which is meant
+ * for tests and benchmarks comparing both paths.
+ */
+void setUseSIMDMixing(bool useSIMD);
 /** @} */
 } // End of namespace Audio
 
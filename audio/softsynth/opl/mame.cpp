@@ -135,6 +135,9 @@ int EG_AED;
 #define VIB_RATE_SHIFT 8
 #define VIB_RATE (1<<VIB_RATE_SHIFT)
 
+/* samples rendered per channel at once */
+#define OPL_BLOCK 256
+
 /* -------------------- local defines , macros --------------------- */
 
 /* register number to channel number , slot offset */
@@ -505,45 +508,76 @@ inline void set_sl_rr(FM_OPL *OPL, int slot, int v) {
 /* operator output calcrator */
 
 #define OP_OUT(slot,env,con)   slot->wavetable[((slot->Cnt + con)>>(24-SIN_ENT_SHIFT)) & (SIN_ENT-1)][env]
-/* ---------- calcrate one of channel ---------- */
-inline void OPL_CALC_CH(OPL_CH *CH) {
-	uint env_out;
-	OPL_SLOT *SLOT;
-
-	feedback2 = 0;
-	/* SLOT 1 */
-	SLOT = &CH->SLOT[SLOT1];
-	env_out=OPL_CALC_SLOT(SLOT);
-	if (env_out < (uint)(EG_ENT - 1)) {
-		/* PG */
-		if (SLOT->vib)
-			SLOT->Cnt += (SLOT->Incr * vib) >> VIB_RATE_SHIFT;
-		else
-			SLOT->Cnt += SLOT->Incr;
-		/* connection */
-		if (CH->FB) {
-			int feedback1 = (CH->op1_out[0] + CH->op1_out[1]) >> CH->FB;
-			CH->op1_out[1] = CH->op1_out[0];
-			*CH->connect1 += CH->op1_out[0] = OP_OUT(SLOT, env_out, feedback1);
+/* ---------- calcrate one of channel over a block of samples ---------- */
+/* The channel is copied and its outputs kept in locals, so the compiler can
+   keep its state in registers: stores to the output buffer could alias the
+   channel otherwise. */
+static void OPL_CALC_CH(OPL_CH *CH, int *out, const int *amsBlock, const int *vibBlock, int n) {
+	OPL_CH ch = *CH;
+	OPL_SLOT *SLOT1P = &ch.SLOT[SLOT1];
+	OPL_SLOT *SLOT2P = &ch.SLOT[SLOT2];
+	const uint envMax = EG_ENT - 1;
+
+	for (int i = 0; i < n; i++) {
+		uint env_out;
+		int carrier = 0, modulator = 0;
+
+		ams = amsBlock[i];
+		const int vibOut = vibBlock[i];
+
+		/* SLOT 1 */
+		env_out = OPL_CALC_SLOT(SLOT1P);
+		if (env_out < envMax) {
+			/* PG */
+			if (SLOT1P->vib)
+				SLOT1P->Cnt += (SLOT1P->Incr * vibOut) >> VIB_RATE_SHIFT;
+			else
+				SLOT1P->Cnt += SLOT1P->Incr;
+			/* connection */
+			int op;
+			if (ch.FB) {
+				int feedback1 = (ch.op1_out[0] + ch.op1_out[1]) >> ch.FB;
+				ch.op1_out[1] = ch.op1_out[0];
+				op = ch.op1_out[0] = OP_OUT(SLOT1P, env_out, feedback1);
+			} else {
+				op = OP_OUT(SLOT1P, env_out, 0);
+			}
+			if (ch.CON)
+				carrier += op;
+			else
+				modulator = op;
 		} else {
-			*CH->connect1 += OP_OUT(SLOT, env_out, 0);
+			ch.op1_out[1] = ch.op1_out[0];
+			ch.op1_out[0] = 0;
 		}
-	} else {
-		CH->op1_out[1] = CH->op1_out[0];
-		CH->op1_out[0] = 0;
-	}
-	/* SLOT 2 */
-	SLOT = &CH->SLOT[SLOT2];
-	env_out=OPL_CALC_SLOT(SLOT);
-	if (env_out < (uint)(EG_ENT - 1)) {
-		/* PG */
-		if (SLOT->vib)
-			SLOT->Cnt += (SLOT->Incr * vib) >> VIB_RATE_SHIFT;
-		else
-			SLOT->Cnt += SLOT->Incr;
-		/* connection */
-		outd[0] += OP_OUT(SLOT, env_out, feedback2);
+		/* SLOT 2 */
+		env_out = OPL_CALC_SLOT(SLOT2P);
+		if (env_out < envMax) {
+			/* PG */
+			if (SLOT2P->vib)
+				SLOT2P->Cnt += (SLOT2P->Incr * vibOut) >> VIB_RATE_SHIFT;
+			else
+				SLOT2P->Cnt += SLOT2P->Incr;
+			/* connection */
+			carrier += OP_OUT(SLOT2P, env_out, modulator);
+		}
+		out[i] += carrier;
 	}
+
+	*CH = ch;
+}
+
+/* ---------- check if a channel produces no output ---------- */
+/* A slot which has reached EG_OFF stays there until the next key on, and
+   its envelope output then never drops below EG_ENT - 1. Once the feedback
+   history is cleared as well, calculating the channel is a no-op. */
+inline bool OPL_SLOT_SILENT(const OPL_SLOT *SLOT) {
+	return SLOT->evc == EG_OFF && SLOT->evs == 0;
+}
+
+inline bool OPL_CH_SILENT(const OPL_CH *CH) {
+	return OPL_SLOT_SILENT(&CH->SLOT[SLOT1]) && OPL_SLOT_SILENT(&CH->SLOT[SLOT2]) &&
+		CH->op1_out[0] == 0 && CH->op1_out[1] == 0;
 }
 
 /* ---------- calcrate rythm block ---------- */
@@ -1060,22 +1094,58 @@ void YM3812UpdateOne(FM_OPL *OPL, int16 *buffer, int length) {
 		vib_table = OPL->vib_table;
 	}
 	R_CH = rythm ? &S_CH[6] : E_CH;
-	for (i = 0; i < length; i++) {
-		/*            channel A         channel B         channel C      */
+
+	/* Registers are only written between calls, so a channel which is
+	   silent now stays silent for the whole block and can be skipped */
+	OPL_CH *activeCh[9];
+	int numActive = 0;
+	for (CH = S_CH; CH < R_CH; CH++) {
+		if (!OPL_CH_SILENT(CH))
+			activeCh[numActive++] = CH;
+	}
+
+	if (numActive == 0 && !rythm) {
+		/* only the LFO counters advance */
+		memset(buf, 0, length * sizeof(int16));
+		OPL->amsCnt = amsCnt + amsIncr * length;
+		OPL->vibCnt = vibCnt + vibIncr * length;
+		return;
+	}
+
+	/* Render the channels one after the other over a block of samples, so
+	   the state of a channel stays in registers and in the cache. The LFO
+	   outputs are computed for the whole block first. */
+	int amsBlock[OPL_BLOCK], vibBlock[OPL_BLOCK], outBlock[OPL_BLOCK];
+	while (length > 0) {
+		const int n = MIN(length, (int)OPL_BLOCK);
+
 		/* LFO */
-		ams = ams_table[(amsCnt += amsIncr) >> AMS_SHIFT];
-		vib = vib_table[(vibCnt += vibIncr) >> VIB_SHIFT];
-		outd[0] = 0;
+		for (i = 0; i < n; i++) {
+			amsBlock[i] = ams_table[(amsCnt += amsIncr) >> AMS_SHIFT];
+			vibBlock[i] = vib_table[(vibCnt += vibIncr) >> VIB_SHIFT];
+		}
+		memset(outBlock, 0, n * sizeof(int));
 		/* FM part */
-		for (CH = S_CH; CH < R_CH; CH++)
-			OPL_CALC_CH(CH);
+		for (int c = 0; c < numActive; c++)
+			OPL_CALC_CH(activeCh[c], outBlock, amsBlock, vibBlock, n);
 		/* Rythn part */
-		if (rythm)
-			OPL_CALC_RH(OPL, S_CH);
-		/* limit check */
-		data = CLIP(outd[0], OPL_MINOUT, OPL_MAXOUT);
-		/* store to sound buffer */
-		buf[i] = data >> OPL_OUTSB;
+		if (rythm) {
+			for (i = 0; i < n; i++) {
+				ams = amsBlock[i];
+				vib = vibBlock[i];
+				outd[0] = 0;
+				OPL_CALC_RH(OPL, S_CH);
+				outBlock[i] += outd[0];
+			}
+		}
+		for (i = 0; i < n; i++) {
+			/* limit check */
+			data = CLIP(outBlock[i], OPL_MINOUT, OPL_MAXOUT);
+			/* store to sound buffer */
+			buf[i] = data >> OPL_OUTSB;
+		}
+		buf += n;
+		length -= n;
 	}
 
 	OPL->amsCnt = amsCnt;
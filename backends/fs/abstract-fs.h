@@ -41,6 +41,7 @@ typedef Common::Array<AbstractFSNode *>	AbstractFSList;
 class AbstractFSNode {
 protected:
 	friend class Common::FSNode;
+	friend class Common::FSIndex;
 	typedef Common::FSNode::ListMode ListMode;
 
 	/**
@@ -62,6 +63,19 @@ protected:
 	 */
 	virtual AbstractFSNode *getChild(const Common::String &name) const = 0;
 
+	/**
+	 * Returns the child node with the given name, when the caller already
+	 * knows that it exists and whether it is a directory (e.g. because it was
+	 * recorded in a file index). Backends which have to query the file system
+	 * in getChild() can override this to skip that query.
+	 *
+	 * @param name String containing the name of the child to create a new node.
+	 * @param isDirectory Whether the child is a directory.
+	 */
+	virtual AbstractFSNode *getChildWithKnownType(const Common::String &name, bool isDirectory) const {
+		return getChild(name);
+	}
+
 	/**
 	 * The parent node of this directory.
 	 * The parent of the root is the root itself.
@@ -172,6 +186,19 @@ public:
 	 */
 	virtual bool isWritable() const = 0;
 
+	/**
+	 * Returns the time the object referred by this path was last modified,
+	 * in nanoseconds since the epoch, as precise as the file system records
+	 * it. For a directory this changes whenever an entry is added to,
+	 * removed from or renamed inside it.
+	 *
+	 * Two changes within one tick of the file system clock leave the time
+	 * unchanged, so objects modified within the last few seconds report an
+	 * unknown time.
+	 *
+	 * @return the modification time, or 0 if it is not known.
+	 */
+	virtual uint64 getModificationTime() const { return 0; }
 
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
@@ -182,6 +209,16 @@ public:
 	 */
 	virtual Common::SeekableReadStream *createReadStream() = 0;
 
+	/**
+	 * Creates a SeekableReadStream instance like createReadStream(), but
+	 * allows the backend to map the file into memory. Such a stream must
+	 * only be used for files which are not modified while it is open, like
+	 * game data.
+	 *
+	 * @return pointer to the stream object, 0 in case of a failure
+	 */
+	virtual Common::SeekableReadStream *createMappedReadStream() { return createReadStream(); }
+
 	/**
 	 * Creates a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -70,7 +70,7 @@ private:
 	bool _isPseudoRoot;
 	const Config &_config;
 
-	DrivePOSIXFilesystemNode *getChildWithKnownType(const Common::String &n, bool isDirectoryFlag) const;
+	DrivePOSIXFilesystemNode *getChildWithKnownType(const Common::String &n, bool isDirectoryFlag) const override;
 	bool isDrive(const Common::String &path) const;
 	void configureStream(StdioStream *stream);
 };
@@ -24,6 +24,7 @@
 // Re-enable some forbidden symbols to avoid clashes with stat.h and unistd.h.
 // Also with clock() in sys/time.h in some Mac OS X SDKs.
 #define FORBIDDEN_SYMBOL_EXCEPTION_time_h
+#define FORBIDDEN_SYMBOL_EXCEPTION_time
 #define FORBIDDEN_SYMBOL_EXCEPTION_unistd_h
 #define FORBIDDEN_SYMBOL_EXCEPTION_mkdir
 #define FORBIDDEN_SYMBOL_EXCEPTION_getenv
@@ -47,6 +48,7 @@
 #include <stdio.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <time.h>
 #include <unistd.h>
 
 #ifdef __OS2__
@@ -77,6 +79,28 @@ bool POSIXFilesystemNode::isWritable() const {
 	return retVal;
 }
 
+uint64 POSIXFilesystemNode::getModificationTime() const {
+	struct stat st;
+
+	if (stat(_path.c_str(), &st) != 0)
+		return 0;
+
+	// Some file systems only record the time to the second, or to two
+	// seconds like FAT. Another change in the same tick as the last one
+	// could not be told apart from it.
+	if (st.st_mtime >= time(nullptr) - 2)
+		return 0;
+
+#if defined(MACOSX) || defined(IPHONE)
+	const uint64 nsec = st.st_mtimespec.tv_nsec;
+#elif defined(__linux__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__)
+	const uint64 nsec = st.st_mtim.tv_nsec;
+#else
+	const uint64 nsec = 0;
+#endif
+	return (uint64)st.st_mtime * 1000000000 + nsec;
+}
+
 void POSIXFilesystemNode::setFlags() {
 	struct stat st;
 
@@ -147,6 +171,26 @@ AbstractFSNode *POSIXFilesystemNode::getChild(const Common::String &n) const {
 	return makeNode(newPath);
 }
 
+AbstractFSNode *POSIXFilesystemNode::getChildWithKnownType(const Common::String &n, bool isDirectory) const {
+	assert(!_path.empty());
+	assert(_isDirectory);
+
+	// Make sure the string contains no slashes
+	assert(!n.contains('/'));
+
+	// Start with a clone of this node, like getChildren() does, so no
+	// stat() call is needed
+	POSIXFilesystemNode *child = new POSIXFilesystemNode(*this);
+	child->_displayName = n;
+	if (_path.lastChar() != '/')
+		child->_path += '/';
+	child->_path += n;
+	child->_isDirectory = isDirectory;
+	child->_isValid = true;
+
+	return child;
+}
+
 bool POSIXFilesystemNode::getChildren(AbstractFSList &myList, ListMode mode, bool hidden) const {
 	assert(_isDirectory);
 
@@ -296,6 +340,15 @@ Common::SeekableReadStream *POSIXFilesystemNode::createReadStream() {
 	return PosixIoStream::makeFromPath(getPath(), false);
 }
 
+#if defined(HAS_MMAP)
+Common::SeekableReadStream *POSIXFilesystemNode::createMappedReadStream() {
+	Common::SeekableReadStream *stream = PosixIoStream::mapFromPath(getPath());
+	if (stream)
+		return stream;
+	return PosixIoStream::makeFromPath(getPath(), false);
+}
+#endif
+
 Common::SeekableWriteStream *POSIXFilesystemNode::createWriteStream() {
 	return PosixIoStream::makeFromPath(getPath(), true);
 }
@@ -45,6 +45,8 @@ protected:
 	 */
 	POSIXFilesystemNode() : _isDirectory(false), _isValid(false) {}
 
+	AbstractFSNode *getChildWithKnownType(const Common::String &n, bool isDirectory) const override;
+
 public:
 	/**
 	 * Creates a POSIXFilesystemNode for a given path.
@@ -60,12 +62,16 @@ public:
 	bool isDirectory() const override { return _isDirectory; }
 	bool isReadable() const override;
 	bool isWritable() const override;
+	uint64 getModificationTime() const override;
 
 	AbstractFSNode *getChild(const Common::String &n) const override;
 	bool getChildren(AbstractFSList &list, ListMode mode, bool hidden) const override;
 	AbstractFSNode *getParent() const override;
 
 	Common::SeekableReadStream *createReadStream() override;
+#if defined(HAS_MMAP)
+	Common::SeekableReadStream *createMappedReadStream() override;
+#endif
 	Common::SeekableWriteStream *createWriteStream() override;
 	bool createDirectory() override;
 
@@ -25,6 +25,14 @@
 
 #include <sys/stat.h>
 
+#if defined(HAS_MMAP)
+#include "common/memstream.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #if defined(ANDROID_PLAIN_PORT)
 #include "backends/platform/android/jni-android.h"
 #include <unistd.h>
@@ -79,6 +87,68 @@ PosixIoStream *PosixIoStream::makeFromPath(const Common::String &path, bool writ
 }
 
 
+#if defined(HAS_MMAP)
+namespace {
+
+enum {
+	// Smaller files are read as quickly with stdio, and mapping larger ones
+	// could exhaust the address space
+	kMinMappedSize = 64 * 1024,
+	kMaxMappedSize = 256 * 1024 * 1024
+};
+
+struct MappingDeleter {
+	MappingDeleter(uint32 size) : _size(size) {}
+
+	void operator()(byte *mapping) { munmap(mapping, _size); }
+
+	uint32 _size;
+};
+
+/**
+ * A memory mapped file. It can't be positioned outside of its contents,
+ * such a seek fails instead of asserting.
+ */
+class PosixMappedStream final : public Common::SharedBufferReadStream {
+public:
+	PosixMappedStream(byte *mapping, uint32 size) :
+		Common::SharedBufferReadStream(Common::SharedPtr<byte>(mapping, MappingDeleter(size)), mapping, size) {}
+
+	bool seek(int64 offs, int whence = SEEK_SET) override {
+		if (whence == SEEK_CUR)
+			offs += pos();
+		else if (whence == SEEK_END)
+			offs += size();
+
+		if (offs < 0 || offs > size())
+			return false;
+		return SharedBufferReadStream::seek(offs, SEEK_SET);
+	}
+};
+
+} // End of anonymous namespace
+
+Common::SeekableReadStream *PosixIoStream::mapFromPath(const Common::String &path) {
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd == -1)
+		return nullptr;
+
+	struct stat st;
+	if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode) || st.st_size < kMinMappedSize || st.st_size > kMaxMappedSize) {
+		close(fd);
+		return nullptr;
+	}
+
+	// The mapping stays valid once the file is closed
+	void *mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (mapping == MAP_FAILED)
+		return nullptr;
+
+	return new PosixMappedStream((byte *)mapping, st.st_size);
+}
+#endif
+
 #if defined(ANDROID_PLAIN_PORT)
 PosixIoStream::PosixIoStream(void *handle, bool bCreatedWithSAF, Common::String sHackyFilename) :
 		StdioStream(handle) {
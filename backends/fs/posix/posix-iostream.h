@@ -35,6 +35,17 @@ public:
 #endif
 
 	static PosixIoStream *makeFromPath(const Common::String &path, bool writeMode);
+#if defined(HAS_MMAP)
+	/**
+	 * Given a path, maps the file into memory for reading. The returned
+	 * stream is a Common::SharedBufferReadStream, whose contents can be
+	 * accessed directly with getData().
+	 *
+	 * @return the stream, or nullptr if the file can't be mapped or is too
+	 *         small or too large for it to be worth it
+	 */
+	static Common::SeekableReadStream *mapFromPath(const Common::String &path);
+#endif
 	PosixIoStream(void *handle);
 #if defined(ANDROID_PLAIN_PORT)
 	PosixIoStream(void *handle, bool bCreatedWithSAF, Common::String sHackyFilename);
@@ -0,0 +1,154 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#if defined(SDL_BACKEND)
+
+#include "backends/graphics/surfacesdl/surfacesdl-scalerpool.h"
+
+#include "common/textconsole.h"
+#include "common/util.h"
+#include "graphics/scalerplugin.h"
+
+SdlScalerThreadPool::SdlScalerThreadPool(int numThreads) : _numWorkers(0), _done(nullptr), _quit(false) {
+	if (numThreads <= 0) {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+		// Leave some room for the engine and audio threads
+		numThreads = CLIP(SDL_GetCPUCount() - 1, 1, 4);
+#else
+		numThreads = 1;
+#endif
+	}
+	numThreads = MIN<int>(numThreads, kMaxThreads);
+
+	if (numThreads <= 1)
+		return;
+
+	_done = SDL_CreateSemaphore(0);
+	if (!_done)
+		return;
+
+	for (int i = 0; i < numThreads - 1; ++i) {
+		Worker &worker = _workers[_numWorkers];
+		worker.pool = this;
+		worker.start = SDL_CreateSemaphore(0);
+		if (!worker.start)
+			break;
+
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+		worker.thread = SDL_CreateThread(workerThread, "ScummVM Scaler", &worker);
+#else
+		worker.thread = SDL_CreateThread(workerThread, &worker);
+#endif
+		if (!worker.thread) {
+			SDL_DestroySemaphore(worker.start);
+			break;
+		}
+
+		++_numWorkers;
+	}
+
+	if (_numWorkers != numThreads - 1)
+		warning("Could only start %d out of %d scaler threads", _numWorkers + 1, numThreads);
+}
+
+SdlScalerThreadPool::~SdlScalerThreadPool() {
+	_quit = true;
+	for (int i = 0; i < _numWorkers; ++i)
+		SDL_SemPost(_workers[i].start);
+
+	for (int i = 0; i < _numWorkers; ++i) {
+		SDL_WaitThread(_workers[i].thread, nullptr);
+		SDL_DestroySemaphore(_workers[i].start);
+	}
+
+	if (_done)
+		SDL_DestroySemaphore(_done);
+}
+
+void SdlScalerThreadPool::scale(Scaler *scaler, const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) {
+	const int numBands = CLIP(height / kMinBandHeight, 1, _numWorkers + 1);
+	if (numBands == 1) {
+		scaler->scale(srcPtr, srcPitch, dstPtr, dstPitch, width, height, x, y);
+		return;
+	}
+
+	Job job;
+	job.scaler = scaler;
+	job.srcPtr = srcPtr;
+	job.srcPitch = srcPitch;
+	job.dstPtr = dstPtr;
+	job.dstPitch = dstPitch;
+	job.width = width;
+	job.x = x;
+	job.y = y;
+	job.factor = scaler->getFactor();
+
+	// Spread the rows evenly, the first bands get the remainder
+	const int bandHeight = height / numBands;
+	const int remainder = height % numBands;
+	int bandY = 0;
+
+	for (int i = 0; i < numBands; ++i) {
+		job.bandY = bandY;
+		job.bandHeight = bandHeight + (i < remainder ? 1 : 0);
+		bandY += job.bandHeight;
+
+		if (i == 0)
+			continue;
+
+		_workers[i - 1].job = job;
+		SDL_SemPost(_workers[i - 1].start);
+	}
+
+	// Process the first band on the calling thread
+	job.bandY = 0;
+	job.bandHeight = bandHeight + (remainder ? 1 : 0);
+	runJob(job);
+
+	for (int i = 1; i < numBands; ++i)
+		SDL_SemWait(_done);
+}
+
+int SDLCALL SdlScalerThreadPool::workerThread(void *data) {
+	Worker *worker = (Worker *)data;
+	SdlScalerThreadPool *pool = worker->pool;
+
+	for (;;) {
+		SDL_SemWait(worker->start);
+		if (pool->_quit)
+			break;
+
+		runJob(worker->job);
+		SDL_SemPost(pool->_done);
+	}
+
+	return 0;
+}
+
+void SdlScalerThreadPool::runJob(const Job &job) {
+	job.scaler->scale(job.srcPtr + job.bandY * job.srcPitch, job.srcPitch,
+	                  job.dstPtr + job.bandY * job.factor * job.dstPitch, job.dstPitch,
+	                  job.width, job.bandHeight, job.x, job.y + job.bandY);
+}
+
+#endif
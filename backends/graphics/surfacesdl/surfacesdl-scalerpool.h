@@ -0,0 +1,102 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BACKENDS_GRAPHICS_SURFACESDL_SCALERPOOL_H
+#define BACKENDS_GRAPHICS_SURFACESDL_SCALERPOOL_H
+
+#include "common/scummsys.h"
+
+#include "backends/platform/sdl/sdl-sys.h"
+
+class Scaler;
+
+/**
+ * A pool of worker threads used to run a Scaler on several horizontal bands
+ * of a rect in parallel.
+ *
+ * The calling thread processes the first band itself and waits for the
+ * workers to finish, so scale() behaves like a plain Scaler::scale() call.
+ * With a single thread no workers are created and everything runs on the
+ * calling thread, which gives deterministic behavior for testing.
+ *
+ * Scalers read the rows around each band directly from the source surface,
+ * which is padded for that purpose, so bands need no extra handling for the
+ * overlap. Scalers which keep a copy of the old source (see
+ * ScalerPluginObject::useOldSource()) update it while scaling and must not
+ * be split.
+ */
+class SdlScalerThreadPool {
+public:
+	/**
+	 * @param numThreads Total number of threads to use, including the
+	 *                   calling thread. 0 selects a value based on the
+	 *                   number of CPU cores.
+	 */
+	SdlScalerThreadPool(int numThreads);
+	~SdlScalerThreadPool();
+
+	/** Return the total number of threads, including the calling thread. */
+	int getNumThreads() const { return _numWorkers + 1; }
+
+	/**
+	 * Scale a rect, splitting it into horizontal bands processed in parallel.
+	 * The parameters are the same as for Scaler::scale().
+	 */
+	void scale(Scaler *scaler, const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y);
+
+private:
+	enum {
+		kMaxThreads = 16,
+		/** Bands are not made smaller than this many source rows */
+		kMinBandHeight = 16
+	};
+
+	struct Job {
+		Scaler *scaler;
+		const uint8 *srcPtr;
+		uint32 srcPitch;
+		uint8 *dstPtr;
+		uint32 dstPitch;
+		int width;
+		int x;
+		int y;
+		int factor;
+		int bandY;
+		int bandHeight;
+	};
+
+	struct Worker {
+		SdlScalerThreadPool *pool;
+		SDL_Thread *thread;
+		SDL_sem *start;
+		Job job;
+	};
+
+	static int SDLCALL workerThread(void *data);
+	static void runJob(const Job &job);
+
+	Worker _workers[kMaxThreads];
+	int _numWorkers;
+	SDL_sem *_done;
+	bool _quit;
+};
+
+#endif
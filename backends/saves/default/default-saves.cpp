@@ -41,6 +41,9 @@
 #include "common/fs.h"
 #include "common/archive.h"
 #include "common/config-manager.h"
+#include "common/debug.h"
+#include "common/events.h"
+#include "common/translation.h"
 #include "common/zlib.h"
 
 #include <errno.h>	// for removeSavefile()
@@ -49,13 +52,181 @@
 const char *DefaultSaveFileManager::TIMESTAMPS_FILENAME = "timestamps";
 #endif
 
-DefaultSaveFileManager::DefaultSaveFileManager() {
+/**
+ * Savefile stream collecting the data of a chunked save, which is handed
+ * to the savefile manager when the stream is finalized. The file itself is
+ * only opened once all the data is encoded, so the previous save stays
+ * intact until then.
+ */
+class ChunkedSaveStream : public Common::WriteStream {
+public:
+	ChunkedSaveStream(DefaultSaveFileManager *manager, const Common::String &filename, const Common::FSNode &file, Common::SaveChunkList *previous) :
+		_manager(manager), _filename(filename), _writer(new Common::ChunkedSaveWriter(previous)), _file(file), _pos(0) {}
+
+	~ChunkedSaveStream() override {
+		finalize();
+	}
+
+	uint32 write(const void *dataPtr, uint32 dataSize) override {
+		return _writer ? _writer->write(dataPtr, dataSize) : 0;
+	}
+
+	int64 pos() const override {
+		return _writer ? _writer->pos() : _pos;
+	}
+
+	bool err() const override {
+		return _err || (_writer && _writer->err());
+	}
+
+	void clearErr() override {
+		_err = false;
+	}
+
+	void finalize() override {
+		if (!_writer)
+			return;
+
+		_pos = _writer->pos();
+		_writer->finalize();
+
+		// Keep the previous save when something already went wrong
+		if (_writer->err()) {
+			delete _writer;
+			_err = true;
+		} else {
+			_err = !_manager->queueChunkedSave(_filename, _writer, _file);
+		}
+		_writer = nullptr;
+	}
+
+private:
+	DefaultSaveFileManager *_manager;
+	Common::String _filename;
+	Common::ChunkedSaveWriter *_writer;
+	Common::FSNode _file;
+	int64 _pos;
+	bool _err = false;
+};
+
+DefaultSaveFileManager::DefaultSaveFileManager() : _pendingSavesObserver(false) {
 }
 
-DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSavepath) {
+DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSavepath) : _pendingSavesObserver(false) {
 	ConfMan.registerDefault("savepath", defaultSavepath);
 }
 
+DefaultSaveFileManager::~DefaultSaveFileManager() {
+	// The event manager is usually destroyed first, taking the observer with it
+	Common::EventManager *eventManager = g_system->getEventManager();
+	if (_pendingSavesObserver && eventManager)
+		eventManager->getEventDispatcher()->unregisterObserver(this);
+	finishPendingSaves(Common::String());
+}
+
+bool DefaultSaveFileManager::queueChunkedSave(const Common::String &filename, Common::ChunkedSaveWriter *writer, const Common::FSNode &file) {
+	// Cloud synchronization starts right after the savefile is finalized,
+	// so it has to be written by then.
+	Common::EventManager *eventManager = g_system->getEventManager();
+#if defined(USE_CLOUD) && defined(USE_LIBCURL)
+	eventManager = nullptr;
+#endif
+	if (!_pendingSavesObserver && !eventManager)
+		return writeChunkedSave(filename, writer, file);
+
+	PendingSave save;
+	save.filename = filename;
+	save.writer = writer;
+	save.file = file;
+	save.encodeMillis = 0;
+	_pendingSaves.push_back(save);
+
+	if (!_pendingSavesObserver) {
+		eventManager->getEventDispatcher()->registerObserver(this, 0, false, true);
+		_pendingSavesObserver = true;
+	}
+	return true;
+}
+
+bool DefaultSaveFileManager::writeChunkedSave(const Common::String &filename, Common::ChunkedSaveWriter *writer, const Common::FSNode &file) {
+	// The whole container is written at once, which keeps the time the
+	// savefile is truncated as short as possible
+	Common::WriteStream *stream = file.createWriteStream();
+	bool success = stream != nullptr;
+	if (stream) {
+		success = writer->writeContainer(*stream);
+		stream->finalize();
+		success = success && !stream->err();
+		delete stream;
+	}
+
+	if (!success) {
+		warning("DefaultSaveFileManager: Failed to write savefile '%s'", filename.c_str());
+		setError(Common::kWritingFailed, "Failed to write savefile '" + filename + "'");
+		if (!file.exists())
+			_saveFileCache.erase(filename);
+	}
+
+	// Keep the chunks for the next save of the file
+	if (!_previousSaves.contains(filename) && _previousSaves.size() >= kPreviousSaves)
+		_previousSaves.clear();
+	writer->takeChunks(_previousSaves[filename]);
+	delete writer;
+	return success;
+}
+
+void DefaultSaveFileManager::finishPendingSaves(const Common::String &filename) {
+	for (uint i = 0; i < _pendingSaves.size(); ) {
+		if (filename.empty() || _pendingSaves[i].filename.equalsIgnoreCase(filename))
+			finishPendingSave(i);
+		else
+			i++;
+	}
+}
+
+bool DefaultSaveFileManager::finishPendingSave(uint index) {
+	PendingSave save = _pendingSaves[index];
+	_pendingSaves.remove_at(index);
+
+	const uint32 start = g_system->getMillis(true);
+	const uint reusedChunks = save.writer->getReusedChunks();
+	const uint encodedChunks = save.writer->getEncodedChunks();
+	const bool success = writeChunkedSave(save.filename, save.writer, save.file);
+	save.encodeMillis += g_system->getMillis(true) - start;
+
+	debug(1, "DefaultSaveFileManager: Wrote '%s', %d of %d chunks reused, %d ms spent",
+	      save.filename.c_str(), reusedChunks, encodedChunks, save.encodeMillis);
+	return success;
+}
+
+bool DefaultSaveFileManager::notifyEvent(const Common::Event &event) {
+	return false;
+}
+
+void DefaultSaveFileManager::notifyPoll() {
+	// Encode the chunks of the oldest save for a while, and write it once
+	// all of them are done. This runs on the thread polling the events, so
+	// neither the timers nor the files need to be locked.
+	const uint32 start = g_system->getMillis(true);
+	while (!_pendingSaves.empty()) {
+		PendingSave &save = _pendingSaves.front();
+		const uint32 saveStart = g_system->getMillis(true);
+		while (save.writer->encodeChunk()) {
+			if (g_system->getMillis(true) - start >= kEncodeMillis)
+				break;
+		}
+
+		save.encodeMillis += g_system->getMillis(true) - saveStart;
+		if (!save.writer->isEncoded())
+			break;
+
+		// The engine already considers the game saved, so tell the user
+		const Common::String filename = save.filename;
+		if (!finishPendingSave(0))
+			g_system->displayMessageOnOSD(Common::U32String::format(_("Failed to write savefile '%s'"), filename.c_str()));
+	}
+}
+
 
 void DefaultSaveFileManager::checkPath(const Common::FSNode &dir) {
 	clearError();
@@ -97,6 +268,8 @@ Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &filename) {
+	finishPendingSaves(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -113,6 +286,8 @@ Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &fi
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String &filename) {
+	finishPendingSaves(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -130,11 +305,13 @@ Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String
 	} else {
 		// Open the file for loading.
 		Common::SeekableReadStream *sf = file->_value.createReadStream();
-		return Common::wrapCompressedReadStream(sf);
+		return Common::wrapCompressedReadStream(Common::wrapChunkedReadStream(sf));
 	}
 }
 
 Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String &filename, bool compress) {
+	finishPendingSaves(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	const Common::String savePathName = getSavePath();
 	assureCached(savePathName);
@@ -166,11 +343,26 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 		fileNode = file->_value;
 	}
 
-	// Open the file for saving.
-	Common::SeekableWriteStream *const sf = fileNode.createWriteStream();
-	if (!sf)
-		return nullptr;
-	Common::OutSaveFile *const result = new Common::OutSaveFile(compress ? Common::wrapCompressedWriteStream(sf) : sf);
+	Common::OutSaveFile *result;
+	if (compress && ConfMan.getBool("chunked_saves")) {
+		// The file is opened once the save is encoded
+		if (fileNode.exists() && !fileNode.isWritable())
+			return nullptr;
+
+		Common::SaveChunkList previous;
+		SaveChunkMap::iterator chunks = _previousSaves.find(filename);
+		if (chunks != _previousSaves.end()) {
+			SWAP(previous, chunks->_value);
+			_previousSaves.erase(chunks);
+		}
+		result = new Common::OutSaveFile(new ChunkedSaveStream(this, filename, fileNode, &previous));
+	} else {
+		// Open the file for saving.
+		Common::SeekableWriteStream *const sf = fileNode.createWriteStream();
+		if (!sf)
+			return nullptr;
+		result = new Common::OutSaveFile(compress ? Common::wrapCompressedWriteStream(sf) : sf);
+	}
 
 	// Add file to cache now that it exists.
 	_saveFileCache[filename] = Common::FSNode(fileNode.getPath());
@@ -179,6 +371,9 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 }
 
 bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
+	finishPendingSaves(filename);
+	_previousSaves.erase(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
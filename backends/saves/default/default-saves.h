@@ -23,6 +23,8 @@
 #define BACKEND_SAVES_DEFAULT_H
 
 #include "common/scummsys.h"
+#include "common/chunked-save.h"
+#include "common/events.h"
 #include "common/savefile.h"
 #include "common/str.h"
 #include "common/fs.h"
@@ -31,11 +33,22 @@
 
 /**
  * Provides a default savefile manager implementation for common platforms.
+ *
+ * With the chunked_saves config key set, compressed savefiles are written
+ * as chunked savegames (see Common::ChunkedSaveWriter). Their data is
+ * collected in memory. Once the savefile is finalized, it is encoded a few
+ * milliseconds at a time whenever the events are polled, and written when
+ * all of it is encoded. The savefile is only opened then, so the previous
+ * save survives until the new one is complete. Failures past that point
+ * are shown on the OSD and kept in getError(). Chunks which didn't change
+ * since the previous save of the same file in this session are not
+ * compressed again.
  */
-class DefaultSaveFileManager : public Common::SaveFileManager {
+class DefaultSaveFileManager : public Common::SaveFileManager, public Common::EventObserver {
 public:
 	DefaultSaveFileManager();
 	DefaultSaveFileManager(const Common::String &defaultSavepath);
+	~DefaultSaveFileManager() override;
 
 	void updateSavefilesList(Common::StringArray &lockedFiles) override;
 	Common::StringArray listSavefiles(const Common::String &pattern) override;
@@ -45,6 +58,9 @@ public:
 	bool removeSavefile(const Common::String &filename) override;
 	bool exists(const Common::String &filename) override;
 
+	bool notifyEvent(const Common::Event &event) override;
+	void notifyPoll() override;
+
 #ifdef USE_LIBCURL
 
 	static const uint32 INVALID_TIMESTAMP = UINT_MAX;
@@ -105,6 +121,53 @@ private:
 	 * The currently cached directory.
 	 */
 	Common::String _cachedDirectory;
+
+	friend class ChunkedSaveStream;
+
+	struct PendingSave {
+		Common::String filename;
+		Common::ChunkedSaveWriter *writer;
+		Common::FSNode file;
+		uint32 encodeMillis;
+	};
+
+	typedef Common::HashMap<Common::String, Common::SaveChunkList, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SaveChunkMap;
+
+	/** Number of files whose chunks are kept for the next save. */
+	static const uint kPreviousSaves = 2;
+	/** Time spent encoding pending saves per event poll (in milliseconds). */
+	static const uint32 kEncodeMillis = 2;
+
+	Common::Array<PendingSave> _pendingSaves;
+	SaveChunkMap _previousSaves;
+	bool _pendingSavesObserver;
+
+	/**
+	 * Queue a finalized chunked save to be written while polling events, or
+	 * write it right away without an event manager.
+	 *
+	 * @return	False if the save was written right away and failed.
+	 */
+	bool queueChunkedSave(const Common::String &filename, Common::ChunkedSaveWriter *writer, const Common::FSNode &file);
+
+	/**
+	 * Encode a chunked save and write it to its file. The file is only
+	 * opened here, so a save which is never written leaves the previous
+	 * one intact.
+	 *
+	 * @return	False if the file couldn't be written.
+	 */
+	bool writeChunkedSave(const Common::String &filename, Common::ChunkedSaveWriter *writer, const Common::FSNode &file);
+
+	/** Write all pending saves of a file, or of all files if it is empty. */
+	void finishPendingSaves(const Common::String &filename);
+
+	/**
+	 * Write a pending save and remove it from the queue.
+	 *
+	 * @return	False if the file couldn't be written.
+	 */
+	bool finishPendingSave(uint index);
 };
 
 #endif
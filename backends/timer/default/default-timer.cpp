@@ -27,91 +27,143 @@
 struct TimerSlot {
 	Common::TimerManager::TimerProc callback;
 	void *refCon;
-	Common::String id;
 	uint32 interval;	// in microseconds
 
-	uint32 nextFireTime;	// in milliseconds
-	uint32 nextFireTimeMicro;	// microseconds part of nextFire
+	uint64 deadline;	// in microseconds of monotonic time
+	uint64 sequence;	// orders timers with the same deadline
 
-	TimerSlot *next;
+	Common::TimerManager::TimerStats stats;
 
-	TimerSlot() : callback(nullptr), refCon(nullptr), interval(0), nextFireTime(0), nextFireTimeMicro(0), next(nullptr) {}
+	TimerSlot() : callback(nullptr), refCon(nullptr), interval(0), deadline(0), sequence(0) {}
 };
 
-void insertPrioQueue(TimerSlot *head, TimerSlot *newSlot) {
-	// The head points to a fake anchor TimerSlot; this common
-	// trick allows us to get rid of many special cases.
-
-	const uint32 nextFireTime = newSlot->nextFireTime;
-	TimerSlot *slot = head;
-	newSlot->next = nullptr;
-
-	// Insert the new slot into the sorted list of already scheduled
-	// timers in such a way that the list stays sorted...
-	while (true) {
-		assert(slot);
-		if (slot->next == nullptr || nextFireTime < slot->next->nextFireTime) {
-			newSlot->next = slot->next;
-			slot->next = newSlot;
-			return;
-		}
-		slot = slot->next;
-	}
+static bool firesBefore(const TimerSlot *a, const TimerSlot *b) {
+	return a->deadline < b->deadline || (a->deadline == b->deadline && a->sequence < b->sequence);
 }
 
 
 DefaultTimerManager::DefaultTimerManager() :
-	_timerCallbackNext(0),
-	_head(nullptr) {
-
-	_head = new TimerSlot();
+	_firingSlot(nullptr),
+	_sequence(0),
+	_monotonicTime(0),
+	_lastMillis(0),
+	_clockStarted(false),
+	_timerCallbackNext(0) {
 }
 
 DefaultTimerManager::~DefaultTimerManager() {
+	Common::StackLock callbackLock(_callbackMutex);
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
-	while (slot) {
-		TimerSlot *next = slot->next;
-		delete slot;
-		slot = next;
+	for (uint i = 0; i < _slots.size(); ++i)
+		delete _slots[i];
+	_slots.clear();
+}
+
+uint32 DefaultTimerManager::getMillis(bool skipRecord) {
+	return g_system->getMillis(skipRecord);
+}
+
+uint64 DefaultTimerManager::getMonotonicTime(uint32 millis) {
+	// The millisecond counter wraps around after 49 days, and the recorded
+	// time of the event recorder may lag slightly behind the real one
+	if (!_clockStarted) {
+		_lastMillis = millis;
+		_clockStarted = true;
 	}
-	_head = nullptr;
+
+	const int32 delta = (int32)(millis - _lastMillis);
+	if (delta > 0) {
+		_monotonicTime += (uint64)delta * 1000;
+		_lastMillis = millis;
+	}
+	return _monotonicTime;
 }
 
-void DefaultTimerManager::handler() {
-	Common::StackLock lock(_mutex);
+void DefaultTimerManager::pushSlot(TimerSlot *slot) {
+	slot->sequence = _sequence++;
+
+	uint index = _slots.size();
+	_slots.push_back(slot);
+	while (index > 0) {
+		const uint parent = (index - 1) / 2;
+		if (!firesBefore(slot, _slots[parent]))
+			break;
+		_slots[index] = _slots[parent];
+		index = parent;
+	}
+	_slots[index] = slot;
+}
+
+void DefaultTimerManager::siftDown(uint index) {
+	TimerSlot *slot = _slots[index];
+	const uint size = _slots.size();
+	while (true) {
+		uint child = index * 2 + 1;
+		if (child >= size)
+			break;
+		if (child + 1 < size && firesBefore(_slots[child + 1], _slots[child]))
+			child++;
+		if (!firesBefore(_slots[child], slot))
+			break;
+		_slots[index] = _slots[child];
+		index = child;
+	}
+	_slots[index] = slot;
+}
 
-	uint32 curTime = g_system->getMillis(true);
+void DefaultTimerManager::handler() {
+	// The callbacks run with only _callbackMutex held, so that slow ones
+	// don't block installing timers or reading their statistics.
+	Common::StackLock callbackLock(_callbackMutex);
+	_mutex.lock();
 
-	// On slow systems this could still be run after destructor
-	if (!_head)
-		return;
+	const uint64 curTime = getMonotonicTime(getMillis(true));
 
 	// Repeat as long as there is a TimerSlot that is scheduled to fire.
-	TimerSlot *slot = _head->next;
-	while (slot && slot->nextFireTime < curTime) {
-		// Remove the slot from the priority queue
-		_head->next = slot->next;
-
-		// Update the fire time and reinsert the TimerSlot into the priority
-		// queue.
+	// On slow systems this could still be run after destructor, which
+	// leaves no timers behind.
+	while (!_slots.empty() && _slots[0]->deadline < curTime) {
+		TimerSlot *slot = _slots[0];
 		assert(slot->interval > 0);
-		slot->nextFireTime += (slot->interval / 1000);
-		slot->nextFireTimeMicro += (slot->interval % 1000);
-		if (slot->nextFireTimeMicro > 1000) {
-			slot->nextFireTime += slot->nextFireTimeMicro / 1000;
-			slot->nextFireTimeMicro %= 1000;
-		}
-		insertPrioQueue(_head, slot);
 
-		// Invoke the timer callback
+		const uint64 latency = curTime - slot->deadline;
+		Common::TimerManager::TimerStats &stats = slot->stats;
+		stats.calls++;
+		if (latency >= slot->interval)
+			stats.overruns++;
+		stats.maxLatency = MAX<uint64>(stats.maxLatency, MIN<uint64>(latency, 0xFFFFFFFF));
+
+		int bucket = 0;
+		for (uint64 millis = latency / 1000; millis > 0 && bucket < Common::TimerManager::TimerStats::kLatencyBuckets - 1; millis >>= 1)
+			bucket++;
+		stats.latencies[bucket]++;
+
+		// Schedule the next call. A timer which fell behind is invoked
+		// for every missed deadline, as callbacks like music players count
+		// their calls.
+		slot->deadline += slot->interval;
+		slot->sequence = _sequence++;
+		siftDown(0);
+
+		// Invoke the timer callback, which may remove its own timer
 		assert(slot->callback);
-		slot->callback(slot->refCon);
-
-		// Look at the next scheduled timer
-		slot = _head->next;
+		_firingSlot = slot;
+		const Common::TimerManager::TimerProc callback = slot->callback;
+		void *refCon = slot->refCon;
+		_mutex.unlock();
+
+		const uint32 start = getMillis(true);
+		callback(refCon);
+		const uint32 runTime = (getMillis(true) - start) * 1000;
+
+		_mutex.lock();
+		if (_firingSlot)
+			_firingSlot->stats.maxRunTime = MAX(_firingSlot->stats.maxRunTime, runTime);
+		_firingSlot = nullptr;
 	}
+
+	_mutex.unlock();
 }
 
 void DefaultTimerManager::checkTimers(uint32 interval) {
@@ -145,32 +197,40 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 	TimerSlot *slot = new TimerSlot;
 	slot->callback = callback;
 	slot->refCon = refCon;
-	slot->id = id;
 	slot->interval = interval;
-	slot->nextFireTime = g_system->getMillis() + interval / 1000;
-	slot->nextFireTimeMicro = interval % 1000;
-	slot->next = nullptr;
+	slot->deadline = getMonotonicTime(getMillis(false)) + interval;
+	slot->stats.id = id;
+	slot->stats.interval = interval;
 
-	insertPrioQueue(_head, slot);
+	pushSlot(slot);
 
 	return true;
 }
 
 void DefaultTimerManager::removeTimerProc(TimerProc callback) {
+	// Wait for a running callback, none may run after this returns
+	Common::StackLock callbackLock(_callbackMutex);
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
-
-	while (slot->next) {
-		if (slot->next->callback == callback) {
-			TimerSlot *next = slot->next->next;
-			delete slot->next;
-			slot->next = next;
+	uint kept = 0;
+	for (uint i = 0; i < _slots.size(); ++i) {
+		TimerSlot *slot = _slots[i];
+		if (slot->callback == callback) {
+			if (slot == _firingSlot)
+				_firingSlot = nullptr;
+			delete slot;
 		} else {
-			slot = slot->next;
+			_slots[kept++] = slot;
 		}
 	}
 
+	// Removing timers is rare, just restore the heap order afterwards
+	if (kept != _slots.size()) {
+		_slots.resize(kept);
+		for (uint i = kept / 2; i-- > 0; )
+			siftDown(i);
+	}
+
 	// We need to remove all names referencing the timer proc here.
 	//
 	// Else we run into troubles, when the client code removes and readds timer
@@ -188,3 +248,24 @@ void DefaultTimerManager::removeTimerProc(TimerProc callback) {
 			_callbacks.erase(i);
 	}
 }
+
+bool DefaultTimerManager::getTimerStats(Common::Array<TimerStats> &stats) {
+	Common::StackLock lock(_mutex);
+
+	stats.clear();
+	for (uint i = 0; i < _slots.size(); ++i)
+		stats.push_back(_slots[i]->stats);
+	return true;
+}
+
+void DefaultTimerManager::resetTimerStats() {
+	Common::StackLock lock(_mutex);
+
+	for (uint i = 0; i < _slots.size(); ++i) {
+		TimerSlot *slot = _slots[i];
+		const Common::String id = slot->stats.id;
+		slot->stats = TimerStats();
+		slot->stats.id = id;
+		slot->stats.interval = slot->interval;
+	}
+}
@@ -22,6 +22,7 @@
 #ifndef BACKENDS_TIMER_DEFAULT_H
 #define BACKENDS_TIMER_DEFAULT_H
 
+#include "common/array.h"
 #include "common/str.h"
 #include "common/hash-str.h"
 #include "common/timer.h"
@@ -33,20 +34,53 @@ class DefaultTimerManager : public Common::TimerManager {
 private:
 	typedef Common::HashMap<Common::String, TimerProc, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TimerSlotMap;
 
+	/** Guards the timers. */
 	Common::Mutex _mutex;
-	TimerSlot *_head;
+	/**
+	 * Held while callbacks are invoked, which is done without holding _mutex.
+	 * Always locked before _mutex.
+	 */
+	Common::Mutex _callbackMutex;
+	/** Binary heap of the installed timers, ordered by their next deadline. */
+	Common::Array<TimerSlot *> _slots;
 	TimerSlotMap _callbacks;
 
+	/** The timer whose callback is being invoked, reset if it is removed meanwhile. */
+	TimerSlot *_firingSlot;
+	/** Counter keeping timers with the same deadline in installation order. */
+	uint64 _sequence;
+
+	/** Time which never wraps around (in microseconds). */
+	uint64 _monotonicTime;
+	uint32 _lastMillis;
+	bool _clockStarted;
+
 	uint32 _timerCallbackNext;
 
+	uint64 getMonotonicTime(uint32 millis);
+	void pushSlot(TimerSlot *slot);
+	void siftDown(uint index);
+
+protected:
+	/**
+	 * Get the current time in milliseconds, the timers are scheduled on.
+	 */
+	virtual uint32 getMillis(bool skipRecord);
+
 public:
 	DefaultTimerManager();
 	virtual ~DefaultTimerManager();
 	virtual bool installTimerProc(TimerProc proc, int32 interval, void *refCon, const Common::String &id);
 	virtual void removeTimerProc(TimerProc proc);
+	virtual bool getTimerStats(Common::Array<TimerStats> &stats);
+	virtual void resetTimerStats();
 
 	/**
 	 * Timer callback, to be invoked at regular time intervals by the backend.
+	 *
+	 * Timers which fell behind are invoked repeatedly to catch up. The timers
+	 * can be installed and their statistics read while a callback runs, but
+	 * removeTimerProc() waits for it to return.
 	 */
 	void handler();
 
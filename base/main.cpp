@@ -37,12 +37,14 @@
 #include "base/version.h"
 
 #include "common/archive.h"
+#include "common/atom.h"
 #include "common/config-manager.h"
 #include "common/debug.h"
 #include "common/debug-channels.h" /* for debug manager */
 #include "common/events.h"
 #include "gui/EventRecorder.h"
 #include "common/fs.h"
+#include "common/fs-index.h"
 #ifdef ENABLE_EVENTRECORDER
 #include "common/recorderfile.h"
 #endif
@@ -496,6 +498,12 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 		ConfMan.registerDefault("dump_midi", true);
 	}
 
+	// Use a persistent index for the directory scans done when starting games
+	if (ConfMan.hasKey("file_index_path")) {
+		bool rebuild = ConfMan.hasKey("rebuild_file_index") && ConfMan.getBool("rebuild_file_index");
+		FSIndexMan.open(Common::FSNode(ConfMan.get("file_index_path")), rebuild);
+	}
+
 #ifdef USE_OPENGL
 	if (settings.contains("last_window_width")) {
 		ConfMan.setInt("last_window_width", atoi(settings["last_window_width"].c_str()));
@@ -628,6 +636,9 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 				ttsMan->popState();
 			}
 
+			// Keep the directory listings of this game for the next launch
+			FSIndexMan.flush();
+
 #ifdef ENABLE_EVENTRECORDER
 			// Flush Event recorder file. The recorder does not get reinitialized for next game
 			// which is intentional. Only single game per session is allowed.
@@ -721,12 +732,15 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	PluginManager::destroy();
 	GUI::GuiManager::destroy();
 	Common::ConfigManager::destroy();
+	// The configuration domains were the only users of the atom table
+	Common::Atom::freeTable();
 	Common::DebugManager::destroy();
 	Common::OSDMessageQueue::destroy();
 #ifdef ENABLE_EVENTRECORDER
 	GUI::EventRecorder::destroy();
 #endif
 	Common::SearchManager::destroy();
+	Common::FSIndex::destroy();
 #ifdef USE_TRANSLATION
 	Common::MainTranslationManager::destroy();
 #endif
@@ -265,6 +265,20 @@ SeekableReadStream *SearchSet::createReadStreamForMember(const Path &path) const
 	return nullptr;
 }
 
+SeekableReadStream *SearchSet::createMappedReadStreamForMember(const Path &path) const {
+	if (path.empty())
+		return nullptr;
+
+	ArchiveNodeList::const_iterator it = _list.begin();
+	for (; it != _list.end(); ++it) {
+		SeekableReadStream *stream = it->_arc->createMappedReadStreamForMember(path);
+		if (stream)
+			return stream;
+	}
+
+	return nullptr;
+}
+
 
 SearchManager::SearchManager() {
 	clear(); // Force a reset
@@ -137,6 +137,15 @@ public:
 	 * @return The newly created input stream.
 	 */
 	virtual SeekableReadStream *createReadStreamForMember(const Path &path) const = 0;
+
+	/**
+	 * Create a stream bound to a member like createReadStreamForMember(),
+	 * which may be mapped into memory. Only use it for game data, which is
+	 * not modified while the stream is open.
+	 *
+	 * @return The newly created input stream.
+	 */
+	virtual SeekableReadStream *createMappedReadStreamForMember(const Path &path) const { return createReadStreamForMember(path); }
 };
 
 
@@ -263,6 +272,12 @@ public:
 	 */
 	SeekableReadStream *createReadStreamForMember(const Path &path) const override;
 
+	/**
+	 * Implement createMappedReadStreamForMember from the Archive base class, with the
+	 * same policy as createReadStreamForMember.
+	 */
+	SeekableReadStream *createMappedReadStreamForMember(const Path &path) const override;
+
 	/**
 	 * Ignore clashes when adding directories. For more details, see the corresponding parameter
 	 * in @ref FSDirectory documentation.
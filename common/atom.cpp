@@ -0,0 +1,130 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/atom.h"
+#include "common/flat-hashmap.h"
+#include "common/hash-str.h"
+#include "common/mutex.h"
+#include "common/system.h"
+
+namespace Common {
+
+namespace {
+
+// Every spelling of a string has its own entry, which points to the entry of
+// the first spelling interned. Every lookup of a config key by its name goes
+// through these tables, so they are flat hash maps; the entries themselves
+// are allocated separately and never move.
+typedef FlatHashMap<String, Atom::Entry *> AtomMap;
+typedef FlatHashMap<String, Atom::Entry *, IgnoreCase_Hash, IgnoreCase_EqualTo> FoldedAtomMap;
+
+const String s_nullAtomString;
+
+AtomMap *s_atoms = nullptr;
+FoldedAtomMap *s_foldedAtoms = nullptr;
+Mutex *s_atomMutex = nullptr;
+
+/**
+ * Lock the atom table if possible. Before g_system exists no mutex can be
+ * created, but there are no other threads either.
+ */
+class AtomTableLock {
+public:
+	AtomTableLock() {
+		if (!s_atomMutex && g_system)
+			s_atomMutex = new Mutex();
+		_mutex = s_atomMutex;
+		if (_mutex)
+			_mutex->lock();
+	}
+
+	~AtomTableLock() {
+		if (_mutex)
+			_mutex->unlock();
+	}
+
+private:
+	Mutex *_mutex;
+};
+
+const Atom::Entry *internString(const String &str) {
+	AtomTableLock lock;
+
+	if (!s_atoms) {
+		s_atoms = new AtomMap();
+		s_foldedAtoms = new FoldedAtomMap();
+	}
+
+	Atom::Entry *&entry = s_atoms->getOrCreateVal(str);
+	if (!entry) {
+		entry = new Atom::Entry();
+		entry->str = str;
+		entry->hash = hashit_lower(str);
+
+		Atom::Entry *&folded = s_foldedAtoms->getOrCreateVal(str);
+		if (!folded)
+			folded = entry;
+		entry->folded = folded;
+	}
+	return entry;
+}
+
+} // End of anonymous namespace
+
+Atom::Atom(const String &str) : _entry(internString(str)) {
+}
+
+Atom::Atom(const char *str) : _entry(internString(String(str))) {
+}
+
+bool Atom::find(const String &str, Atom &atom) {
+	AtomTableLock lock;
+
+	Entry *entry = nullptr;
+	// Keys are nearly always spelled the same way, so the folded table, which
+	// needs a case-insensitive comparison, is only used for the others
+	if (s_atoms && !s_atoms->tryGetVal(str, entry))
+		s_foldedAtoms->tryGetVal(str, entry);
+
+	atom._entry = entry;
+	return entry != nullptr;
+}
+
+void Atom::freeTable() {
+	delete s_atomMutex;
+	s_atomMutex = nullptr;
+
+	if (!s_atoms)
+		return;
+
+	for (AtomMap::iterator i = s_atoms->begin(); i != s_atoms->end(); ++i)
+		delete i->_value;
+	delete s_atoms;
+	delete s_foldedAtoms;
+	s_atoms = nullptr;
+	s_foldedAtoms = nullptr;
+}
+
+const String &Atom::str() const {
+	return _entry ? _entry->str : s_nullAtomString;
+}
+
+} // End of namespace Common
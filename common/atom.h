@@ -0,0 +1,115 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_ATOM_H
+#define COMMON_ATOM_H
+
+#include "common/func.h"
+#include "common/str.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_atom Interned strings
+ * @ingroup common
+ *
+ * @brief Interned strings with pointer equality and a precomputed hash.
+ *
+ * @{
+ */
+
+/**
+ * An Atom is a handle to a string stored once in a global table, together
+ * with its hash, which is computed once when the string is interned.
+ *
+ * Atoms are case-insensitive like configuration keys: two atoms created from
+ * strings which only differ in case are equal, and comparing them is a single
+ * pointer comparison. Each spelling is kept, though, so str() returns the
+ * string the atom was created from, and a hash map keyed by atoms keeps the
+ * spelling of the key it was first given.
+ *
+ * Interned strings are kept until freeTable() is called, so atoms should only
+ * be created from a bounded set of strings, like configuration keys.
+ *
+ * The table is locked, so atoms can be created and looked up from any thread.
+ * Comparing and hashing atoms doesn't access the table.
+ */
+class Atom {
+public:
+	/** Create a null atom, which is different from any interned string. */
+	Atom() : _entry(nullptr) {}
+
+	/** Intern the given string, adding it to the table if necessary. */
+	explicit Atom(const String &str);
+	explicit Atom(const char *str);
+
+	/**
+	 * Look up the atom for a string without adding it to the table.
+	 *
+	 * @param str  The string to look up.
+	 * @param atom Set to the atom for @p str, or to the null atom if the
+	 *             string was never interned in any case.
+	 * @return True if the string was already interned.
+	 */
+	static bool find(const String &str, Atom &atom);
+
+	/**
+	 * Free all the interned strings. No atom created before may be used
+	 * afterwards.
+	 */
+	static void freeTable();
+
+	bool isNull() const { return _entry == nullptr; }
+
+	const String &str() const;
+	const char *c_str() const { return str().c_str(); }
+	operator const String &() const { return str(); }
+
+	/** Return the hash of the string, as computed by IgnoreCase_Hash. */
+	uint hash() const { return _entry ? _entry->hash : 0; }
+
+	/** Compare two atoms, ignoring the case of their strings. */
+	bool operator==(const Atom &x) const { return folded() == x.folded(); }
+	bool operator!=(const Atom &x) const { return folded() != x.folded(); }
+
+	struct Entry {
+		String str;
+		uint hash;
+		/** The first entry interned for any spelling of the string. */
+		const Entry *folded;
+	};
+
+private:
+	const Entry *folded() const { return _entry ? _entry->folded : nullptr; }
+
+	const Entry *_entry;
+};
+
+template<>
+struct Hash<Atom> : public UnaryFunction<Atom, uint> {
+	uint operator()(const Atom &atom) const { return atom.hash(); }
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
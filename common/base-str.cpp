@@ -22,57 +22,41 @@
 #include "common/base-str.h"
 #include "common/hash-str.h"
 #include "common/list.h"
-#include "common/memorypool.h"
 #include "common/textconsole.h"
 #include "common/util.h"
-#include "common/mutex.h"
 
 namespace Common {
 
 #define TEMPLATE template<class T>
 #define BASESTRING BaseString<T>
 
-MemoryPool *g_refCountPool = nullptr; // FIXME: This is never freed right now
-#ifndef SCUMMVM_UTIL
-Mutex *g_refCountPoolMutex = nullptr;
-
-void lockMemoryPoolMutex() {
-	// The Mutex class can only be used once g_system is set and initialized,
-	// but we may use the String class earlier than that (it is for example
-	// used in the OSystem_POSIX constructor). However in those early stages
-	// we can hope we don't have multiple threads either.
-	if (!g_system || !g_system->backendInitialized())
-		return;
-	if (!g_refCountPoolMutex)
-		g_refCountPoolMutex = new Mutex();
-	g_refCountPoolMutex->lock();
-}
-
-void unlockMemoryPoolMutex() {
-	if (g_refCountPoolMutex)
-		g_refCountPoolMutex->unlock();
-}
-
-TEMPLATE void BASESTRING::releaseMemoryPoolMutex() {
-	if (g_refCountPoolMutex){
-		delete g_refCountPoolMutex;
-		g_refCountPoolMutex = nullptr;
-	}
-}
-
-#endif
+/**
+ * Header of a heap allocated string buffer. The characters follow it
+ * directly, so a string and its reference count share one allocation.
+ */
+struct StorageHeader {
+	int refCount;
+};
 
 static uint32 computeCapacity(uint32 len) {
 	// By default, for the capacity we use the next multiple of 32
 	return ((len + 32 - 1) & ~0x1F);
 }
 
+TEMPLATE
+typename BASESTRING::value_type *BASESTRING::allocStorage(uint32 capacity) {
+	StorageHeader *header = (StorageHeader *)malloc(sizeof(StorageHeader) + capacity * sizeof(value_type));
+	assert(header);
+	header->refCount = 1;
+	return (value_type *)(header + 1);
+}
+
 TEMPLATE
 BASESTRING::BaseString(const BASESTRING &str)
 	: _size(str._size) {
 	if (str.isStorageIntern()) {
 		// String in internal storage: just copy it
-		memcpy(_storage, str._storage, _builtinCapacity * sizeof(value_type));
+		memcpy(_storage, str._storage, (_size + 1) * sizeof(value_type));
 		_str = _storage;
 	} else {
 		// String in external storage: use refcount mechanism
@@ -125,7 +109,7 @@ TEMPLATE void BASESTRING::ensureCapacity(uint32 new_size, bool keep_old) {
 		isShared = false;
 		curCapacity = _builtinCapacity;
 	} else {
-		isShared = (oldRefCount && *oldRefCount > 1);
+		isShared = (*oldRefCount > 1);
 		curCapacity = _extern._capacity;
 	}
 
@@ -149,8 +133,7 @@ TEMPLATE void BASESTRING::ensureCapacity(uint32 new_size, bool keep_old) {
 			newCapacity = MAX(curCapacity * 2, computeCapacity(new_size + 1));
 
 		// Allocate new storage
-		newStorage = new value_type[newCapacity];
-		assert(newStorage);
+		newStorage = allocStorage(newCapacity);
 	}
 
 	// Copy old data if needed, elsewise reset the new storage.
@@ -172,7 +155,7 @@ TEMPLATE void BASESTRING::ensureCapacity(uint32 new_size, bool keep_old) {
 		// Set the ref count & capacity if we use an external storage.
 		// It is important to do this *after* copying any old content,
 		// else we would override data that has not yet been copied!
-		_extern._refCount = nullptr;
+		_extern._refCount = &((StorageHeader *)newStorage - 1)->refCount;
 		_extern._capacity = newCapacity;
 	}
 }
@@ -180,23 +163,7 @@ TEMPLATE void BASESTRING::ensureCapacity(uint32 new_size, bool keep_old) {
 TEMPLATE
 void BASESTRING::incRefCount() const {
 	assert(!isStorageIntern());
-	if (_extern._refCount == nullptr) {
-#ifndef SCUMMVM_UTIL
-		lockMemoryPoolMutex();
-#endif
-		if (g_refCountPool == nullptr) {
-			g_refCountPool = new MemoryPool(sizeof(int));
-			assert(g_refCountPool);
-		}
-
-		_extern._refCount = (int *)g_refCountPool->allocChunk();
-#ifndef SCUMMVM_UTIL
-		unlockMemoryPoolMutex();
-#endif
-		*_extern._refCount = 2;
-	} else {
-		++(*_extern._refCount);
-	}
+	++(*_extern._refCount);
 }
 
 TEMPLATE
@@ -204,27 +171,14 @@ void BASESTRING::decRefCount(int *oldRefCount) {
 	if (isStorageIntern())
 		return;
 
-	if (oldRefCount) {
-		--(*oldRefCount);
-	}
-	if (!oldRefCount || *oldRefCount <= 0) {
-		// The ref count reached zero, so we free the string storage
-		// and the ref count storage.
-		if (oldRefCount) {
-#ifndef SCUMMVM_UTIL
-			lockMemoryPoolMutex();
-#endif
-			assert(g_refCountPool);
-			g_refCountPool->freeChunk(oldRefCount);
-#ifndef SCUMMVM_UTIL
-			unlockMemoryPoolMutex();
-#endif
-		}
+	// The ref count lives in the header of the storage block, so freeing
+	// the block releases both
+	if (--(*oldRefCount) <= 0) {
 		// Coverity thinks that we always free memory, as it assumes
 		// (correctly) that there are cases when oldRefCount == 0
 		// Thus, DO NOT COMPILE, trick it and shut tons of false positives
 #ifndef __COVERITY__
-		delete[] _str;
+		free((StorageHeader *)oldRefCount);
 #endif
 
 		// Even though _str points to a freed memory block now,
@@ -243,9 +197,8 @@ TEMPLATE void BASESTRING::initWithValueTypeStr(const value_type *str, uint32 len
 	if (len >= _builtinCapacity) {
 		// Not enough internal storage, so allocate more
 		_extern._capacity = computeCapacity(len + 1);
-		_extern._refCount = nullptr;
-		_str = new value_type[_extern._capacity];
-		assert(_str != nullptr);
+		_str = allocStorage(_extern._capacity);
+		_extern._refCount = &((StorageHeader *)_str - 1)->refCount;
 	}
 
 	// Copy the string into the storage area
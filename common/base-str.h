@@ -31,8 +31,6 @@ namespace Common {
 template<class T>
 class BaseString {
 public:
-	static void releaseMemoryPoolMutex();
-
 	static const uint32 npos = 0xFFFFFFFF;
 	typedef T          value_type;
 	typedef T *        iterator;
@@ -67,7 +65,8 @@ protected:
 		value_type _storage[_builtinCapacity];
 		/**
 		 * External string storage data -- the refcounter, and the
-		 * capacity of the string _str points to.
+		 * capacity of the string _str points to. The refcounter is
+		 * stored in the same heap block, right before the characters.
 		 */
 		struct {
 			mutable int *_refCount;
@@ -238,6 +237,7 @@ protected:
 	~BaseString();
 
 	void makeUnique();
+	static value_type *allocStorage(uint32 capacity);
 	void ensureCapacity(uint32 new_size, bool keep_old);
 	void incRefCount() const;
 	void decRefCount(int *oldRefCount);
@@ -0,0 +1,205 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/chunked-save.h"
+#include "common/endian.h"
+#include "common/md5.h"
+#include "common/textconsole.h"
+#include "common/zlib.h"
+
+namespace Common {
+
+enum {
+	kChunkedSaveMagic = MKTAG('S', 'C', 'H', 'K'),
+	kChunkedSaveVersion = 1
+};
+
+static void hashChunk(const byte *data, uint32 size, byte hash[16]) {
+	MemoryReadStream stream(data, size);
+	computeStreamMD5(stream, hash);
+}
+
+ChunkedSaveWriter::ChunkedSaveWriter(SaveChunkList *previous) :
+	_data(DisposeAfterUse::YES), _reusedChunks(0), _finalized(false), _err(false) {
+
+	if (previous)
+		SWAP(_previous, *previous);
+}
+
+uint32 ChunkedSaveWriter::write(const void *dataPtr, uint32 dataSize) {
+	const uint32 written = _finalized ? 0 : _data.write(dataPtr, dataSize);
+	if (written != dataSize)
+		_err = true;
+	return written;
+}
+
+void ChunkedSaveWriter::finalize() {
+	_finalized = true;
+}
+
+bool ChunkedSaveWriter::encodeChunk() {
+	const uint32 offset = _chunks.size() * kChunkSize;
+	if (offset >= _data.size())
+		return false;
+	const uint32 size = MIN<uint32>(_data.size() - offset, kChunkSize);
+	if (size < kChunkSize && !_finalized)
+		return false;
+
+	// Growing the list copies the data of all chunks, avoid that once the
+	// number of chunks is known
+	if (_finalized)
+		_chunks.reserve((_data.size() + kChunkSize - 1) / kChunkSize);
+
+	const byte *data = _data.getData() + offset;
+	const uint index = _chunks.size();
+	_chunks.push_back(SaveChunk());
+	SaveChunk &chunk = _chunks.back();
+	chunk.size = size;
+	hashChunk(data, size, chunk.hash);
+
+	if (index < _previous.size() && _previous[index].size == size && !memcmp(_previous[index].hash, chunk.hash, sizeof(chunk.hash))) {
+		chunk.compressed = _previous[index].compressed;
+		SWAP(chunk.data, _previous[index].data);
+		_reusedChunks++;
+		return true;
+	}
+
+	chunk.data.resize(size);
+#if defined(USE_ZLIB)
+	// Chunks which don't get any smaller are stored as they are
+	unsigned long compressedSize = size;
+	chunk.compressed = Common::compress(chunk.data.begin(), &compressedSize, data, size);
+	if (chunk.compressed)
+		chunk.data.resize(compressedSize);
+#endif
+	if (!chunk.compressed)
+		memcpy(chunk.data.begin(), data, size);
+	return true;
+}
+
+bool ChunkedSaveWriter::isEncoded() const {
+	return _finalized && _chunks.size() * kChunkSize >= (uint32)_data.size();
+}
+
+bool ChunkedSaveWriter::writeContainer(WriteStream &stream) {
+	_finalized = true;
+	while (encodeChunk())
+		;
+
+	stream.writeUint32BE(kChunkedSaveMagic);
+	stream.writeUint32LE(kChunkedSaveVersion);
+	stream.writeUint32LE(_chunks.size());
+	stream.writeUint32LE(_data.size());
+	for (uint i = 0; i < _chunks.size(); i++) {
+		const SaveChunk &chunk = _chunks[i];
+		stream.writeUint32LE(chunk.size);
+		stream.writeUint32LE(chunk.data.size());
+		stream.writeByte(chunk.compressed ? 1 : 0);
+		stream.write(chunk.hash, sizeof(chunk.hash));
+	}
+	for (uint i = 0; i < _chunks.size(); i++)
+		stream.write(_chunks[i].data.begin(), _chunks[i].data.size());
+
+	return !stream.err();
+}
+
+void ChunkedSaveWriter::takeChunks(SaveChunkList &chunks) {
+	chunks.clear();
+	SWAP(chunks, _chunks);
+}
+
+SeekableReadStream *wrapChunkedReadStream(SeekableReadStream *toBeWrapped) {
+	if (!toBeWrapped)
+		return nullptr;
+
+	if (toBeWrapped->readUint32BE() != kChunkedSaveMagic) {
+		toBeWrapped->seek(0);
+		return toBeWrapped;
+	}
+
+	const uint32 version = toBeWrapped->readUint32LE();
+	const uint32 count = toBeWrapped->readUint32LE();
+	const uint32 totalSize = toBeWrapped->readUint32LE();
+	if (version != kChunkedSaveVersion || count != (totalSize + ChunkedSaveWriter::kChunkSize - 1) / ChunkedSaveWriter::kChunkSize) {
+		warning("wrapChunkedReadStream: Unsupported or damaged savegame");
+		delete toBeWrapped;
+		return nullptr;
+	}
+
+	SaveChunkList chunks;
+	chunks.resize(count);
+	uint32 offset = 0;
+	bool valid = true;
+	for (uint i = 0; i < count && valid; i++) {
+		SaveChunk &chunk = chunks[i];
+		chunk.size = toBeWrapped->readUint32LE();
+		const uint32 dataSize = toBeWrapped->readUint32LE();
+		chunk.compressed = toBeWrapped->readByte() != 0;
+		toBeWrapped->read(chunk.hash, sizeof(chunk.hash));
+
+		// All chunks but the last one are full. Check the sizes before
+		// allocating anything, they come straight from the file.
+		valid = !toBeWrapped->err() && !toBeWrapped->eos() &&
+			chunk.size == MIN<uint32>(totalSize - offset, ChunkedSaveWriter::kChunkSize) && dataSize <= chunk.size;
+		if (valid)
+			chunk.data.resize(dataSize);
+		offset += chunk.size;
+	}
+
+	byte *data = valid ? (byte *)malloc(MAX<uint32>(totalSize, 1)) : nullptr;
+	offset = 0;
+	for (uint i = 0; i < count && data; i++) {
+		SaveChunk &chunk = chunks[i];
+		byte *dst = data + offset;
+		bool decoded = toBeWrapped->read(chunk.data.begin(), chunk.data.size()) == chunk.data.size();
+		if (decoded && chunk.compressed) {
+#if defined(USE_ZLIB)
+			unsigned long size = chunk.size;
+			decoded = Common::uncompress(dst, &size, chunk.data.begin(), chunk.data.size()) && size == chunk.size;
+#else
+			decoded = false;
+#endif
+		} else if (decoded) {
+			decoded = chunk.data.size() == chunk.size;
+			if (decoded)
+				memcpy(dst, chunk.data.begin(), chunk.size);
+		}
+
+		byte hash[16];
+		if (decoded)
+			hashChunk(dst, chunk.size, hash);
+		if (!decoded || memcmp(hash, chunk.hash, sizeof(hash))) {
+			free(data);
+			data = nullptr;
+		}
+		offset += chunk.size;
+	}
+
+	delete toBeWrapped;
+	if (!data) {
+		warning("wrapChunkedReadStream: Damaged savegame");
+		return nullptr;
+	}
+	return new SharedBufferReadStream(data, totalSize);
+}
+
+} // End of namespace Common
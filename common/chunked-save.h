@@ -0,0 +1,149 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef COMMON_CHUNKED_SAVE_H
+#define COMMON_CHUNKED_SAVE_H
+
+#include "common/array.h"
+#include "common/memstream.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_chunked_save Chunked savegames
+ * @ingroup common
+ *
+ * @brief Savegame container made of separately compressed chunks.
+ *
+ * @{
+ */
+
+/**
+ * A chunk of a chunked savegame, with the MD5 hash of its contents and
+ * the data stored in the container.
+ */
+struct SaveChunk {
+	uint32 size;
+	byte hash[16];
+	bool compressed;
+	Array<byte> data;
+
+	SaveChunk() : size(0), compressed(false) {
+		memset(hash, 0, sizeof(hash));
+	}
+};
+
+typedef Array<SaveChunk> SaveChunkList;
+
+/**
+ * Write stream creating a chunked savegame.
+ *
+ * The written data is split into chunks of kChunkSize bytes, which are
+ * compressed separately. Chunks whose contents didn't change since the
+ * previous save of the same file are not compressed again, but reuse the
+ * data of that save. Since the chunks are matched by their position,
+ * this works best for saves whose layout stays the same.
+ *
+ * The chunks are encoded by encodeChunk(), one at a time, so that the
+ * caller can spread the work over time. The container is only written
+ * by writeContainer().
+ *
+ * The container starts with the magic 'SCHK', its version, the number of
+ * chunks and the total size of their contents. For every chunk, its size,
+ * the size of its stored data, whether that is compressed and its MD5 hash
+ * follow. The data of the chunks comes last.
+ */
+class ChunkedSaveWriter : public WriteStream {
+public:
+	static const uint32 kChunkSize = 64 * 1024;
+
+	/**
+	 * Create a writer, taking over the chunks of the previous save of the
+	 * file, if given.
+	 */
+	explicit ChunkedSaveWriter(SaveChunkList *previous = nullptr);
+
+	uint32 write(const void *dataPtr, uint32 dataSize) override;
+	int64 pos() const override { return _data.pos(); }
+	bool err() const override { return _err; }
+	void clearErr() override { _err = false; }
+
+	/**
+	 * Mark the end of the data, after which the last, partial chunk can be
+	 * encoded too.
+	 */
+	void finalize() override;
+
+	/**
+	 * Encode the next complete chunk.
+	 *
+	 * @return	False if there was no complete chunk left to encode.
+	 */
+	bool encodeChunk();
+
+	/** Return whether all of the data has been encoded. */
+	bool isEncoded() const;
+
+	/**
+	 * Encode all remaining chunks and write the container to a stream.
+	 */
+	bool writeContainer(WriteStream &stream);
+
+	/**
+	 * Move the encoded chunks to a list, so that the next save of the same
+	 * file can reuse them.
+	 */
+	void takeChunks(SaveChunkList &chunks);
+
+	/** Return the number of chunks reused from the previous save. */
+	uint getReusedChunks() const { return _reusedChunks; }
+
+	/** Return the number of chunks encoded so far. */
+	uint getEncodedChunks() const { return _chunks.size(); }
+
+private:
+	MemoryWriteStreamDynamic _data;
+	SaveChunkList _previous;
+	SaveChunkList _chunks;
+	uint _reusedChunks;
+	bool _finalized;
+	bool _err;
+};
+
+/**
+ * Take a SeekableReadStream and decode it, if it contains a chunked
+ * savegame. The returned stream holds the decoded contents, and the passed
+ * stream is deleted. Other streams are returned unmodified.
+ *
+ * Damaged savegames, whose chunks don't match their hashes, are rejected,
+ * in which case nullptr is returned.
+ *
+ * It is safe to call this with a NULL parameter (in this case, NULL is
+ * returned).
+ */
+SeekableReadStream *wrapChunkedReadStream(SeekableReadStream *toBeWrapped);
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
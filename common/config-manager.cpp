@@ -409,13 +409,18 @@ bool ConfigManager::hasKey(const String &key) const {
 	// 3) the application domain.
 	// The defaults domain is explicitly *not* checked.
 
-	if (_transientDomain.contains(key))
+	// A key which was never interned cannot be in any domain
+	Atom atom;
+	if (!Atom::find(key, atom))
+		return false;
+
+	if (_transientDomain.contains(atom))
 		return true;
 
-	if (_activeDomain && _activeDomain->contains(key))
+	if (_activeDomain && _activeDomain->contains(atom))
 		return true;
 
-	if (_appDomain.contains(key))
+	if (_appDomain.contains(atom))
 		return true;
 
 	return false;
@@ -450,14 +455,20 @@ void ConfigManager::removeKey(const String &key, const String &domName) {
 
 
 const String &ConfigManager::get(const String &key) const {
-	if (_transientDomain.contains(key))
-		return _transientDomain[key];
-	else if (_activeDomain && _activeDomain->contains(key))
-		return (*_activeDomain)[key];
-	else if (_appDomain.contains(key))
-		return _appDomain[key];
+	// Intern the key only once for all the domains. If it was never
+	// interned, it is in none of them, and the null atom gives us the
+	// default value.
+	Atom atom;
+	Atom::find(key, atom);
+
+	if (_transientDomain.contains(atom))
+		return _transientDomain[atom];
+	else if (_activeDomain && _activeDomain->contains(atom))
+		return (*_activeDomain)[atom];
+	else if (_appDomain.contains(atom))
+		return _appDomain[atom];
 
-	return _defaultsDomain.getValOrDefault(key);
+	return _defaultsDomain.getValOrDefault(atom);
 }
 
 const String &ConfigManager::get(const String &key, const String &domName) const {
@@ -473,10 +484,13 @@ const String &ConfigManager::get(const String &key, const String &domName) const
 		error("ConfigManager::get(%s,%s) called on non-existent domain",
 		      key.c_str(), domName.c_str());
 
-	if (domain->contains(key))
-		return (*domain)[key];
+	Atom atom;
+	Atom::find(key, atom);
 
-	return _defaultsDomain.getValOrDefault(key);
+	if (domain->contains(atom))
+		return (*domain)[atom];
+
+	return _defaultsDomain.getValOrDefault(atom);
 }
 
 int ConfigManager::getInt(const String &key, const String &domName) const {
@@ -515,15 +529,17 @@ bool ConfigManager::getBool(const String &key, const String &domName) const {
 
 
 void ConfigManager::set(const String &key, const String &value) {
+	const Atom atom(key);
+
 	// Remove the transient domain value, if any.
-	_transientDomain.erase(key);
+	_transientDomain.erase(atom);
 
 	// Write the new key/value pair into the active domain, resp. into
 	// the application domain if no game domain is active.
 	if (_activeDomain)
-		(*_activeDomain).setVal(key, value);
+		(*_activeDomain).setVal(atom, value);
 	else
-		_appDomain.setVal(key, value);
+		_appDomain.setVal(atom, value);
 }
 
 void ConfigManager::setAndFlush(const String &key, const Common::String &value) {
@@ -23,6 +23,7 @@
 #define COMMON_CONFIG_MANAGER_H
 
 #include "common/array.h"
+#include "common/atom.h"
 #include "common/hashmap.h"
 #include "common/singleton.h"
 #include "common/str.h"
@@ -57,18 +58,29 @@ public:
 
 	class Domain {
 	private:
-		StringMap _entries;
+		/**
+		 * The entries are keyed by interned strings, so once a key has been
+		 * looked up in one domain, looking it up in the others does not
+		 * require hashing and comparing the whole string again.
+		 */
+		typedef HashMap<Atom, String> EntryMap;
+
+		EntryMap _entries;
 		StringMap _keyValueComments;
 		String _domainComment;
 
+		/** Return the atom for @p key, or the null atom if it was never interned. */
+		static Atom findKey(const String &key) { Atom atom; Atom::find(key, atom); return atom; }
+
 	public:
-		typedef StringMap::const_iterator const_iterator;
+		typedef EntryMap::const_iterator const_iterator;
 		const_iterator begin() const { return _entries.begin(); } /*!< Return the beginning position of configuration entries. */
 		const_iterator end()   const { return _entries.end(); }   /*!< Return the ending position of configuration entries. */
 
 		bool           empty() const { return _entries.empty(); } /*!< Return true if the configuration is empty, i.e. has no [key, value] pairs, and false otherwise. */
 
-		bool           contains(const String &key) const { return _entries.contains(key); } /*!< Check whether the domain contains a @p key. */
+		bool           contains(const String &key) const { return _entries.contains(findKey(key)); } /*!< Check whether the domain contains a @p key. */
+		bool           contains(const Atom &key) const { return _entries.contains(key); } /*!< @overload */
 		/** Return the configuration value for the given key.
 		 *  If no entry exists for the given key in the configuration, it is created.
 		 */
@@ -76,24 +88,28 @@ public:
 		 *  @note This function does *not* create a configuration entry
 		 *  for the given key if it does not exist.
 		 */
-		const String &operator[](const String &key) const { return _entries[key]; }
+		const String &operator[](const String &key) const { return _entries[findKey(key)]; }
+		const String &operator[](const Atom &key) const { return _entries[key]; } /*!< @overload */
 
-		void           setVal(const String &key, const String &value) { _entries.setVal(key, value); } /*!< Assign a @p value to a @p key. */
+		void           setVal(const String &key, const String &value) { _entries.setVal(Atom(key), value); } /*!< Assign a @p value to a @p key. */
+		void           setVal(const Atom &key, const String &value) { _entries.setVal(key, value); } /*!< @overload */
 
-		String &getOrCreateVal(const String &key) { return _entries.getOrCreateVal(key); }
-		String        &getVal(const String &key) { return _entries.getVal(key); } /*!< Retrieve the value of a @p key. */
-		const String  &getVal(const String &key) const { return _entries.getVal(key); } /*!< @overload */
+		String &getOrCreateVal(const String &key) { return _entries.getOrCreateVal(Atom(key)); }
+		String        &getVal(const String &key) { return _entries.getVal(findKey(key)); } /*!< Retrieve the value of a @p key. */
+		const String  &getVal(const String &key) const { return _entries.getVal(findKey(key)); } /*!< @overload */
 		 /**
 		  * Retrieve the value of @p key if it exists and leave the referenced variable unchanged if the key does not exist.
 		  * @return True if the key exists, false otherwise.
 		  * You can use this method if you frequently attempt to access keys that do not exist.
 		  */
-		const String &getValOrDefault(const String &key) const { return _entries.getValOrDefault(key); }
-		bool tryGetVal(const String &key, String &out) const { return _entries.tryGetVal(key, out); }
+		const String &getValOrDefault(const String &key) const { return _entries.getValOrDefault(findKey(key)); }
+		const String &getValOrDefault(const Atom &key) const { return _entries.getValOrDefault(key); } /*!< @overload */
+		bool tryGetVal(const String &key, String &out) const { return _entries.tryGetVal(findKey(key), out); }
 
 		void           clear() { _entries.clear(); } /*!< Clear all configuration entries in the domain. */
 
-		void           erase(const String &key) { _entries.erase(key); } /*!< Remove a key from the domain. */
+		void           erase(const String &key) { _entries.erase(findKey(key)); } /*!< Remove a key from the domain. */
+		void           erase(const Atom &key) { _entries.erase(key); } /*!< @overload */
 
 		void           setDomainComment(const String &comment); /*!< Add a @p comment for this configuration domain. */
 		const String  &getDomainComment() const; /*!< Retrieve the comment of this configuration domain. */
@@ -58,6 +58,23 @@ bool File::open(const Path &filename, Archive &archive) {
 	return open(stream, filename.toString());
 }
 
+bool File::openMapped(const Path &filename) {
+	assert(!filename.empty());
+	assert(!_handle);
+
+	SeekableReadStream *stream = nullptr;
+
+	if ((stream = SearchMan.createMappedReadStreamForMember(filename))) {
+		debug(8, "Opening hashed: %s", filename.toString().c_str());
+	} else if ((stream = SearchMan.createMappedReadStreamForMember(filename.append(".")))) {
+		// WORKAROUND: Bug #2548: "SIMON1: Game Detection fails"
+		// sometimes instead of "GAMEPC" we get "GAMEPC." (note trailing dot)
+		debug(8, "Opening hashed: %s.", filename.toString().c_str());
+	}
+
+	return open(stream, filename.toString());
+}
+
 bool File::open(const FSNode &node) {
 	assert(!_handle);
 
@@ -106,6 +106,17 @@ public:
 	 */
 	virtual bool open(SeekableReadStream *stream, const String &name);
 
+	/**
+	 * Try to open the file with the given file name like open(), allowing the
+	 * backend to map it into memory. Only use it for game data, which is not
+	 * modified while the file is open.
+	 * @note Must not be called if this file is already open (i.e. if isOpen returns true).
+	 *
+	 * @param	filename	Name of the file to open.
+	 * @return	True if the file was opened successfully, false otherwise.
+	 */
+	bool openMapped(const Path &filename);
+
 	/**
 	 * Close the file, if open.
 	 */
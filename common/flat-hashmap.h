@@ -0,0 +1,662 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// The open addressing scheme used here follows the design of the "Swiss
+// tables" from Abseil: keys and values are stored inline, and a separate
+// array of control bytes, one per slot, allows probing a whole group of
+// slots at once.
+
+#ifndef COMMON_FLAT_HASHMAP_H
+#define COMMON_FLAT_HASHMAP_H
+
+#include "common/hashmap.h"
+#include "common/math.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define FLATHASHMAP_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define FLATHASHMAP_NEON
+#endif
+
+namespace Common {
+
+/**
+ * @defgroup common_flat_hashmap Flat hash table (FlatHashMap)
+ * @ingroup common
+ *
+ * @brief API for operations on an open addressing hash table.
+ *
+ * @{
+ */
+
+/**
+ * FlatHashMap<Key,Val> is a drop-in alternative to HashMap<Key,Val>.
+ *
+ * Unlike HashMap, which keeps pointers to individually allocated nodes,
+ * FlatHashMap stores its keys and values inline in one array, next to an
+ * array of control bytes. Each control byte either marks its slot as empty
+ * or deleted, or holds 7 bits of the hash of the key stored in it. Lookups
+ * compare the control bytes of a group of 16 slots at once (using SSE2 or
+ * NEON when available) and only compare the keys of matching slots.
+ *
+ * This makes lookups and iteration much more cache friendly, at the cost
+ * of moving elements around when the table grows: unlike with HashMap,
+ * pointers and references to values are invalidated by insertions.
+ * Erasing elements does not invalidate them.
+ *
+ * The hash and equality functors have the same requirements as for HashMap.
+ */
+template<class Key, class Val, class HashFunc = Hash<Key>, class EqualFunc = EqualTo<Key> >
+class FlatHashMap {
+public:
+	typedef uint size_type;
+
+private:
+
+	typedef FlatHashMap<Key, Val, HashFunc, EqualFunc> FHM_t;
+
+	struct Node {
+		Val _value;
+		const Key _key;
+		explicit Node(const Key &key) : _value(), _key(key) {}
+		Node(const Node &node) : _value(node._value), _key(node._key) {}
+	};
+
+	enum {
+		FLATHASHMAP_GROUP_SIZE = 16,
+		FLATHASHMAP_MIN_CAPACITY = FLATHASHMAP_GROUP_SIZE,
+
+		// The quotient of the next two constants controls how much the
+		// internal storage may fill up, deleted slots included, before
+		// being increased automatically. Group probing copes well with
+		// high load factors.
+		FLATHASHMAP_LOADFACTOR_NUMERATOR = 7,
+		FLATHASHMAP_LOADFACTOR_DENOMINATOR = 8
+	};
+
+	enum {
+		kCtrlEmpty = -128,
+		kCtrlDeleted = -2
+		// Full slots have a control byte between 0 and 127
+	};
+
+	/** Default value, returned by the const getVal. */
+	Val _defaultVal;
+
+	int8 *_ctrl;        ///< Control bytes, one per slot.
+	Node *_slots;       ///< Uninitialized storage for the nodes, one per slot.
+	size_type _groupMask; ///< Number of groups minus one; the number of groups is a power of two
+	size_type _size;
+	size_type _deleted; ///< Number of slots marked as deleted
+
+	HashFunc _hash;
+	EqualFunc _equal;
+
+	size_type capacity() const { return (_groupMask + 1) * FLATHASHMAP_GROUP_SIZE; }
+
+	/**
+	 * Scramble the bits of the user supplied hash. Many hash functions,
+	 * for example the one for integers, return their input unmodified,
+	 * which would put consecutive keys in the same group.
+	 */
+	static uint32 mixHash(uint hash) {
+		const uint32 h = (uint32)hash * 0x9E3779B1;
+		return h ^ (h >> 16);
+	}
+
+	static int8 hashToCtrl(uint32 hash) { return (int8)(hash & 0x7F); }
+	size_type hashToGroup(uint32 hash) const { return (hash >> 7) & _groupMask; }
+
+	/** Return a bit mask of the slots in a group whose control byte is @p ctrl. */
+	static uint32 matchGroup(const int8 *group, int8 ctrl) {
+#if defined(FLATHASHMAP_SSE2)
+		const __m128i ctrls = _mm_loadu_si128((const __m128i *)group);
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrls, _mm_set1_epi8(ctrl)));
+#elif defined(FLATHASHMAP_NEON)
+		static const uint8 bits[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+		const uint8x16_t matches = vandq_u8(vceqq_s8(vld1q_s8(group), vdupq_n_s8(ctrl)), vld1q_u8(bits));
+		return vaddv_u8(vget_low_u8(matches)) | (vaddv_u8(vget_high_u8(matches)) << 8);
+#else
+		uint32 mask = 0;
+		for (int i = 0; i < FLATHASHMAP_GROUP_SIZE; ++i) {
+			if (group[i] == ctrl)
+				mask |= 1 << i;
+		}
+		return mask;
+#endif
+	}
+
+	/** Return a bit mask of the slots in a group which are empty or deleted. */
+	static uint32 matchFree(const int8 *group) {
+#if defined(FLATHASHMAP_SSE2)
+		// The control bytes of full slots have their top bit clear
+		return _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+#elif defined(FLATHASHMAP_NEON)
+		static const uint8 bits[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+		const uint8x16_t matches = vandq_u8(vcltzq_s8(vld1q_s8(group)), vld1q_u8(bits));
+		return vaddv_u8(vget_low_u8(matches)) | (vaddv_u8(vget_high_u8(matches)) << 8);
+#else
+		uint32 mask = 0;
+		for (int i = 0; i < FLATHASHMAP_GROUP_SIZE; ++i) {
+			if (group[i] < 0)
+				mask |= 1 << i;
+		}
+		return mask;
+#endif
+	}
+
+	/** Return the index of the lowest bit set in a non-zero mask. */
+	static int lowestBit(uint32 mask) { return intLog2(mask & (~mask + 1)); }
+
+	void allocStorage(size_type capacity);
+	void freeStorage();
+	void assign(const FHM_t &map);
+	size_type lookup(const Key &key) const;
+	size_type findFreeSlot(uint32 hash) const;
+	size_type lookupAndCreateIfMissing(const Key &key);
+	void rehash(size_type newCapacity);
+	void eraseSlot(size_type idx);
+
+	template<class T> friend class IteratorImpl;
+
+	/**
+	 * Simple FlatHashMap iterator implementation.
+	 */
+	template<class NodeType>
+	class IteratorImpl {
+		friend class FlatHashMap;
+		template<class T> friend class IteratorImpl;
+	protected:
+		typedef const FlatHashMap hashmap_t;
+
+		size_type _idx;
+		hashmap_t *_hashmap;
+
+	protected:
+		IteratorImpl(size_type idx, hashmap_t *hashmap) : _idx(idx), _hashmap(hashmap) {}
+
+		NodeType *deref() const {
+			assert(_hashmap != nullptr);
+			assert(_idx < _hashmap->capacity());
+			assert(_hashmap->_ctrl[_idx] >= 0);
+			return &_hashmap->_slots[_idx];
+		}
+
+	public:
+		IteratorImpl() : _idx(0), _hashmap(nullptr) {}
+		template<class T>
+		IteratorImpl(const IteratorImpl<T> &c) : _idx(c._idx), _hashmap(c._hashmap) {}
+
+		NodeType &operator*() const { return *deref(); }
+		NodeType *operator->() const { return deref(); }
+
+		bool operator==(const IteratorImpl &iter) const { return _idx == iter._idx && _hashmap == iter._hashmap; }
+		bool operator!=(const IteratorImpl &iter) const { return !(*this == iter); }
+
+		IteratorImpl &operator++() {
+			assert(_hashmap);
+			_idx = _hashmap->nextFullSlot(_idx + 1);
+			return *this;
+		}
+
+		IteratorImpl operator++(int) {
+			IteratorImpl old = *this;
+			operator ++();
+			return old;
+		}
+	};
+
+	/** Return the first full slot at or after @p idx, or -1 if there is none. */
+	size_type nextFullSlot(size_type idx) const {
+		const size_type cap = capacity();
+		for (; idx < cap; ++idx) {
+			if (_ctrl[idx] >= 0)
+				return idx;
+		}
+		return (size_type)-1;
+	}
+
+public:
+	typedef IteratorImpl<Node> iterator;
+	typedef IteratorImpl<const Node> const_iterator;
+
+	FlatHashMap();
+	FlatHashMap(const FHM_t &map);
+	~FlatHashMap();
+
+	FHM_t &operator=(const FHM_t &map) {
+		if (this == &map)
+			return *this;
+
+		// Remove the previous content and ...
+		clear();
+		freeStorage();
+		// ... copy the new stuff.
+		assign(map);
+		return *this;
+	}
+
+	bool contains(const Key &key) const;
+
+	Val &operator[](const Key &key);
+	const Val &operator[](const Key &key) const;
+
+	Val &getOrCreateVal(const Key &key);
+	Val &getVal(const Key &key);
+	const Val &getVal(const Key &key) const;
+	const Val &getValOrDefault(const Key &key) const;
+	const Val &getValOrDefault(const Key &key, const Val &defaultVal) const;
+	bool tryGetVal(const Key &key, Val &out) const;
+	void setVal(const Key &key, const Val &val);
+
+	void clear(bool shrinkArray = 0);
+
+	void erase(iterator entry);
+	void erase(const Key &key);
+
+	size_type size() const { return _size; }
+
+	iterator	begin() {
+		return iterator(nextFullSlot(0), this);
+	}
+	iterator	end() {
+		return iterator((size_type)-1, this);
+	}
+
+	const_iterator	begin() const {
+		return const_iterator(nextFullSlot(0), this);
+	}
+	const_iterator	end() const {
+		return const_iterator((size_type)-1, this);
+	}
+
+	iterator	find(const Key &key) {
+		return iterator(lookup(key), this);
+	}
+
+	const_iterator	find(const Key &key) const {
+		return const_iterator(lookup(key), this);
+	}
+
+	/** Return true if hashmap is empty. */
+	bool empty() const {
+		return (_size == 0);
+	}
+};
+
+//-------------------------------------------------------
+// FlatHashMap functions
+
+/**
+ * Base constructor, creates an empty hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap() : _defaultVal() {
+	allocStorage(FLATHASHMAP_MIN_CAPACITY);
+}
+
+/**
+ * Copy constructor, creates a full copy of the given hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap(const FHM_t &map) : _defaultVal() {
+	assign(map);
+}
+
+/**
+ * Destructor, frees all used memory.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::~FlatHashMap() {
+	clear();
+	freeStorage();
+}
+
+/**
+ * Allocate empty storage for @p capacity slots, which must be a multiple of
+ * the group size. The previous storage is *not* deallocated.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::allocStorage(size_type capacity) {
+	assert(capacity % FLATHASHMAP_GROUP_SIZE == 0);
+
+	_groupMask = capacity / FLATHASHMAP_GROUP_SIZE - 1;
+	_ctrl = (int8 *)malloc(capacity);
+	_slots = (Node *)malloc(capacity * sizeof(Node));
+	if (!_ctrl || !_slots)
+		::error("Common::FlatHashMap: failure to allocate %u slots", capacity);
+	memset(_ctrl, kCtrlEmpty, capacity);
+
+	_size = 0;
+	_deleted = 0;
+}
+
+/**
+ * Free the storage. All nodes must have been destroyed by the caller.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::freeStorage() {
+	free(_ctrl);
+	free(_slots);
+	_ctrl = nullptr;
+	_slots = nullptr;
+}
+
+/**
+ * Internal method for assigning the content of another FlatHashMap
+ * to this one.
+ *
+ * @note The previous storage here is *not* deallocated here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::assign(const FHM_t &map) {
+	const size_type cap = map.capacity();
+	allocStorage(cap);
+
+	// Keep the same layout, deleted slots included, so no rehashing is needed
+	memcpy(_ctrl, map._ctrl, cap);
+	for (size_type ctr = 0; ctr < cap; ++ctr) {
+		if (_ctrl[ctr] >= 0)
+			new ((void *)&_slots[ctr]) Node(map._slots[ctr]);
+	}
+
+	_size = map._size;
+	_deleted = map._deleted;
+}
+
+/**
+ * Clear all values in the hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::clear(bool shrinkArray) {
+	const size_type cap = capacity();
+	for (size_type ctr = 0; ctr < cap; ++ctr) {
+		if (_ctrl[ctr] >= 0)
+			_slots[ctr].~Node();
+	}
+
+	if (shrinkArray && cap > FLATHASHMAP_MIN_CAPACITY) {
+		freeStorage();
+		allocStorage(FLATHASHMAP_MIN_CAPACITY);
+	} else {
+		memset(_ctrl, kCtrlEmpty, cap);
+		_size = 0;
+		_deleted = 0;
+	}
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::rehash(size_type newCapacity) {
+	assert(newCapacity >= _size);
+
+#ifndef NDEBUG
+	const size_type old_size = _size;
+#endif
+	const size_type old_capacity = capacity();
+	int8 *old_ctrl = _ctrl;
+	Node *old_slots = _slots;
+
+	allocStorage(newCapacity);
+
+	// Move all the old elements. Since we know that no key exists twice in
+	// the old table, we can directly look for a free slot, without having to
+	// call _equal().
+	for (size_type ctr = 0; ctr < old_capacity; ++ctr) {
+		if (old_ctrl[ctr] < 0)
+			continue;
+
+		const uint32 hash = mixHash(_hash(old_slots[ctr]._key));
+		const size_type idx = findFreeSlot(hash);
+		_ctrl[idx] = hashToCtrl(hash);
+		new ((void *)&_slots[idx]) Node(old_slots[ctr]);
+		old_slots[ctr].~Node();
+		_size++;
+	}
+
+	// Perform a sanity check: Old number of elements should match the new one!
+	// This check will fail if some previous operation corrupted this hashmap.
+	assert(_size == old_size);
+
+	free(old_ctrl);
+	free(old_slots);
+}
+
+/**
+ * Return the slot containing @p key, or -1 if there is none.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookup(const Key &key) const {
+	const uint32 hash = mixHash(_hash(key));
+	const int8 ctrl = hashToCtrl(hash);
+	size_type group = hashToGroup(hash);
+
+	// Triangular probing visits every group exactly once when the number of
+	// groups is a power of two. This always terminates, since the load
+	// factor guarantees that at least one slot is empty.
+	for (size_type step = 1; ; ++step) {
+		const int8 *groupCtrl = _ctrl + group * FLATHASHMAP_GROUP_SIZE;
+
+		for (uint32 mask = matchGroup(groupCtrl, ctrl); mask; mask &= mask - 1) {
+			const size_type idx = group * FLATHASHMAP_GROUP_SIZE + lowestBit(mask);
+			if (_equal(_slots[idx]._key, key))
+				return idx;
+		}
+
+		// A key is never stored past a group which has empty slots
+		if (matchGroup(groupCtrl, kCtrlEmpty))
+			return (size_type)-1;
+
+		group = (group + step) & _groupMask;
+	}
+}
+
+/**
+ * Return the first empty or deleted slot in the probe sequence of @p hash.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::findFreeSlot(uint32 hash) const {
+	size_type group = hashToGroup(hash);
+	for (size_type step = 1; ; ++step) {
+		const uint32 mask = matchFree(_ctrl + group * FLATHASHMAP_GROUP_SIZE);
+		if (mask)
+			return group * FLATHASHMAP_GROUP_SIZE + lowestBit(mask);
+
+		group = (group + step) & _groupMask;
+	}
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookupAndCreateIfMissing(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		return ctr;
+
+	// Keep the load factor below a certain threshold.
+	// Deleted slots are also counted
+	size_type cap = capacity();
+	if ((_size + _deleted + 1) * FLATHASHMAP_LOADFACTOR_DENOMINATOR > cap * FLATHASHMAP_LOADFACTOR_NUMERATOR) {
+		// Only grow if the deleted slots would not free enough space
+		if ((_size + 1) * 2 * FLATHASHMAP_LOADFACTOR_DENOMINATOR > cap * FLATHASHMAP_LOADFACTOR_NUMERATOR)
+			cap *= 2;
+		rehash(cap);
+	}
+
+	const uint32 hash = mixHash(_hash(key));
+	ctr = findFreeSlot(hash);
+	if (_ctrl[ctr] == kCtrlDeleted)
+		_deleted--;
+	_ctrl[ctr] = hashToCtrl(hash);
+	new ((void *)&_slots[ctr]) Node(key);
+	_size++;
+
+	return ctr;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::eraseSlot(size_type idx) {
+	assert(idx < capacity());
+	assert(_ctrl[idx] >= 0);
+
+	_slots[idx].~Node();
+
+	// If the group still has empty slots, no lookup ever probed past it,
+	// so the slot can become empty again. Otherwise it has to be marked
+	// as deleted, so lookups continue with the next group.
+	int8 *groupCtrl = _ctrl + (idx & ~(size_type)(FLATHASHMAP_GROUP_SIZE - 1));
+	if (matchGroup(groupCtrl, kCtrlEmpty)) {
+		_ctrl[idx] = kCtrlEmpty;
+	} else {
+		_ctrl[idx] = kCtrlDeleted;
+		_deleted++;
+	}
+	_size--;
+}
+
+/**
+ * Check whether the hashmap contains the given key.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::contains(const Key &key) const {
+	return lookup(key) != (size_type)-1;
+}
+
+/**
+ * Get a value from the hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) {
+	return getOrCreateVal(key);
+}
+
+/**
+ * @overload
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) const {
+	return getVal(key);
+}
+
+/**
+ * Get a value from the hashmap, creating it if it is not present.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getOrCreateVal(const Key &key) {
+	// The storage may move while inserting, so look up the slot first
+	const size_type ctr = lookupAndCreateIfMissing(key);
+	return _slots[ctr]._value;
+}
+
+/**
+ * @overload
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		return _slots[ctr]._value;
+	else
+		// See comment in HashMap::getVal().
+#ifdef RELEASE_BUILD
+		return _defaultVal;
+#else
+		unknownKeyError(key);
+#endif
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) const {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		return _slots[ctr]._value;
+	else
+		// See comment in HashMap::getVal().
+#ifdef RELEASE_BUILD
+		return _defaultVal;
+#else
+		unknownKeyError(key);
+#endif
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getValOrDefault(const Key &key) const {
+	return getValOrDefault(key, _defaultVal);
+}
+
+/**
+ * Get a value from the hashmap. If the key is not present, then return @p defaultVal.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getValOrDefault(const Key &key, const Val &defaultVal) const {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		return _slots[ctr]._value;
+	else
+		return defaultVal;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::tryGetVal(const Key &key, Val &out) const {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1) {
+		out = _slots[ctr]._value;
+		return true;
+	} else {
+		return false;
+	}
+}
+
+/**
+ * Assign an element specified by @p key to a value @p val.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::setVal(const Key &key, const Val &val) {
+	const size_type ctr = lookupAndCreateIfMissing(key);
+	_slots[ctr]._value = val;
+}
+
+/**
+ * Erase an element referred to by an iterator.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(iterator entry) {
+	// Check whether we have a valid iterator
+	assert(entry._hashmap == this);
+	eraseSlot(entry._idx);
+}
+
+/**
+ * Erase an element specified by a key.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		eraseSlot(ctr);
+}
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
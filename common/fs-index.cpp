@@ -0,0 +1,254 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/fs-index.h"
+#include "common/debug.h"
+#include "common/endian.h"
+#include "common/stream.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+#include "backends/fs/abstract-fs.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(FSIndex);
+
+enum {
+	kIndexMagic = MKTAG('F', 'S', 'I', 'X'),
+	kIndexVersion = 2
+};
+
+static void writeIndexString(WriteStream &stream, const String &str) {
+	stream.writeUint32LE(str.size());
+	stream.write(str.c_str(), str.size());
+}
+
+static bool readIndexString(SeekableReadStream &stream, String &str) {
+	uint32 size = stream.readUint32LE();
+	if (stream.eos() || size > (uint32)(stream.size() - stream.pos()))
+		return false;
+
+	str.clear();
+	if (size) {
+		char *buf = new char[size];
+		stream.read(buf, size);
+		str = String(buf, size);
+		delete[] buf;
+	}
+	return !stream.err();
+}
+
+FSIndex::FSIndex() : _enabled(false), _dirty(false), _hits(0), _scans(0),
+	_indexedTrees(0), _scannedTrees(0), _indexedMillis(0), _scannedMillis(0) {
+}
+
+uint32 FSIndex::hashListing(const Array<Entry> &entries) {
+	// FNV-1a over the type and name of every entry, in listing order
+	uint32 hash = 2166136261u;
+	for (Array<Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it) {
+		hash = (hash ^ (it->isDirectory ? 1 : 0)) * 16777619u;
+		for (uint i = 0; i < it->name.size(); ++i)
+			hash = (hash ^ (byte)it->name[i]) * 16777619u;
+		hash *= 16777619u; // Terminating zero byte
+	}
+	return hash;
+}
+
+void FSIndex::open(const FSNode &file, bool rebuild) {
+	_file = file;
+	_enabled = true;
+	_dirs.clear();
+	_dirty = rebuild;
+
+	if (rebuild || !_file.exists())
+		return;
+
+	SeekableReadStream *stream = _file.createReadStream();
+	if (!stream)
+		return;
+
+	if (!load(*stream)) {
+		warning("FSIndex: Ignoring invalid file index '%s'", _file.getPath().c_str());
+		_dirty = true;
+	}
+	delete stream;
+}
+
+void FSIndex::flush() {
+	if (!_enabled)
+		return;
+
+	debug(1, "FSIndex: %u directories read from the index, %u listed", _hits, _scans);
+	debug(1, "FSIndex: %u trees cached from the index in %u ms, %u trees scanned in %u ms",
+	      _indexedTrees, _indexedMillis, _scannedTrees, _scannedMillis);
+
+	if (!_dirty)
+		return;
+
+	WriteStream *stream = _file.createWriteStream();
+	if (!stream) {
+		warning("FSIndex: Could not open '%s' for writing", _file.getPath().c_str());
+		return;
+	}
+
+	if (save(*stream))
+		_dirty = false;
+	else
+		warning("FSIndex: Could not write '%s'", _file.getPath().c_str());
+	delete stream;
+}
+
+bool FSIndex::getChildren(const FSNode &dir, FSList &list) {
+	if (!_enabled || !dir.isDirectory())
+		return dir.getChildren(list, FSNode::kListAll);
+
+	const String path = dir.getPath();
+	const uint64 mtime = dir._realNode->getModificationTime();
+
+	// The listing of a directory can only have changed if its modification
+	// time did, so the recorded entries can be used as they are
+	if (mtime != 0) {
+		DirMap::const_iterator it = _dirs.find(path);
+		if (it != _dirs.end() && it->_value.mtime == mtime) {
+			const Array<Entry> &entries = it->_value.entries;
+
+			list.clear();
+			list.reserve(entries.size());
+			for (Array<Entry>::const_iterator e = entries.begin(); e != entries.end(); ++e)
+				list.push_back(FSNode(dir._realNode->getChildWithKnownType(e->name, e->isDirectory)));
+
+			++_hits;
+			return true;
+		}
+	}
+
+	++_scans;
+	if (!dir.getChildren(list, FSNode::kListAll))
+		return false;
+
+	if (mtime == 0)
+		return true;
+
+	DirRecord &record = _dirs[path];
+	record.mtime = mtime;
+	record.entries.resize(list.size());
+	for (uint i = 0; i < list.size(); ++i) {
+		record.entries[i].name = list[i]._realNode->getName();
+		record.entries[i].isDirectory = list[i].isDirectory();
+	}
+	record.listingHash = hashListing(record.entries);
+	_dirty = true;
+
+	return true;
+}
+
+bool FSIndex::load(SeekableReadStream &stream) {
+	_dirs.clear();
+
+	if (stream.readUint32BE() != kIndexMagic || stream.readUint32LE() != kIndexVersion)
+		return false;
+
+	const uint32 count = stream.readUint32LE();
+	bool valid = !stream.eos();
+	for (uint32 i = 0; valid && i < count; ++i) {
+		String path;
+		DirRecord record;
+
+		valid = readIndexString(stream, path);
+		record.mtime = stream.readUint64LE();
+		record.listingHash = stream.readUint32LE();
+
+		// Every entry takes at least five bytes, which bounds the count
+		// before anything gets allocated for it
+		const uint32 numEntries = stream.readUint32LE();
+		if (!valid || stream.eos() || numEntries > (uint32)(stream.size() - stream.pos()) / 5)
+			break;
+
+		record.entries.resize(numEntries);
+		for (uint32 j = 0; valid && j < numEntries; ++j) {
+			record.entries[j].isDirectory = stream.readByte() != 0;
+			valid = readIndexString(stream, record.entries[j].name);
+		}
+		if (!valid)
+			break;
+
+		// Drop damaged records, they will be listed again
+		if (hashListing(record.entries) != record.listingHash) {
+			_dirty = true;
+			continue;
+		}
+
+		_dirs[path] = record;
+	}
+
+	if (!valid || stream.eos() || stream.err()) {
+		_dirs.clear();
+		return false;
+	}
+
+	return true;
+}
+
+bool FSIndex::save(WriteStream &stream) const {
+	stream.writeUint32BE(kIndexMagic);
+	stream.writeUint32LE(kIndexVersion);
+	stream.writeUint32LE(_dirs.size());
+
+	for (DirMap::const_iterator it = _dirs.begin(); it != _dirs.end(); ++it) {
+		const DirRecord &record = it->_value;
+
+		writeIndexString(stream, it->_key);
+		stream.writeUint64LE(record.mtime);
+		stream.writeUint32LE(record.listingHash);
+		stream.writeUint32LE(record.entries.size());
+		for (Array<Entry>::const_iterator e = record.entries.begin(); e != record.entries.end(); ++e) {
+			stream.writeByte(e->isDirectory ? 1 : 0);
+			writeIndexString(stream, e->name);
+		}
+	}
+
+	return stream.flush() && !stream.err();
+}
+
+FSIndex::TreeTimer::TreeTimer() : _start(0), _scans(0) {
+	FSIndex &index = FSIndexMan;
+	if (index._enabled) {
+		_start = g_system->getMillis(true);
+		_scans = index._scans;
+	}
+}
+
+FSIndex::TreeTimer::~TreeTimer() {
+	FSIndex &index = FSIndexMan;
+	if (!index._enabled)
+		return;
+
+	const uint32 elapsed = g_system->getMillis(true) - _start;
+	if (index._scans == _scans) {
+		index._indexedTrees++;
+		index._indexedMillis += elapsed;
+	} else {
+		index._scannedTrees++;
+		index._scannedMillis += elapsed;
+	}
+}
+
+} // End of namespace Common
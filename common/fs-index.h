@@ -0,0 +1,151 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_FS_INDEX_H
+#define COMMON_FS_INDEX_H
+
+#include "common/array.h"
+#include "common/fs.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/singleton.h"
+#include "common/str.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_fs_index File index
+ * @ingroup common_fs
+ *
+ * @brief Persistent cache of directory listings.
+ *
+ * @{
+ */
+
+class SeekableReadStream;
+class WriteStream;
+
+/**
+ * Persistent index of directory listings, used by FSDirectory to avoid
+ * enumerating large directory trees (e.g. on network shares) every time
+ * a game is started.
+ *
+ * Every directory is recorded by its path, together with its modification
+ * time and a hash of its listing. A record is only used while the modification
+ * time of the directory still matches; the listing hash protects against
+ * damaged index files. Backends which cannot report modification times
+ * always fall back to listing the directory, and so do directories modified
+ * too recently for their time to tell a further change apart.
+ *
+ * The index is disabled until open() is called, in which case getChildren()
+ * simply lists the directory.
+ */
+class FSIndex : public Singleton<FSIndex> {
+public:
+	/**
+	 * Use the given file as the persistent index. The file is loaded, unless
+	 * @p rebuild is set, in which case every directory is listed again and
+	 * the index is rewritten on the next flush().
+	 */
+	void open(const FSNode &file, bool rebuild = false);
+
+	/**
+	 * Write the index back to its file if it changed, and report how much
+	 * time was spent on directories served from the index and on directories
+	 * which had to be listed.
+	 */
+	void flush();
+
+	/** Return whether open() has been called. */
+	bool isEnabled() const { return _enabled; }
+
+	/**
+	 * List all children of a directory, like FSNode::getChildren() with
+	 * FSNode::kListAll, using the index when it is still valid for it.
+	 */
+	bool getChildren(const FSNode &dir, FSList &list);
+
+	/** Read records from a stream, replacing the current ones. */
+	bool load(SeekableReadStream &stream);
+
+	/** Write all records to a stream. */
+	bool save(WriteStream &stream) const;
+
+	/** Return the number of recorded directories. */
+	uint size() const { return _dirs.size(); }
+
+	/** Return the number of directories served from the index so far. */
+	uint getHits() const { return _hits; }
+
+	/** Return the number of directories which had to be listed so far. */
+	uint getScans() const { return _scans; }
+
+	/**
+	 * Measure the time taken to cache a whole directory tree, and whether
+	 * it came entirely from the index. FSDirectory creates one of these
+	 * around its recursive scan.
+	 */
+	class TreeTimer {
+	public:
+		TreeTimer();
+		~TreeTimer();
+
+	private:
+		uint32 _start;
+		uint _scans;
+	};
+
+private:
+	friend class Singleton<SingletonBaseType>;
+	FSIndex();
+
+	struct Entry {
+		String name;
+		bool isDirectory;
+	};
+
+	struct DirRecord {
+		uint64 mtime;
+		uint32 listingHash;
+		Array<Entry> entries;
+	};
+
+	static uint32 hashListing(const Array<Entry> &entries);
+
+	typedef HashMap<String, DirRecord> DirMap;
+	DirMap _dirs;
+	FSNode _file;
+	bool _enabled;
+	bool _dirty;
+
+	uint _hits, _scans;
+	uint _indexedTrees, _scannedTrees;
+	uint32 _indexedMillis, _scannedMillis;
+};
+
+/** Shortcut for accessing the file index. */
+#define FSIndexMan		Common::FSIndex::instance()
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
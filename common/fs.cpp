@@ -19,6 +19,7 @@
  *
  */
 
+#include "common/fs-index.h"
 #include "common/system.h"
 #include "common/punycode.h"
 #include "common/textconsole.h"
@@ -141,6 +142,21 @@ SeekableReadStream *FSNode::createReadStream() const {
 	return _realNode->createReadStream();
 }
 
+SeekableReadStream *FSNode::createMappedReadStream() const {
+	if (_realNode == nullptr)
+		return nullptr;
+
+	if (!_realNode->exists()) {
+		warning("FSNode::createMappedReadStream: '%s' does not exist", getName().c_str());
+		return nullptr;
+	} else if (_realNode->isDirectory()) {
+		warning("FSNode::createMappedReadStream: '%s' is a directory", getName().c_str());
+		return nullptr;
+	}
+
+	return _realNode->createMappedReadStream();
+}
+
 SeekableWriteStream *FSNode::createWriteStream() const {
 	if (_realNode == nullptr)
 		return nullptr;
@@ -263,6 +279,21 @@ SeekableReadStream *FSDirectory::createReadStreamForMember(const Path &path) con
 	return stream;
 }
 
+SeekableReadStream *FSDirectory::createMappedReadStreamForMember(const Path &path) const {
+	String name = path.rawString();
+	if (name.empty() || !_node.isDirectory())
+		return nullptr;
+
+	FSNode *node = lookupCache(_fileCache, name);
+	if (!node)
+		return nullptr;
+	SeekableReadStream *stream = node->createMappedReadStream();
+	if (!stream)
+		warning("FSDirectory::createMappedReadStreamForMember: Can't create stream for file '%s'", Common::toPrintable(name).c_str());
+
+	return stream;
+}
+
 FSDirectory *FSDirectory::getSubDirectory(const Path &name, int depth, bool flat, bool ignoreClashes) {
 	return getSubDirectory(Path(), name, depth, flat, ignoreClashes);
 }
@@ -285,7 +316,7 @@ void FSDirectory::cacheDirectoryRecursive(FSNode node, int depth, const Path& pr
 		return;
 
 	FSList list;
-	node.getChildren(list, FSNode::kListAll);
+	FSIndexMan.getChildren(node, list);
 
 	FSList::iterator it = list.begin();
 	for ( ; it != list.end(); ++it) {
@@ -329,6 +360,7 @@ void FSDirectory::cacheDirectoryRecursive(FSNode node, int depth, const Path& pr
 void FSDirectory::ensureCached() const  {
 	if (_cached)
 		return;
+	FSIndex::TreeTimer timer;
 	cacheDirectoryRecursive(_node, _depth, _prefix);
 	_cached = true;
 }
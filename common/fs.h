@@ -43,6 +43,7 @@ namespace Common {
  * @{
  */
 
+class FSIndex;
 class FSNode;
 class SeekableReadStream;
 class WriteStream;
@@ -68,6 +69,7 @@ class FSList : public Array<FSNode> {};
 class FSNode : public ArchiveMember {
 private:
 	friend class ::AbstractFSNode;
+	friend class FSIndex;
 	SharedPtr<AbstractFSNode>	_realNode;
 	/**
 	 * Construct an FSNode from a backend's AbstractFSNode implementation.
@@ -232,6 +234,16 @@ public:
 	 */
 	virtual SeekableReadStream *createReadStream() const;
 
+	/**
+	 * Create a SeekableReadStream instance like createReadStream(), which
+	 * the backend may map into memory. Only use it for files which are not
+	 * modified while the stream is open, like game data, but never for
+	 * savefiles or configuration files.
+	 *
+	 * @return Pointer to the stream object, 0 in case of a failure.
+	 */
+	SeekableReadStream *createMappedReadStream() const;
+
 	/**
 	 * Create a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -393,6 +405,12 @@ public:
 	 * for success.
 	 */
 	SeekableReadStream *createReadStreamForMember(const Path &path) const override;
+
+	/**
+	 * Open the specified file like createReadStreamForMember(), allowing it to be
+	 * mapped into memory.
+	 */
+	SeekableReadStream *createMappedReadStreamForMember(const Path &path) const override;
 };
 
 /** @} */
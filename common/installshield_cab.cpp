@@ -269,7 +269,7 @@ SeekableReadStream *InstallShieldCabinet::createReadStreamForMember(const Path &
 		return nullptr;
 	}
 
-	return new MemoryReadStream(dst, entry.uncompressedSize, DisposeAfterUse::YES);
+	return new SharedBufferReadStream(dst, entry.uncompressedSize);
 #else
 	warning("zlib required to extract compressed CAB file '%s'", name.c_str());
 	return 0;
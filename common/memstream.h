@@ -22,6 +22,7 @@
 #ifndef COMMON_MEMSTREAM_H
 #define COMMON_MEMSTREAM_H
 
+#include "common/ptr.h"
 #include "common/stream.h"
 #include "common/types.h"
 #include "common/util.h"
@@ -78,6 +79,54 @@ public:
 	int64 size() const { return _size; }
 
 	bool seek(int64 offs, int whence = SEEK_SET);
+
+	/**
+	 * Return a pointer to the memory block read by the stream.
+	 */
+	const byte *getData() const { return _ptrOrig; }
+};
+
+/**
+ * A MemoryReadStream whose memory block is reference counted.
+ *
+ * The streams returned by readStream() and slice() share the memory block
+ * instead of copying from it. The memory block is freed along with the last
+ * stream using it.
+ */
+class SharedBufferReadStream : public MemoryReadStream {
+private:
+	struct BufferDeleter {
+		void operator()(byte *buffer) { free(buffer); }
+	};
+
+	SharedPtr<byte> _buffer;
+
+public:
+	/**
+	 * Take ownership of a memory block allocated with malloc().
+	 */
+	SharedBufferReadStream(byte *dataPtr, uint32 dataSize) :
+		MemoryReadStream(dataPtr, dataSize),
+		_buffer(dataPtr, BufferDeleter()) {}
+
+	/**
+	 * Read a part of a memory block which is already shared.
+	 */
+	SharedBufferReadStream(const SharedPtr<byte> &buffer, const byte *dataPtr, uint32 dataSize) :
+		MemoryReadStream(dataPtr, dataSize),
+		_buffer(buffer) {}
+
+	/**
+	 * Return a stream for the range [begin, end) of this stream, sharing
+	 * its memory block.
+	 */
+	SharedBufferReadStream *slice(uint32 begin, uint32 end) const;
+
+	/**
+	 * Return a stream sharing the memory block for the next dataSize
+	 * bytes of this stream, and skip them.
+	 */
+	SeekableReadStream *readStream(uint32 dataSize) override;
 };
 
 
@@ -3,7 +3,9 @@ MODULE := common
 MODULE_OBJS := \
 	achievements.o \
 	archive.o \
+	atom.o \
 	base-str.o \
+	chunked-save.o \
 	config-manager.o \
 	coroutines.o \
 	dcl.o \
@@ -12,6 +14,7 @@ MODULE_OBJS := \
 	events.o \
 	file.o \
 	fs.o \
+	fs-index.o \
 	gui_options.o \
 	hashmap.o \
 	iff_container.o \
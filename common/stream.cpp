@@ -138,6 +138,28 @@ bool MemoryReadStream::seek(int64 offs, int whence) {
 
 #pragma mark -
 
+SharedBufferReadStream *SharedBufferReadStream::slice(uint32 begin, uint32 end) const {
+	assert(begin <= end && end <= size());
+	return new SharedBufferReadStream(_buffer, getData() + begin, end - begin);
+}
+
+SeekableReadStream *SharedBufferReadStream::readStream(uint32 dataSize) {
+	const uint32 begin = pos();
+	// Like read(), reach the end of the stream when asking for more data than available
+	if (dataSize > size() - begin) {
+		dataSize = size() - begin;
+		byte dummy;
+		seek(0, SEEK_END);
+		read(&dummy, 1);
+	} else {
+		seek(dataSize, SEEK_CUR);
+	}
+
+	return slice(begin, begin + dataSize);
+}
+
+#pragma mark -
+
 enum {
 	LF = 0x0A,
 	CR = 0x0D
@@ -237,7 +259,8 @@ uint32 SubReadStream::read(void *dataPtr, uint32 dataSize) {
 SeekableSubReadStream::SeekableSubReadStream(SeekableReadStream *parentStream, uint32 begin, uint32 end, DisposeAfterUse::Flag disposeParentStream)
 	: SubReadStream(parentStream, end, disposeParentStream),
 	_parentStream(parentStream),
-	_begin(begin) {
+	_begin(begin),
+	_sharedStream(dynamic_cast<SharedBufferReadStream *>(parentStream)) {
 	assert(_begin <= _end);
 	_pos = _begin;
 	_parentStream->seek(_pos);
@@ -270,6 +293,21 @@ bool SeekableSubReadStream::seek(int64 offset, int whence) {
 	return ret;
 }
 
+SeekableReadStream *SeekableSubReadStream::readStream(uint32 dataSize) {
+	if (!_sharedStream)
+		return SubReadStream::readStream(dataSize);
+
+	if (dataSize > _end - _pos) {
+		dataSize = _end - _pos;
+		_eos = true;
+	}
+
+	SeekableReadStream *stream = _sharedStream->readStream(dataSize);
+	_pos += stream->size();
+
+	return stream;
+}
+
 uint32 SafeSeekableSubReadStream::read(void *dataPtr, uint32 dataSize) {
 	// Make sure the parent stream is at the right position
 	seek(0, SEEK_CUR);
@@ -277,6 +315,13 @@ uint32 SafeSeekableSubReadStream::read(void *dataPtr, uint32 dataSize) {
 	return SeekableSubReadStream::read(dataPtr, dataSize);
 }
 
+SeekableReadStream *SafeSeekableSubReadStream::readStream(uint32 dataSize) {
+	// Make sure the parent stream is at the right position
+	seek(0, SEEK_CUR);
+
+	return SeekableSubReadStream::readStream(dataSize);
+}
+
 void SeekableReadStream::hexdump(int len, int bytesPerLine, int startOffset) {
 	uint pos_ = pos();
 	uint size_ = size();
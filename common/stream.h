@@ -634,7 +634,7 @@ public:
 	 * the end of the stream was reached. It can be determined by
 	 * calling err() and eos().
 	 */
-	SeekableReadStream *readStream(uint32 dataSize);
+	virtual SeekableReadStream *readStream(uint32 dataSize);
 
 	/**
 	 * Reads in a terminated string. Upon successful completion,
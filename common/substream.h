@@ -22,6 +22,7 @@
 #ifndef COMMON_SUBSTREAM_H
 #define COMMON_SUBSTREAM_H
 
+#include "common/memstream.h"
 #include "common/ptr.h"
 #include "common/stream.h"
 #include "common/types.h"
@@ -78,6 +79,9 @@ class SeekableSubReadStream : public SubReadStream, virtual public SeekableReadS
 protected:
 	SeekableReadStream *_parentStream;
 	uint32 _begin;
+
+	/** The parent stream, if it shares its memory with the streams returned by readStream() */
+	SharedBufferReadStream *_sharedStream;
 public:
 	SeekableSubReadStream(SeekableReadStream *parentStream, uint32 begin, uint32 end, DisposeAfterUse::Flag disposeParentStream = DisposeAfterUse::NO);
 
@@ -85,6 +89,7 @@ public:
 	virtual int64 size() const { return _end - _begin; }
 
 	virtual bool seek(int64 offset, int whence = SEEK_SET);
+	virtual SeekableReadStream *readStream(uint32 dataSize);
 };
 
 /**
@@ -130,6 +135,7 @@ public:
 	}
 
 	virtual uint32 read(void *dataPtr, uint32 dataSize);
+	virtual SeekableReadStream *readStream(uint32 dataSize);
 };
 
 /** @} */
@@ -114,7 +114,6 @@ void OSystem::initBackend() {
 
 void OSystem::destroy() {
 	_backendInitialized = false;
-	Common::String::releaseMemoryPoolMutex();
 	delete this;
 }
 
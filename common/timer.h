@@ -23,6 +23,7 @@
 #define COMMON_TIMER_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/str.h"
 #include "common/noncopyable.h"
 
@@ -41,6 +42,31 @@ class TimerManager : NonCopyable {
 public:
 	typedef void (*TimerProc)(void *refCon); /*!< Type definition of a timer instance. */
 
+	/**
+	 * Statistics about the invocations of an installed timer.
+	 */
+	struct TimerStats {
+		/**
+		 * Number of buckets of the latency histogram. The first bucket counts
+		 * the calls which were less than 1 ms late, bucket i the ones less
+		 * than 2^i ms late, and the last one all later calls.
+		 */
+		static const int kLatencyBuckets = 8;
+
+		Common::String id;                 /*!< ID of the timer. */
+		int32 interval;                    /*!< Interval of the timer (in microseconds). */
+		uint32 calls;                      /*!< Number of times the timer was invoked. */
+		uint32 overruns;                   /*!< Number of calls which were late by at least one interval. */
+		uint32 maxLatency;                 /*!< Maximum delay of a call after its deadline (in microseconds). */
+		uint32 maxRunTime;                 /*!< Maximum time spent in the callback (in microseconds). */
+		uint32 latencies[kLatencyBuckets]; /*!< Latency histogram. */
+
+		TimerStats() : interval(0), calls(0), overruns(0), maxLatency(0), maxRunTime(0) {
+			for (int i = 0; i < kLatencyBuckets; i++)
+				latencies[i] = 0;
+		}
+	};
+
 	virtual ~TimerManager() {}
 
 	/**
@@ -69,6 +95,18 @@ public:
 	 * of this callback will be running anymore.
 	 */
 	virtual void removeTimerProc(TimerProc proc) = 0;
+
+	/**
+	 * Get the statistics of all installed timers.
+	 *
+	 * @return	True if the timer manager keeps statistics, false otherwise.
+	 */
+	virtual bool getTimerStats(Common::Array<TimerStats> &stats) { return false; }
+
+	/**
+	 * Reset the statistics of all installed timers.
+	 */
+	virtual void resetTimerStats() {}
 };
 
 /** @} */
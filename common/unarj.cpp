@@ -808,7 +808,7 @@ SeekableReadStream *ArjArchive::createReadStreamForMember(const Path &path) cons
 		delete decoder;
 	}
 
-	return new MemoryReadStream(uncompressedData, hdr->origSize, DisposeAfterUse::YES);
+	return new SharedBufferReadStream(uncompressedData, hdr->origSize);
 }
 
 Archive *makeArjArchive(const String &name) {
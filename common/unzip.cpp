@@ -525,6 +525,70 @@ static uLong unzlocal_SearchCentralDir(Common::SeekableReadStream &fin) {
 	 Else, the return value is a unzFile Handle, usable with other function
 	   of this unzip package.
 */
+static void unzlocal_DosDateToTmuDate(uLong ulDosDate, tm_unz* ptm);
+
+/*
+  Fill the hash of the files in the zipfile.
+  The whole central directory is read at once and parsed from memory,
+  instead of reading each field of each entry from the zipfile.
+*/
+static void unzlocal_IndexCentralDir(unz_s *us) {
+	byte *centralDir = (byte *)malloc(us->size_central_dir);
+	if (!centralDir)
+		return;
+
+	us->_stream->seek(us->offset_central_dir + us->byte_before_the_zipfile, SEEK_SET);
+	if (us->_stream->err() || us->_stream->read(centralDir, us->size_central_dir) != us->size_central_dir) {
+		free(centralDir);
+		return;
+	}
+
+	uLong pos = 0;
+	for (uLong num_file = 0; num_file < us->gi.number_entry; num_file++) {
+		if (pos + SIZECENTRALDIRITEM > us->size_central_dir)
+			break;
+
+		const byte *entry = centralDir + pos;
+		if (READ_LE_UINT32(entry) != 0x02014b50)
+			break;
+
+		cached_file_in_zip fe;
+		unz_file_info &info = fe.cur_file_info;
+		info.version = READ_LE_UINT16(entry + 4);
+		info.version_needed = READ_LE_UINT16(entry + 6);
+		info.flag = READ_LE_UINT16(entry + 8);
+		info.compression_method = READ_LE_UINT16(entry + 10);
+		info.dosDate = READ_LE_UINT32(entry + 12);
+		unzlocal_DosDateToTmuDate(info.dosDate, &info.tmu_date);
+		info.crc = READ_LE_UINT32(entry + 16);
+		info.compressed_size = READ_LE_UINT32(entry + 20);
+		info.uncompressed_size = READ_LE_UINT32(entry + 24);
+		info.size_filename = READ_LE_UINT16(entry + 28);
+		info.size_file_extra = READ_LE_UINT16(entry + 30);
+		info.size_file_comment = READ_LE_UINT16(entry + 32);
+		info.disk_num_start = READ_LE_UINT16(entry + 34);
+		info.internal_fa = READ_LE_UINT16(entry + 36);
+		info.external_fa = READ_LE_UINT32(entry + 38);
+		fe.cur_file_info_internal.offset_curfile = READ_LE_UINT32(entry + 42);
+
+		const uLong entrySize = SIZECENTRALDIRITEM + info.size_filename +
+			info.size_file_extra + info.size_file_comment;
+		if (pos + entrySize > us->size_central_dir)
+			break;
+
+		fe.num_file = num_file;
+		fe.pos_in_central_dir = us->offset_central_dir + pos;
+		fe.current_file_ok = 1;
+
+		uLong nameLength = MIN<uLong>(info.size_filename, UNZ_MAXFILENAMEINZIP);
+		us->_hash[Common::String((const char *)entry + SIZECENTRALDIRITEM, nameLength)] = fe;
+
+		pos += entrySize;
+	}
+
+	free(centralDir);
+}
+
 unzFile unzOpen(Common::SeekableReadStream *stream) {
 	if (!stream)
 		return nullptr;
@@ -606,25 +670,9 @@ unzFile unzOpen(Common::SeekableReadStream *stream) {
 
 	err = unzGoToFirstFile((unzFile)us);
 
-	while (err == UNZ_OK) {
-		// Get the file details
-		char szCurrentFileName[UNZ_MAXFILENAMEINZIP+1];
-		unzGetCurrentFileInfo(us, nullptr, szCurrentFileName, sizeof(szCurrentFileName) - 1,
-							nullptr, 0, nullptr, 0);
+	if (err == UNZ_OK)
+		unzlocal_IndexCentralDir(us);
 
-		// Save details into the hash
-		cached_file_in_zip fe;
-		fe.num_file = us->num_file;
-		fe.pos_in_central_dir = us->pos_in_central_dir;
-		fe.current_file_ok = us->current_file_ok;
-		fe.cur_file_info = us->cur_file_info;
-		fe.cur_file_info_internal = us->cur_file_info_internal;
-
-		us->_hash[Common::String(szCurrentFileName)] = fe;
-
-		// Move to the next file
-		err = unzGoToNextFile((unzFile)us);
-	}
 	return (unzFile)us;
 }
 
@@ -1162,6 +1210,35 @@ int unzReadCurrentFile(unzFile file, voidp buf, unsigned len) {
 		  (uInt)pfile_in_zip_read_info->rest_read_uncompressed;
 
 	while (pfile_in_zip_read_info->stream.avail_out>0) {
+		if ((pfile_in_zip_read_info->compression_method==0) &&
+		    (pfile_in_zip_read_info->stream.avail_in==0) &&
+		    (pfile_in_zip_read_info->rest_read_compressed>0)) {
+			/* Stored data is read straight into the caller's buffer, without
+			   going through read_buffer */
+			uInt uReadThis = pfile_in_zip_read_info->stream.avail_out;
+			if (pfile_in_zip_read_info->rest_read_compressed<uReadThis)
+				uReadThis = (uInt)pfile_in_zip_read_info->rest_read_compressed;
+			pfile_in_zip_read_info->_stream->seek(pfile_in_zip_read_info->pos_in_zipfile +
+				pfile_in_zip_read_info->byte_before_the_zipfile, SEEK_SET);
+			if (pfile_in_zip_read_info->_stream->err())
+				return UNZ_ERRNO;
+			if (pfile_in_zip_read_info->_stream->read(pfile_in_zip_read_info->stream.next_out,uReadThis)!=uReadThis)
+				return UNZ_ERRNO;
+#ifdef USE_ZLIB
+			pfile_in_zip_read_info->crc32_data = crc32(pfile_in_zip_read_info->crc32_data,
+								pfile_in_zip_read_info->stream.next_out,
+								uReadThis);
+#endif
+			pfile_in_zip_read_info->pos_in_zipfile += uReadThis;
+			pfile_in_zip_read_info->rest_read_compressed -= uReadThis;
+			pfile_in_zip_read_info->rest_read_uncompressed -= uReadThis;
+			pfile_in_zip_read_info->stream.avail_out -= uReadThis;
+			pfile_in_zip_read_info->stream.next_out += uReadThis;
+			pfile_in_zip_read_info->stream.total_out += uReadThis;
+			iRead += uReadThis;
+			continue;
+		}
+
 		if ((pfile_in_zip_read_info->stream.avail_in==0) &&
 		    (pfile_in_zip_read_info->rest_read_compressed>0)) {
 			uInt uReadThis = UNZ_BUFSIZE;
@@ -1511,7 +1588,7 @@ SeekableReadStream *ZipArchive::createReadStreamForMember(const Path &path) cons
 		return nullptr;
 	}
 
-	return new MemoryReadStream(buffer, fileInfo.uncompressed_size, DisposeAfterUse::YES);
+	return new SharedBufferReadStream(buffer, fileInfo.uncompressed_size);
 
 	// FIXME: instead of reading all into a memory stream, we could
 	// instead create a new ZipStream class. But then we have to be
@@ -54,6 +54,10 @@ bool uncompress(byte *dst, unsigned long *dstLen, const byte *src, unsigned long
 	return Z_OK == ::uncompress(dst, dstLen, src, srcLen);
 }
 
+bool compress(byte *dst, unsigned long *dstLen, const byte *src, unsigned long srcLen, int level) {
+	return Z_OK == ::compress2(dst, dstLen, src, srcLen, level);
+}
+
 bool inflateZlibHeaderless(byte *dst, uint dstLen, const byte *src, uint srcLen, const byte *dict, uint dictLen) {
 	if (!dst || !dstLen || !src || !srcLen)
 		return false;
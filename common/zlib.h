@@ -61,6 +61,25 @@ class WriteStream;
  */
 bool uncompress(byte *dst, unsigned long *dstLen, const byte *src, unsigned long srcLen);
 
+/**
+ * Thin wrapper around zlib's compress2() function, the counterpart of
+ * uncompress().
+ *
+ * Compresses the src buffer into the dst buffer. Upon entry, dstLen is the
+ * total size of the destination buffer. Upon exit, dstLen is the actual
+ * size of the compressed data. Compression fails if the destination buffer
+ * is too small to hold it.
+ *
+ * @param dst       the buffer to store into.
+ * @param dstLen    a pointer to the size of the destination buffer.
+ * @param src       the data to be compressed.
+ * @param srcLen    the size of the data.
+ * @param level     the compression level, from 0 (none) to 9 (best).
+ *
+ * @return true on success (i.e. Z_OK), false otherwise.
+ */
+bool compress(byte *dst, unsigned long *dstLen, const byte *src, unsigned long srcLen, int level = 6);
+
 /**
  * Wrapper around zlib's inflate functions. This function will call the
  * necessary inflate functions to uncompress data compressed with deflate
@@ -34,6 +34,10 @@
 #include "scumm/resource.h"
 #include "scumm/scumm.h"
 #include "scumm/sound.h"
+#ifdef ENABLE_HE
+#include "scumm/he/intern_he.h"
+#include "scumm/he/wiz_he.h"
+#endif
 
 namespace Scumm {
 
@@ -79,6 +83,7 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 	registerCmd("scr",       WRAP_METHOD(ScummDebugger, Cmd_Script));
 	registerCmd("scripts",   WRAP_METHOD(ScummDebugger, Cmd_PrintScript));
 	registerCmd("importres", WRAP_METHOD(ScummDebugger, Cmd_ImportRes));
+	registerCmd("resources", WRAP_METHOD(ScummDebugger, Cmd_Resources));
 
 	if (_vm->_game.id == GID_LOOM)
 		registerCmd("drafts",  WRAP_METHOD(ScummDebugger, Cmd_PrintDraft));
@@ -93,6 +98,11 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 
 	registerCmd("show",      WRAP_METHOD(ScummDebugger, Cmd_Show));
 	registerCmd("hide",      WRAP_METHOD(ScummDebugger, Cmd_Hide));
+	registerCmd("opcodes",   WRAP_METHOD(ScummDebugger, Cmd_Opcodes));
+#ifdef ENABLE_HE
+	if (_vm->_game.heversion >= 71)
+		registerCmd("wiz",   WRAP_METHOD(ScummDebugger, Cmd_Wiz));
+#endif
 
 	if (_vm->_game.version < 7)
 		registerCmd("imuse", WRAP_METHOD(ScummDebugger, Cmd_IMuse));
@@ -412,8 +422,11 @@ bool ScummDebugger::Cmd_Show(int argc, const char **argv) {
 	} else if (!strncmp(argv[1], "sta", 3)) {
 		_vm->_showStack = 1;
 		debugPrintf("Stack tracing on\n");
+	} else if (!strcmp(argv[1], "frame")) {
+		_vm->_showFrameStats = true;
+		debugPrintf("Frame statistics on\n");
 	} else {
-		debugPrintf("Unknown show parameter '%s'\nParameters are 'hex' for hex dumping and 'sta' for stack tracing\n", argv[1]);
+		debugPrintf("Unknown show parameter '%s'\nParameters are 'hex' for hex dumping, 'sta' for stack tracing and 'frame' for frame statistics\n", argv[1]);
 	}
 	return true;
 }
@@ -431,9 +444,124 @@ bool ScummDebugger::Cmd_Hide(int argc, const char **argv) {
 	} else if (!strncmp(argv[1], "sta", 3)) {
 		_vm->_showStack = 0;
 		debugPrintf("Stack tracing off\n");
+	} else if (!strcmp(argv[1], "frame")) {
+		_vm->_showFrameStats = false;
+		debugPrintf("Frame statistics off\n");
 	} else {
-		debugPrintf("Unknown hide parameter '%s'\nParameters are 'hex' to turn off hex dumping and 'sta' to turn off stack tracing\n", argv[1]);
+		debugPrintf("Unknown hide parameter '%s'\nParameters are 'hex' to turn off hex dumping, 'sta' to turn off stack tracing and 'frame' to turn off frame statistics\n", argv[1]);
+	}
+	return true;
+}
+
+bool ScummDebugger::Cmd_Resources(int argc, const char **argv) {
+	if (argc == 2 && !strcmp(argv[1], "reset")) {
+		_vm->_res->resetStats();
+		debugPrintf("Resource statistics reset\n");
+		return true;
+	} else if (argc != 1) {
+		debugPrintf("Syntax: resources [reset]\n");
+		return true;
 	}
+
+	const ResourceManager::Stats &stats = _vm->_res->_stats;
+	const uint32 accesses = stats.hits + stats.misses;
+	debugPrintf("Heap: %u of %u bytes used\n", _vm->_res->getAllocatedSize(), _vm->_res->getHeapThreshold());
+	debugPrintf("Hits: %u (%.1f%%)\n", stats.hits, accesses ? 100.0 * stats.hits / accesses : 0.0);
+	debugPrintf("Misses: %u, %u of them reloading expired resources\n", stats.misses, stats.reloads);
+	debugPrintf("Prefetched: %u\n", stats.prefetches);
+	debugPrintf("Expired: %u, freeing %u bytes\n", stats.expired, stats.expiredSize);
+	return true;
+}
+
+bool ScummDebugger::Cmd_Opcodes(int argc, const char **argv) {
+	if (argc == 2 && !strcmp(argv[1], "on")) {
+		memset(_vm->_opcodeCounts, 0, sizeof(_vm->_opcodeCounts));
+		_vm->_profileOpcodes = true;
+		debugPrintf("Opcode profiling on\n");
+	} else if (argc == 2 && !strcmp(argv[1], "off")) {
+		_vm->_profileOpcodes = false;
+		debugPrintf("Opcode profiling off\n");
+	} else if (argc == 2 && !strcmp(argv[1], "reset")) {
+		memset(_vm->_opcodeCounts, 0, sizeof(_vm->_opcodeCounts));
+		debugPrintf("Opcode counts reset\n");
+	} else if (argc == 1) {
+		uint32 total = 0;
+		for (int i = 0; i < 256; i++)
+			total += _vm->_opcodeCounts[i];
+		debugPrintf("%u opcodes executed%s\n", total, _vm->_profileOpcodes ? "" : ", profiling is off");
+
+		// Print the opcodes executed most often
+		bool printed[256] = {};
+		for (int n = 0; n < 20; n++) {
+			int best = -1;
+			for (int i = 0; i < 256; i++) {
+				if (!printed[i] && _vm->_opcodeCounts[i] && (best == -1 || _vm->_opcodeCounts[i] > _vm->_opcodeCounts[best]))
+					best = i;
+			}
+			if (best == -1)
+				break;
+
+			printed[best] = true;
+			debugPrintf("  [%02X] %-24s %10u %5.1f%%\n", best, _vm->getOpcodeDesc(best), _vm->_opcodeCounts[best],
+			            100.0 * _vm->_opcodeCounts[best] / total);
+		}
+	} else {
+		debugPrintf("Syntax: opcodes [on|off|reset]\n");
+		debugPrintf("Without parameters, prints the opcodes executed most often\n");
+	}
+	return true;
+}
+
+bool ScummDebugger::Cmd_Wiz(int argc, const char **argv) {
+#ifdef ENABLE_HE
+	Wiz *wiz = ((ScummEngine_v71he *)_vm)->_wiz;
+
+	if (argc == 2 && !strcmp(argv[1], "record")) {
+		wiz->clearRecordedDraws();
+		wiz->_recordDraws = true;
+		debugPrintf("Recording images drawn to the screen, replay them with 'wiz replay'\n");
+		return true;
+	} else if ((argc == 2 || argc == 3) && !strcmp(argv[1], "replay")) {
+		wiz->_recordDraws = false;
+		const int passes = (argc == 3) ? atoi(argv[2]) : 100;
+		if (wiz->_recordedDraws.empty() || passes <= 0) {
+			debugPrintf("Nothing to replay, record the images of a scene with 'wiz record' first\n");
+			return true;
+		}
+
+		// The recorded draws are replayed into a scratch buffer, once decoding
+		// the compressed images every time and once using the decoded images
+		const VirtScreen &vs = _vm->_virtscr[kMainVirtScreen];
+		byte *buffer = (byte *)calloc(vs.pitch, vs.h);
+		const bool useDecodedImages = wiz->_useDecodedImages;
+		for (int i = 0; i < 2; ++i) {
+			wiz->_useDecodedImages = (i == 1);
+			wiz->replayWizDraws(buffer, vs.pitch, vs.w, vs.h);
+
+			const uint32 start = g_system->getMillis();
+			for (int j = 0; j < passes; ++j)
+				wiz->replayWizDraws(buffer, vs.pitch, vs.w, vs.h);
+			debugPrintf("%s images: %u ms for %d passes of %u draws\n", i ? "Decoded" : "Compressed",
+				g_system->getMillis() - start, passes, wiz->_recordedDraws.size());
+		}
+		wiz->_useDecodedImages = useDecodedImages;
+		free(buffer);
+		return true;
+	} else if (argc == 2 && (!strcmp(argv[1], "on") || !strcmp(argv[1], "off"))) {
+		wiz->_useDecodedImages = !strcmp(argv[1], "on");
+		if (!wiz->_useDecodedImages)
+			wiz->clearDecodedImages();
+	} else if (argc != 1) {
+		debugPrintf("Syntax: wiz [on|off|record|replay [passes]]\n");
+		return true;
+	}
+
+	const Wiz::CacheStats &stats = wiz->_cacheStats;
+	debugPrintf("Decoded images: %s, %u images using %u bytes\n", wiz->_useDecodedImages ? "on" : "off",
+		wiz->getDecodedImageCount(), wiz->getDecodedImageSize());
+	debugPrintf("Hits: %u, misses: %u, evicted: %u\n", stats.hits, stats.misses, stats.evicted);
+	debugPrintf("Recorded draws: %u%s\n", wiz->_recordedDraws.size(), wiz->_recordDraws ? " (recording)" : "");
+#endif
 	return true;
 }
 
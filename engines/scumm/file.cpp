@@ -50,7 +50,8 @@ void ScummFile::resetSubfile() {
 }
 
 bool ScummFile::open(const Common::Path &filename) {
-	if (File::open(filename)) {
+	// Game data files are never modified, so they can be mapped into memory
+	if (File::openMapped(filename)) {
 		resetSubfile();
 		return true;
 	} else {
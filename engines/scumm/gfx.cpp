@@ -20,6 +20,8 @@
  */
 
 #include "common/system.h"
+#include "graphics/font.h"
+#include "graphics/fontman.h"
 #include "scumm/actor.h"
 #include "scumm/charset.h"
 #ifdef ENABLE_HE
@@ -516,6 +518,19 @@ void ScummEngine::markRectAsDirty(VirtScreenNumber virt, int left, int right, in
  * code in the backend is controlled from here.
  */
 void ScummEngine::drawDirtyScreenParts() {
+	// The frame statistics are drawn over the screen, which has to be
+	// restored from the virtual screens below them
+	if (!_frameStatsRect.isEmpty()) {
+		for (int i = 0; i < 3; i++) {
+			const VirtScreen *vs = &_virtscr[i];
+			const int top = _frameStatsRect.top - vs->topline + _screenTop;
+			const int bottom = _frameStatsRect.bottom - vs->topline + _screenTop;
+			if (vs->h && bottom > 0 && top < vs->h)
+				markRectAsDirty((VirtScreenNumber)i, _frameStatsRect.left, _frameStatsRect.right, top, bottom);
+		}
+		_frameStatsRect = Common::Rect();
+	}
+
 	// Update verbs
 	updateDirtyScreen(kVerbVirtScreen);
 
@@ -531,6 +546,41 @@ void ScummEngine::drawDirtyScreenParts() {
 	} else {
 		updateDirtyScreen(kMainVirtScreen);
 	}
+
+	if (_showFrameStats)
+		drawFrameStats();
+	_frameStats.pixels = 0;
+	_frameStats.rects = 0;
+}
+
+/**
+ * Draw the number of pixels and rectangles copied to the screen in this frame
+ * in the top left corner of the screen.
+ */
+void ScummEngine::drawFrameStats() {
+	if (_macScreen || _game.platform == Common::kPlatformFMTowns ||
+		_renderMode == Common::kRenderHercA || _renderMode == Common::kRenderHercG)
+		return;
+
+	const Common::String text = Common::String::format("%u px in %u rects", _frameStats.pixels, _frameStats.rects);
+
+	const Graphics::Font *font = FontMan.getFontByUsage(Graphics::FontManager::kConsoleFont);
+	Graphics::Surface *screen = _system->lockScreen();
+	Common::Rect rect(0, 0, font->getStringWidth(text) + 4, font->getFontHeight() + 2);
+	rect.clip(Common::Rect(screen->w, screen->h));
+	if (screen->format.bytesPerPixel == 1) {
+		screen->fillRect(rect, 0);
+		font->drawString(screen, text, 2, 1, rect.width() - 2, 15);
+	} else {
+		screen->fillRect(rect, screen->format.RGBToColor(0, 0, 0));
+		font->drawString(screen, text, 2, 1, rect.width() - 2, screen->format.RGBToColor(255, 255, 255));
+	}
+	_system->unlockScreen();
+
+	// Restore the screen below the statistics in the next frame, in the
+	// coordinates of the virtual screens
+	const int m = _textSurfaceMultiplier;
+	_frameStatsRect = Common::Rect(0, 0, (rect.right + m - 1) / m, (rect.bottom + m - 1) / m);
 }
 
 void ScummEngine_v6::drawDirtyScreenParts() {
@@ -577,27 +627,23 @@ void ScummEngine::updateDirtyScreen(VirtScreenNumber slot) {
 	if (vs->h == 0)
 		return;
 
-	int i;
-	int w = 8;
-	int start = 0;
-
-	for (i = 0; i < _gdi->_numStrips; i++) {
-		if (vs->bdirty[i]) {
-			const int top = vs->tdirty[i];
-			const int bottom = vs->bdirty[i];
-			vs->tdirty[i] = vs->h;
-			vs->bdirty[i] = 0;
-			if (i != (_gdi->_numStrips - 1) && vs->bdirty[i + 1] == bottom && vs->tdirty[i + 1] == top) {
-				// Simple optimizations: if two or more neighboring strips
-				// form one bigger rectangle, coalesce them.
-				w += 8;
-				continue;
-			}
-			drawStripToScreen(vs, start * 8, w, top, bottom);
-			w = 8;
-		}
-		start = i + 1;
+	DirtyStripMerger merger;
+	Common::Rect rect;
+
+	for (int i = 0; i < _gdi->_numStrips; i++) {
+		const int top = vs->tdirty[i];
+		const int bottom = vs->bdirty[i];
+		if (!bottom)
+			continue;
+
+		vs->tdirty[i] = vs->h;
+		vs->bdirty[i] = 0;
+		if (bottom > top && merger.addStrip(Common::Rect(i * 8, top, i * 8 + 8, bottom), rect))
+			drawStripToScreen(vs, rect.left, rect.width(), rect.top, rect.bottom);
 	}
+
+	if (merger.finish(rect))
+		drawStripToScreen(vs, rect.left, rect.width(), rect.top, rect.bottom);
 }
 
 /**
@@ -633,6 +679,9 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 	if (width <= 0 || height <= 0)
 		return;
 
+	_frameStats.pixels += width * height;
+	_frameStats.rects++;
+
 	if (_macScreen) {
 		mac_drawStripToScreen(vs, top, x, y, width, height);
 		return;
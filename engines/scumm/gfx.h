@@ -24,6 +24,7 @@
 
 #include "common/system.h"
 #include "common/list.h"
+#include "common/rect.h"
 
 #include "graphics/surface.h"
 
@@ -190,6 +191,65 @@ struct VirtScreen : Graphics::Surface {
 	}
 };
 
+/**
+ * Merges the dirty parts of neighboring strips into rectangles, so that one
+ * copyRectToScreen() call updates them all. A strip joins the rectangle as
+ * long as at most a quarter of the merged rectangle is not dirty.
+ */
+class DirtyStripMerger {
+public:
+	DirtyStripMerger() : _dirtyArea(0) {}
+
+	/**
+	 * Add the dirty part of the next strip to the right.
+	 *
+	 * @param strip		The dirty part of the strip
+	 * @param flushed	Set to the rectangle collected so far, when the
+	 *					strip can't be merged with it
+	 * @return True if flushed was set
+	 */
+	bool addStrip(const Common::Rect &strip, Common::Rect &flushed) {
+		if (strip.isEmpty())
+			return false;
+
+		const int stripArea = strip.width() * strip.height();
+		if (!_rect.isEmpty() && _rect.right == strip.left) {
+			Common::Rect merged(_rect);
+			merged.extend(strip);
+			const int mergedArea = merged.width() * merged.height();
+			if (4 * (mergedArea - _dirtyArea - stripArea) <= mergedArea) {
+				_rect = merged;
+				_dirtyArea += stripArea;
+				return false;
+			}
+		}
+
+		const bool result = finish(flushed);
+		_rect = strip;
+		_dirtyArea = stripArea;
+		return result;
+	}
+
+	/**
+	 * Take the last rectangle.
+	 *
+	 * @return True if there was one
+	 */
+	bool finish(Common::Rect &flushed) {
+		if (_rect.isEmpty())
+			return false;
+
+		flushed = _rect;
+		_rect = Common::Rect();
+		_dirtyArea = 0;
+		return true;
+	}
+
+private:
+	Common::Rect _rect;
+	int _dirtyArea;
+};
+
 /** Palette cycles */
 struct ColorCycle {
 	uint16 delay;
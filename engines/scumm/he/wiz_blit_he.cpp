@@ -0,0 +1,982 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef ENABLE_HE
+
+#include "common/endian.h"
+#include "common/textconsole.h"
+#include "scumm/util.h"
+#include "scumm/he/wiz_he.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define WIZ_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define WIZ_NEON
+#endif
+
+namespace Scumm {
+
+void Wiz::copyAuxImage(uint8 *dst1, uint8 *dst2, const uint8 *src, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, uint8 bitDepth) {
+	assert(bitDepth == 1);
+
+	Common::Rect dstRect(srcx, srcy, srcx + srcw, srcy + srch);
+	dstRect.clip(dstw, dsth);
+
+	int rw = dstRect.width();
+	int rh = dstRect.height();
+	if (rh <= 0 || rw <= 0)
+		return;
+
+	uint8 *dst1Ptr = dst1 + dstRect.top * dstw + dstRect.left;
+	uint8 *dst2Ptr = dst2 + dstRect.top * dstw + dstRect.left;
+	const uint8 *dataPtr = src;
+
+	while (rh--) {
+		uint16 off = READ_LE_UINT16(dataPtr); dataPtr += 2;
+		const uint8 *dataPtrNext = off + dataPtr;
+		uint8 *dst1PtrNext = dst1Ptr + dstw;
+		uint8 *dst2PtrNext = dst2Ptr + dstw;
+		if (off != 0) {
+			int w = rw;
+			while (w > 0) {
+				uint8 code = *dataPtr++;
+				if (code & 1) {
+					code >>= 1;
+					dst1Ptr += code;
+					dst2Ptr += code;
+					w -= code;
+				} else if (code & 2) {
+					code = (code >> 2) + 1;
+					w -= code;
+					if (w >= 0) {
+						memset(dst1Ptr, *dataPtr++, code);
+						dst1Ptr += code;
+						dst2Ptr += code;
+					} else {
+						code += w;
+						memset(dst1Ptr, *dataPtr, code);
+					}
+				} else {
+					code = (code >> 2) + 1;
+					w -= code;
+					if (w >= 0) {
+						memcpy(dst1Ptr, dst2Ptr, code);
+						dst1Ptr += code;
+						dst2Ptr += code;
+					} else {
+						code += w;
+						memcpy(dst1Ptr, dst2Ptr, code);
+					}
+				}
+			}
+		}
+		dataPtr = dataPtrNext;
+		dst1Ptr = dst1PtrNext;
+		dst2Ptr = dst2PtrNext;
+	}
+}
+
+static bool calcClipRects(int dst_w, int dst_h, int src_x, int src_y, int src_w, int src_h, const Common::Rect *rect, Common::Rect &srcRect, Common::Rect &dstRect) {
+	srcRect = Common::Rect(src_w, src_h);
+	dstRect = Common::Rect(src_x, src_y, src_x + src_w, src_y + src_h);
+	Common::Rect r3;
+	int diff;
+
+	if (rect) {
+		r3 = *rect;
+		Common::Rect r4(dst_w, dst_h);
+		if (r3.intersects(r4)) {
+			r3.clip(r4);
+		} else {
+			return false;
+		}
+	} else {
+		r3 = Common::Rect(dst_w, dst_h);
+	}
+	diff = dstRect.left - r3.left;
+	if (diff < 0) {
+		srcRect.left -= diff;
+		dstRect.left -= diff;
+	}
+	diff = dstRect.right - r3.right;
+	if (diff > 0) {
+		srcRect.right -= diff;
+		dstRect.right -= diff;
+	}
+	diff = dstRect.top - r3.top;
+	if (diff < 0) {
+		srcRect.top -= diff;
+		dstRect.top -= diff;
+	}
+	diff = dstRect.bottom - r3.bottom;
+	if (diff > 0) {
+		srcRect.bottom -= diff;
+		dstRect.bottom -= diff;
+	}
+
+	return srcRect.isValidRect() && dstRect.isValidRect();
+}
+
+void Wiz::writeColor(uint8 *dstPtr, int dstType, uint16 color) {
+	switch (dstType) {
+	case kDstCursor:
+	case kDstScreen:
+		WRITE_UINT16(dstPtr, color);
+		break;
+	case kDstMemory:
+	case kDstResource:
+		WRITE_LE_UINT16(dstPtr, color);
+		break;
+	default:
+		error("writeColor: Unknown dstType %d", dstType);
+	}
+}
+
+/**
+ * Clips a compressed image to the destination and computes the part of the
+ * image to draw, taking flipping into account. dst is moved to the first
+ * pixel to write.
+ */
+static bool clipWizImage(uint8 *&dst, int dstPitch, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, uint8 bitDepth, Common::Rect &srcRect) {
+	Common::Rect r2;
+	if (!calcClipRects(dstw, dsth, srcx, srcy, srcw, srch, rect, srcRect, r2))
+		return false;
+
+	dst += r2.top * dstPitch + r2.left * bitDepth;
+	if (flags & kWIFFlipY) {
+		const int dy = (srcy < 0) ? srcy : (srch - srcRect.height());
+		srcRect.translate(0, dy);
+	}
+	if (flags & kWIFFlipX) {
+		const int dx = (srcx < 0) ? srcx : (srcw - srcRect.width());
+		srcRect.translate(dx, 0);
+	}
+	return true;
+}
+
+#ifdef USE_RGB_COLOR
+void Wiz::copy16BitWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, const uint8 *xmapPtr) {
+	Common::Rect r1;
+	if (clipWizImage(dst, dstPitch, dstw, dsth, srcx, srcy, srcw, srch, rect, flags, 2, r1)) {
+		if (xmapPtr) {
+			decompress16BitWizImage<kWizXMap>(dst, dstPitch, dstType, src, r1, flags, xmapPtr);
+		} else {
+			decompress16BitWizImage<kWizCopy>(dst, dstPitch, dstType, src, r1, flags);
+		}
+	}
+}
+#endif
+
+void Wiz::copyWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
+	Common::Rect r1;
+	if (clipWizImage(dst, dstPitch, dstw, dsth, srcx, srcy, srcw, srch, rect, flags, bitDepth, r1)) {
+		if (xmapPtr) {
+			decompressWizImage<kWizXMap>(dst, dstPitch, dstType, src, r1, flags, palPtr, xmapPtr, bitDepth);
+		} else if (palPtr) {
+			decompressWizImage<kWizRMap>(dst, dstPitch, dstType, src, r1, flags, palPtr, NULL, bitDepth);
+		} else {
+			decompressWizImage<kWizCopy>(dst, dstPitch, dstType, src, r1, flags, NULL, NULL, bitDepth);
+		}
+	}
+}
+
+static void decodeWizMask(uint8 *&dst, uint8 &mask, int w, int maskType) {
+	switch (maskType) {
+	case 0:
+		while (w--) {
+			mask >>= 1;
+			if (mask == 0) {
+				mask = 0x80;
+				++dst;
+			}
+		}
+		break;
+	case 1:
+		while (w--) {
+			*dst &= ~mask;
+			mask >>= 1;
+			if (mask == 0) {
+				mask = 0x80;
+				++dst;
+			}
+		}
+		break;
+	case 2:
+		while (w--) {
+			*dst |= mask;
+			mask >>= 1;
+			if (mask == 0) {
+				mask = 0x80;
+				++dst;
+			}
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+#ifdef USE_RGB_COLOR
+void Wiz::copyMaskWizImage(uint8 *dst, const uint8 *src, const uint8 *mask, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, const uint8 *palPtr) {
+	Common::Rect srcRect, dstRect;
+	if (!calcClipRects(dstw, dsth, srcx, srcy, srcw, srch, rect, srcRect, dstRect)) {
+		return;
+	}
+	dst += dstRect.top * dstPitch + dstRect.left * 2;
+	if (flags & kWIFFlipY) {
+		const int dy = (srcy < 0) ? srcy : (srch - srcRect.height());
+		srcRect.translate(0, dy);
+	}
+	if (flags & kWIFFlipX) {
+		const int dx = (srcx < 0) ? srcx : (srcw - srcRect.width());
+		srcRect.translate(dx, 0);
+	}
+
+	const uint8 *dataPtr, *dataPtrNext;
+	const uint8 *maskPtr, *maskPtrNext;
+	uint8 code, *dstPtr, *dstPtrNext;
+	int h, w, dstInc;
+
+	dataPtr = src;
+	dstPtr = dst;
+	maskPtr = mask;
+
+	// Skip over the first 'srcRect->top' lines in the data
+	dataPtr += dstRect.top * dstPitch + dstRect.left * 2;
+
+	h = dstRect.height();
+	w = dstRect.width();
+	if (h <= 0 || w <= 0)
+		return;
+
+	dstInc = 2;
+	if (flags & kWIFFlipX) {
+		dstPtr += (w - 1) * 2;
+		dstInc = -2;
+	}
+
+	while (h--) {
+		w = dstRect.width();
+		uint16 lineSize = READ_LE_UINT16(maskPtr); maskPtr += 2;
+		dataPtrNext = dataPtr + dstPitch;
+		dstPtrNext = dstPtr + dstPitch;
+		maskPtrNext = maskPtr + lineSize;
+		if (lineSize != 0) {
+			while (w > 0) {
+				code = *maskPtr++;
+				if (code & 1) {
+					code >>= 1;
+					dataPtr += dstInc * code;
+					dstPtr += dstInc * code;
+					w -= code;
+				} else if (code & 2) {
+					code = (code >> 2) + 1;
+					w -= code;
+					if (w < 0) {
+						code += w;
+					}
+					while (code--) {
+						if (*maskPtr != 5)
+							write16BitColor<kWizCopy>(dstPtr, dataPtr, dstType, palPtr);
+						dataPtr += 2;
+						dstPtr += dstInc;
+					}
+					maskPtr++;
+				} else {
+					code = (code >> 2) + 1;
+					w -= code;
+					if (w < 0) {
+						code += w;
+					}
+					while (code--) {
+						if (*maskPtr != 5)
+							write16BitColor<kWizCopy>(dstPtr, dataPtr, dstType, palPtr);
+						dataPtr += 2;
+						dstPtr += dstInc;
+						maskPtr++;
+					}
+				}
+			}
+		}
+		dataPtr = dataPtrNext;
+		dstPtr = dstPtrNext;
+		maskPtr = maskPtrNext;
+	}
+}
+#endif
+
+void Wiz::copyWizImageWithMask(uint8 *dst, const uint8 *src, int dstPitch, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int maskT, int maskP) {
+	Common::Rect srcRect, dstRect;
+	if (!calcClipRects(dstw, dsth, srcx, srcy, srcw, srch, rect, srcRect, dstRect)) {
+		return;
+	}
+	dstPitch /= 8;
+	dst += dstRect.top * dstPitch + dstRect.left / 8;
+
+	const uint8 *dataPtr, *dataPtrNext;
+	uint8 code, mask, *dstPtr, *dstPtrNext;
+	int h, w, xoff;
+	uint16 off;
+
+	dstPtr = dst;
+	dataPtr = src;
+
+	// Skip over the first 'srcRect->top' lines in the data
+	h = srcRect.top;
+	while (h--) {
+		dataPtr += READ_LE_UINT16(dataPtr) + 2;
+	}
+	h = srcRect.height();
+	w = srcRect.width();
+	if (h <= 0 || w <= 0)
+		return;
+
+	while (h--) {
+		xoff = srcRect.left;
+		w = srcRect.width();
+		mask = revBitMask(dstRect.left & 7);
+		off = READ_LE_UINT16(dataPtr); dataPtr += 2;
+		dstPtrNext = dstPtr + dstPitch;
+		dataPtrNext = dataPtr + off;
+		if (off != 0) {
+			while (w > 0) {
+				code = *dataPtr++;
+				if (code & 1) {
+					code >>= 1;
+					if (xoff > 0) {
+						xoff -= code;
+						if (xoff >= 0)
+							continue;
+
+						code = -xoff;
+					}
+					decodeWizMask(dstPtr, mask, code, maskT);
+					w -= code;
+				} else if (code & 2) {
+					code = (code >> 2) + 1;
+					if (xoff > 0) {
+						xoff -= code;
+						++dataPtr;
+						if (xoff >= 0)
+							continue;
+
+						code = -xoff;
+						--dataPtr;
+					}
+					w -= code;
+					if (w < 0) {
+						code += w;
+					}
+					decodeWizMask(dstPtr, mask, code, maskP);
+					dataPtr++;
+				} else {
+					code = (code >> 2) + 1;
+					if (xoff > 0) {
+						xoff -= code;
+						dataPtr += code;
+						if (xoff >= 0)
+							continue;
+
+						code = -xoff;
+						dataPtr += xoff;
+					}
+					w -= code;
+					if (w < 0) {
+						code += w;
+					}
+					decodeWizMask(dstPtr, mask, code, maskP);
+					dataPtr += code;
+				}
+			}
+		}
+		dataPtr = dataPtrNext;
+		dstPtr = dstPtrNext;
+	}
+}
+
+#ifdef USE_RGB_COLOR
+void Wiz::copyRaw16BitWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, int transColor) {
+	Common::Rect r1, r2;
+	if (calcClipRects(dstw, dsth, srcx, srcy, srcw, srch, rect, r1, r2)) {
+		if (flags & kWIFFlipX) {
+			int l = r1.left;
+			int r = r1.right;
+			r1.left = srcw - r;
+			r1.right = srcw - l;
+		}
+		if (flags & kWIFFlipY) {
+			int t = r1.top;
+			int b = r1.bottom;
+			r1.top = srch - b;
+			r1.bottom = srch - t;
+		}
+		int h = r1.height();
+		int w = r1.width();
+		src += (r1.top * srcw + r1.left) * 2;
+		dst += r2.top * dstPitch + r2.left * 2;
+		while (h--) {
+			for (int i = 0; i < w; ++ i) {
+				uint16 col = READ_LE_UINT16(src + 2 * i);
+				if (transColor == -1 || transColor != col) {
+					writeColor(dst + i * 2, dstType, col);
+				}
+			}
+			src += srcw * 2;
+			dst += dstPitch;
+		}
+	}
+}
+#endif
+
+void Wiz::copyRawWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, const uint8 *palPtr, int transColor, uint8 bitDepth) {
+	Common::Rect r1, r2;
+	if (calcClipRects(dstw, dsth, srcx, srcy, srcw, srch, rect, r1, r2)) {
+		if (flags & kWIFFlipX) {
+			int l = r1.left;
+			int r = r1.right;
+			r1.left = srcw - r;
+			r1.right = srcw - l;
+		}
+		if (flags & kWIFFlipY) {
+			int t = r1.top;
+			int b = r1.bottom;
+			r1.top = srch - b;
+			r1.bottom = srch - t;
+		}
+		int h = r1.height();
+		int w = r1.width();
+		src += r1.top * srcw + r1.left;
+		dst += r2.top * dstPitch + r2.left * bitDepth;
+		if (palPtr) {
+			decompressRawWizImage<kWizRMap>(dst, dstPitch, dstType, src, srcw, w, h, transColor, palPtr, bitDepth);
+		} else {
+			decompressRawWizImage<kWizCopy>(dst, dstPitch, dstType, src, srcw, w, h, transColor, NULL, bitDepth);
+		}
+	}
+}
+
+#ifdef SCUMM_LITTLE_ENDIAN
+/**
+ * Blends a run of 16 bit pixels into the destination at 50%, like a shadow
+ * (XMAP) does for 16 bit images.
+ */
+static void blendWizRun(uint8 *dst, const uint8 *src, int count) {
+#if defined(WIZ_SSE2)
+	const __m128i mask = _mm_set1_epi16(0x7DEF);
+	for (; count >= 8; count -= 8, src += 16, dst += 16) {
+		const __m128i s = _mm_and_si128(_mm_srli_epi16(_mm_loadu_si128((const __m128i *)src), 1), mask);
+		const __m128i d = _mm_and_si128(_mm_srli_epi16(_mm_loadu_si128((const __m128i *)dst), 1), mask);
+		_mm_storeu_si128((__m128i *)dst, _mm_add_epi16(s, d));
+	}
+#elif defined(WIZ_NEON)
+	const uint16x8_t mask = vdupq_n_u16(0x7DEF);
+	for (; count >= 8; count -= 8, src += 16, dst += 16) {
+		const uint16x8_t s = vandq_u16(vshrq_n_u16(vreinterpretq_u16_u8(vld1q_u8(src)), 1), mask);
+		const uint16x8_t d = vandq_u16(vshrq_n_u16(vreinterpretq_u16_u8(vld1q_u8(dst)), 1), mask);
+		vst1q_u8(dst, vreinterpretq_u8_u16(vaddq_u16(s, d)));
+	}
+#endif
+	for (; count > 0; --count, src += 2, dst += 2)
+		WRITE_UINT16(dst, ((READ_UINT16(src) >> 1) & 0x7DEF) + ((READ_UINT16(dst) >> 1) & 0x7DEF));
+}
+
+/**
+ * Copies a run of 8 bit pixels to a 16 bit destination.
+ */
+static void expandWizRun(uint8 *dst, const uint8 *src, int count) {
+#if defined(WIZ_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	for (; count >= 16; count -= 16, src += 16, dst += 32) {
+		const __m128i pixels = _mm_loadu_si128((const __m128i *)src);
+		_mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi8(pixels, zero));
+		_mm_storeu_si128((__m128i *)(dst + 16), _mm_unpackhi_epi8(pixels, zero));
+	}
+#elif defined(WIZ_NEON)
+	for (; count >= 8; count -= 8, src += 8, dst += 16)
+		vst1q_u8(dst, vreinterpretq_u8_u16(vmovl_u8(vld1_u8(src))));
+#endif
+	for (; count > 0; --count, ++src, dst += 2)
+		WRITE_UINT16(dst, *src);
+}
+#endif
+
+#ifdef USE_RGB_COLOR
+template<int type>
+void Wiz::write16BitColor(uint8 *dstPtr, const uint8 *dataPtr, int dstType, const uint8 *xmapPtr) {
+	uint16 col = READ_LE_UINT16(dataPtr);
+	if (type == kWizXMap) {
+		uint16 srcColor = (col >> 1) & 0x7DEF;
+		uint16 dstColor = (READ_UINT16(dstPtr) >> 1) & 0x7DEF;
+		uint16 newColor = srcColor + dstColor;
+		writeColor(dstPtr, dstType, newColor);
+	}
+	if (type == kWizCopy) {
+		writeColor(dstPtr, dstType, col);
+	}
+}
+
+template<int type>
+void Wiz::write16BitRun(uint8 *dstPtr, const uint8 *dataPtr, int count, int dstInc, int dstType, const uint8 *xmapPtr) {
+#ifdef SCUMM_LITTLE_ENDIAN
+	if (dstInc > 0) {
+		if (type == kWizXMap) {
+			blendWizRun(dstPtr, dataPtr, count);
+			return;
+		}
+		if (type == kWizCopy) {
+			memcpy(dstPtr, dataPtr, count * 2);
+			return;
+		}
+	}
+#endif
+	while (count--) {
+		write16BitColor<type>(dstPtr, dataPtr, dstType, xmapPtr);
+		dataPtr += 2;
+		dstPtr += dstInc;
+	}
+}
+
+template<int type>
+void Wiz::decompress16BitWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *xmapPtr) {
+	const uint8 *dataPtr, *dataPtrNext;
+	uint8 code;
+	uint8 *dstPtr, *dstPtrNext;
+	int h, w, xoff, dstInc;
+
+	if (type == kWizXMap) {
+		assert(xmapPtr != 0);
+	}
+
+	dstPtr = dst;
+	dataPtr = src;
+
+	// Skip over the first 'srcRect->top' lines in the data
+	h = srcRect.top;
+	while (h--) {
+		dataPtr += READ_LE_UINT16(dataPtr) + 2;
+	}
+	h = srcRect.height();
+	w = srcRect.width();
+	if (h <= 0 || w <= 0)
+		return;
+
+	if (flags & kWIFFlipY) {
+		dstPtr += (h - 1) * dstPitch;
+		dstPitch = -dstPitch;
+	}
+	dstInc = 2;
+	if (flags & kWIFFlipX) {
+		dstPtr += (w - 1) * 2;
+		dstInc = -2;
+	}
+
+	while (h--) {
+		xoff = srcRect.left;
+		w = srcRect.width();
+		uint16 lineSize = READ_LE_UINT16(dataPtr); dataPtr += 2;
+		dstPtrNext = dstPtr + dstPitch;
+		dataPtrNext = dataPtr + lineSize;
+		if (lineSize != 0) {
+			while (w > 0) {
+				code = *dataPtr++;
+				if (code & 1) {
+					code >>= 1;
+					if (xoff > 0) {
+						xoff -= code;
+						if (xoff >= 0)
+							continue;
+
+						code = -xoff;
+					}
+					dstPtr += dstInc * code;
+					w -= code;
+				} else if (code & 2) {
+					code = (code >> 2) + 1;
+					if (xoff > 0) {
+						xoff -= code;
+						dataPtr += 2;
+						if (xoff >= 0)
+							continue;
+
+						code = -xoff;
+						dataPtr -= 2;
+					}
+					w -= code;
+					if (w < 0) {
+						code += w;
+					}
+					while (code--) {
+						write16BitColor<type>(dstPtr, dataPtr, dstType, xmapPtr);
+						dstPtr += dstInc;
+					}
+					dataPtr += 2;
+				} else {
+					code = (code >> 2) + 1;
+					if (xoff > 0) {
+						xoff -= code;
+						dataPtr += code * 2;
+						if (xoff >= 0)
+							continue;
+
+						code = -xoff;
+						dataPtr += xoff * 2;
+					}
+					w -= code;
+					if (w < 0) {
+						code += w;
+					}
+					if (type == kWizXMap) {
+						write16BitRun<type>(dstPtr, dataPtr, code, dstInc, dstType, xmapPtr);
+						dataPtr += code * 2;
+						dstPtr += dstInc * code;
+					} else {
+						// Copying the short runs of the compressed data pixel
+						// by pixel is faster than calling memcpy for them
+						while (code--) {
+							write16BitColor<type>(dstPtr, dataPtr, dstType, xmapPtr);
+							dataPtr += 2;
+							dstPtr += dstInc;
+						}
+					}
+				}
+			}
+		}
+		dataPtr = dataPtrNext;
+		dstPtr = dstPtrNext;
+	}
+}
+#endif
+
+template<int type>
+void Wiz::write8BitColor(uint8 *dstPtr, const uint8 *dataPtr, int dstType, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
+	if (bitDepth == 2) {
+		if (type == kWizXMap) {
+			uint16 color = READ_LE_UINT16(palPtr + *dataPtr * 2);
+			uint16 srcColor = (color >> 1) & 0x7DEF;
+			uint16 dstColor = (READ_UINT16(dstPtr) >> 1) & 0x7DEF;
+			uint16 newColor = srcColor + dstColor;
+			writeColor(dstPtr, dstType, newColor);
+		}
+		if (type == kWizRMap) {
+			writeColor(dstPtr, dstType, READ_LE_UINT16(palPtr + *dataPtr * 2));
+		}
+		if (type == kWizCopy) {
+			writeColor(dstPtr, dstType, *dataPtr);
+		}
+	} else {
+		if (type == kWizXMap) {
+			*dstPtr = xmapPtr[*dataPtr * 256 + *dstPtr];
+		}
+		if (type == kWizRMap) {
+			*dstPtr = palPtr[*dataPtr];
+		}
+		if (type == kWizCopy) {
+			*dstPtr = *dataPtr;
+		}
+	}
+}
+
+template<int type>
+void Wiz::write8BitRun(uint8 *dstPtr, const uint8 *dataPtr, int count, int dstInc, int dstType, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
+	if (dstInc > 0) {
+		if (bitDepth == 1 && type == kWizCopy) {
+			memcpy(dstPtr, dataPtr, count);
+			return;
+		}
+#ifdef SCUMM_LITTLE_ENDIAN
+		if (bitDepth == 2 && type == kWizCopy) {
+			expandWizRun(dstPtr, dataPtr, count);
+			return;
+		}
+		if (bitDepth == 2 && type == kWizXMap) {
+			uint16 colors[64];
+			while (count > 0) {
+				const int n = MIN(count, ARRAYSIZE(colors));
+				for (int i = 0; i < n; ++i)
+					colors[i] = READ_LE_UINT16(palPtr + dataPtr[i] * 2);
+				blendWizRun(dstPtr, (const uint8 *)colors, n);
+				dataPtr += n;
+				dstPtr += n * 2;
+				count -= n;
+			}
+			return;
+		}
+#endif
+	}
+	while (count--) {
+		write8BitColor<type>(dstPtr, dataPtr, dstType, palPtr, xmapPtr, bitDepth);
+		dataPtr++;
+		dstPtr += dstInc;
+	}
+}
+
+template<int type>
+void Wiz::decompressWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
+	const uint8 *dataPtr, *dataPtrNext;
+	uint8 code, *dstPtr, *dstPtrNext;
+	int h, w, xoff, dstInc;
+
+	if (type == kWizXMap) {
+		assert(xmapPtr != 0);
+	}
+	if (type == kWizRMap) {
+		assert(palPtr != 0);
+	}
+
+	dstPtr = dst;
+	dataPtr = src;
+
+	// Skip over the first 'srcRect->top' lines in the data
+	h = srcRect.top;
+	while (h--) {
+		dataPtr += READ_LE_UINT16(dataPtr) + 2;
+	}
+	h = srcRect.height();
+	w = srcRect.width();
+	if (h <= 0 || w <= 0)
+		return;
+
+	if (flags & kWIFFlipY) {
+		dstPtr += (h - 1) * dstPitch;
+		dstPitch = -dstPitch;
+	}
+	dstInc = bitDepth;
+	if (flags & kWIFFlipX) {
+		dstPtr += (w - 1) * bitDepth;
+		dstInc = -bitDepth;
+	}
+
+	while (h--) {
+		xoff = srcRect.left;
+		w = srcRect.width();
+		uint16 lineSize = READ_LE_UINT16(dataPtr); dataPtr += 2;
+		dstPtrNext = dstPtr + dstPitch;
+		dataPtrNext = dataPtr + lineSize;
+		if (lineSize != 0) {
+			while (w > 0) {
+				code = *dataPtr++;
+				if (code & 1) {
+					code >>= 1;
+					if (xoff > 0) {
+						xoff -= code;
+						if (xoff >= 0)
+							continue;
+
+						code = -xoff;
+					}
+					dstPtr += dstInc * code;
+					w -= code;
+				} else if (code & 2) {
+					code = (code >> 2) + 1;
+					if (xoff > 0) {
+						xoff -= code;
+						++dataPtr;
+						if (xoff >= 0)
+							continue;
+
+						code = -xoff;
+						--dataPtr;
+					}
+					w -= code;
+					if (w < 0) {
+						code += w;
+					}
+					while (code--) {
+						write8BitColor<type>(dstPtr, dataPtr, dstType, palPtr, xmapPtr, bitDepth);
+						dstPtr += dstInc;
+					}
+					dataPtr++;
+				} else {
+					code = (code >> 2) + 1;
+					if (xoff > 0) {
+						xoff -= code;
+						dataPtr += code;
+						if (xoff >= 0)
+							continue;
+
+						code = -xoff;
+						dataPtr += xoff;
+					}
+					w -= code;
+					if (w < 0) {
+						code += w;
+					}
+					write8BitRun<type>(dstPtr, dataPtr, code, dstInc, dstType, palPtr, xmapPtr, bitDepth);
+					dataPtr += code;
+					dstPtr += dstInc * code;
+				}
+			}
+		}
+		dataPtr = dataPtrNext;
+		dstPtr = dstPtrNext;
+	}
+}
+
+// NOTE: These templates are used outside this file. We don't want the compiler to optimize them away, so we need to explicitely instantiate them.
+template void Wiz::decompressWizImage<kWizXMap>(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
+template void Wiz::decompressWizImage<kWizRMap>(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
+template void Wiz::decompressWizImage<kWizCopy>(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
+
+template<int type>
+void Wiz::decompressRawWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, int srcPitch, int w, int h, int transColor, const uint8 *palPtr, uint8 bitDepth) {
+	if (type == kWizRMap) {
+		assert(palPtr != 0);
+	}
+
+	if (w <= 0 || h <= 0) {
+		return;
+	}
+	while (h--) {
+		for (int i = 0; i < w; ++i) {
+			uint8 col = src[i];
+			if (transColor == -1 || transColor != col) {
+				if (type == kWizRMap) {
+					if (bitDepth == 2) {
+						writeColor(dst + i * 2, dstType, READ_LE_UINT16(palPtr + col * 2));
+					} else {
+						dst[i] = palPtr[col];
+					}
+				}
+				if (type == kWizCopy) {
+					if (bitDepth == 2) {
+						writeColor(dst + i * 2, dstType, col);
+					} else {
+						dst[i] = col;
+					}
+				}
+			}
+		}
+		src += srcPitch;
+		dst += dstPitch;
+	}
+}
+
+bool Wiz::decodeWizImage(WizDecodedImage &image, const uint8 *src, int width, int height, uint8 bytesPerPixel) {
+	if (width <= 0 || height <= 0 || width > 0xFFFF)
+		return false;
+
+	image.bytesPerPixel = bytesPerPixel;
+	image.width = width;
+	image.height = height;
+	image.rows.clear();
+	image.spans.clear();
+	image.pixels.clear();
+	image.rows.reserve(height + 1);
+
+	for (int y = 0; y < height; ++y) {
+		image.rows.push_back(image.spans.size());
+		const uint16 lineSize = READ_LE_UINT16(src); src += 2;
+		const uint8 *dataPtr = src;
+		const uint8 *dataPtrEnd = src + lineSize;
+		int x = 0;
+		while (x < width && dataPtr < dataPtrEnd) {
+			const uint8 code = *dataPtr++;
+			if (code & 1) {
+				x += code >> 1;
+				continue;
+			}
+
+			const int count = MIN((code >> 2) + 1, width - x);
+			// Opaque runs following each other are merged into one span
+			if (image.spans.size() > image.rows.back() && image.spans.back().x + image.spans.back().width == x) {
+				image.spans.back().width += count;
+			} else {
+				WizDecodedImage::Span span;
+				span.x = x;
+				span.width = count;
+				span.offset = image.pixels.size();
+				image.spans.push_back(span);
+			}
+
+			for (int i = 0; i < count * bytesPerPixel; ++i)
+				image.pixels.push_back((code & 2) ? dataPtr[i % bytesPerPixel] : dataPtr[i]);
+			dataPtr += ((code & 2) ? 1 : (code >> 2) + 1) * bytesPerPixel;
+			x += count;
+		}
+		src = dataPtrEnd;
+	}
+	image.rows.push_back(image.spans.size());
+	return true;
+}
+
+template<int type>
+void Wiz::copyDecodedWizImage(uint8 *dst, int dstPitch, int dstType, const WizDecodedImage &image, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
+	int h = srcRect.height();
+	int w = srcRect.width();
+	if (h <= 0 || w <= 0)
+		return;
+
+	uint8 *dstPtr = dst;
+	if (flags & kWIFFlipY) {
+		dstPtr += (h - 1) * dstPitch;
+		dstPitch = -dstPitch;
+	}
+	int dstInc = bitDepth;
+	if (flags & kWIFFlipX) {
+		dstPtr += (w - 1) * bitDepth;
+		dstInc = -bitDepth;
+	}
+
+	for (int y = srcRect.top; y < srcRect.bottom; ++y, dstPtr += dstPitch) {
+		if (y < 0 || y >= image.height)
+			continue;
+
+		const WizDecodedImage::Span *span = image.spans.begin() + image.rows[y];
+		const WizDecodedImage::Span *spanEnd = image.spans.begin() + image.rows[y + 1];
+		for (; span != spanEnd && span->x < srcRect.right; ++span) {
+			const int x1 = MAX<int>(span->x, srcRect.left);
+			const int x2 = MIN<int>(span->x + span->width, srcRect.right);
+			if (x1 >= x2)
+				continue;
+
+			const uint8 *dataPtr = image.pixels.begin() + span->offset + (x1 - span->x) * image.bytesPerPixel;
+			uint8 *runPtr = dstPtr + (x1 - srcRect.left) * dstInc;
+#ifdef USE_RGB_COLOR
+			if (image.bytesPerPixel == 2) {
+				write16BitRun<type == kWizXMap ? kWizXMap : kWizCopy>(runPtr, dataPtr, x2 - x1, dstInc, dstType, xmapPtr);
+				continue;
+			}
+#endif
+			write8BitRun<type>(runPtr, dataPtr, x2 - x1, dstInc, dstType, palPtr, xmapPtr, bitDepth);
+		}
+	}
+}
+
+void Wiz::copyDecodedWizImage(uint8 *dst, const WizDecodedImage &image, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
+	// 16 bit images are always drawn to 16 bit destinations
+	const uint8 dstBitDepth = (image.bytesPerPixel == 2) ? 2 : bitDepth;
+	Common::Rect r1;
+	if (clipWizImage(dst, dstPitch, dstw, dsth, srcx, srcy, srcw, srch, rect, flags, dstBitDepth, r1)) {
+		if (xmapPtr) {
+			copyDecodedWizImage<kWizXMap>(dst, dstPitch, dstType, image, r1, flags, palPtr, xmapPtr, dstBitDepth);
+		} else if (palPtr && image.bytesPerPixel == 1) {
+			copyDecodedWizImage<kWizRMap>(dst, dstPitch, dstType, image, r1, flags, palPtr, NULL, dstBitDepth);
+		} else {
+			copyDecodedWizImage<kWizCopy>(dst, dstPitch, dstType, image, r1, flags, NULL, NULL, dstBitDepth);
+		}
+	}
+}
+
+} // End of namespace Scumm
+
+#endif // ENABLE_HE
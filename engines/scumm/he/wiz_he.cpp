@@ -40,6 +40,15 @@ Wiz::Wiz(ScummEngine_v71he *vm) : _vm(vm) {
 	memset(&_polygons, 0, sizeof(_polygons));
 	_cursorImage = false;
 	_rectOverrideEnabled = false;
+	_useDecodedImages = true;
+	memset(&_cacheStats, 0, sizeof(_cacheStats));
+	_decodedSize = 0;
+	_decodedUseCounter = 0;
+	_recordDraws = false;
+}
+
+Wiz::~Wiz() {
+	clearDecodedImages();
 }
 
 void Wiz::clearWizBuffer() {
@@ -253,728 +262,131 @@ bool Wiz::polygonContains(const WizPolygon &pol, int x, int y) {
 	return r;
 }
 
-void Wiz::copyAuxImage(uint8 *dst1, uint8 *dst2, const uint8 *src, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, uint8 bitDepth) {
-	assert(bitDepth == 1);
-
-	Common::Rect dstRect(srcx, srcy, srcx + srcw, srcy + srch);
-	dstRect.clip(dstw, dsth);
-
-	int rw = dstRect.width();
-	int rh = dstRect.height();
-	if (rh <= 0 || rw <= 0)
-		return;
-
-	uint8 *dst1Ptr = dst1 + dstRect.top * dstw + dstRect.left;
-	uint8 *dst2Ptr = dst2 + dstRect.top * dstw + dstRect.left;
-	const uint8 *dataPtr = src;
-
-	while (rh--) {
-		uint16 off = READ_LE_UINT16(dataPtr); dataPtr += 2;
-		const uint8 *dataPtrNext = off + dataPtr;
-		uint8 *dst1PtrNext = dst1Ptr + dstw;
-		uint8 *dst2PtrNext = dst2Ptr + dstw;
-		if (off != 0) {
-			int w = rw;
-			while (w > 0) {
-				uint8 code = *dataPtr++;
-				if (code & 1) {
-					code >>= 1;
-					dst1Ptr += code;
-					dst2Ptr += code;
-					w -= code;
-				} else if (code & 2) {
-					code = (code >> 2) + 1;
-					w -= code;
-					if (w >= 0) {
-						memset(dst1Ptr, *dataPtr++, code);
-						dst1Ptr += code;
-						dst2Ptr += code;
-					} else {
-						code += w;
-						memset(dst1Ptr, *dataPtr, code);
-					}
-				} else {
-					code = (code >> 2) + 1;
-					w -= code;
-					if (w >= 0) {
-						memcpy(dst1Ptr, dst2Ptr, code);
-						dst1Ptr += code;
-						dst2Ptr += code;
-					} else {
-						code += w;
-						memcpy(dst1Ptr, dst2Ptr, code);
-					}
-				}
-			}
-		}
-		dataPtr = dataPtrNext;
-		dst1Ptr = dst1PtrNext;
-		dst2Ptr = dst2PtrNext;
-	}
-}
-
-static bool calcClipRects(int dst_w, int dst_h, int src_x, int src_y, int src_w, int src_h, const Common::Rect *rect, Common::Rect &srcRect, Common::Rect &dstRect) {
-	srcRect = Common::Rect(src_w, src_h);
-	dstRect = Common::Rect(src_x, src_y, src_x + src_w, src_y + src_h);
-	Common::Rect r3;
-	int diff;
-
-	if (rect) {
-		r3 = *rect;
-		Common::Rect r4(dst_w, dst_h);
-		if (r3.intersects(r4)) {
-			r3.clip(r4);
-		} else {
-			return false;
-		}
-	} else {
-		r3 = Common::Rect(dst_w, dst_h);
-	}
-	diff = dstRect.left - r3.left;
-	if (diff < 0) {
-		srcRect.left -= diff;
-		dstRect.left -= diff;
-	}
-	diff = dstRect.right - r3.right;
-	if (diff > 0) {
-		srcRect.right -= diff;
-		dstRect.right -= diff;
-	}
-	diff = dstRect.top - r3.top;
-	if (diff < 0) {
-		srcRect.top -= diff;
-		dstRect.top -= diff;
-	}
-	diff = dstRect.bottom - r3.bottom;
-	if (diff > 0) {
-		srcRect.bottom -= diff;
-		dstRect.bottom -= diff;
-	}
-
-	return srcRect.isValidRect() && dstRect.isValidRect();
-}
-
-void Wiz::writeColor(uint8 *dstPtr, int dstType, uint16 color) {
-	switch (dstType) {
-	case kDstCursor:
-	case kDstScreen:
-		WRITE_UINT16(dstPtr, color);
-		break;
-	case kDstMemory:
-	case kDstResource:
-		WRITE_LE_UINT16(dstPtr, color);
-		break;
-	default:
-		error("writeColor: Unknown dstType %d", dstType);
-	}
-}
-
+const WizDecodedImage *Wiz::getDecodedWizImage(int resNum, int state, uint8 *dataPtr, int comp, int width, int height) {
+	uint8 bytesPerPixel;
+	if (comp == 1) {
+		bytesPerPixel = 1;
 #ifdef USE_RGB_COLOR
-void Wiz::copy16BitWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, const uint8 *xmapPtr) {
-	Common::Rect r1, r2;
-	if (calcClipRects(dstw, dsth, srcx, srcy, srcw, srch, rect, r1, r2)) {
-		dst += r2.top * dstPitch + r2.left * 2;
-		if (flags & kWIFFlipY) {
-			const int dy = (srcy < 0) ? srcy : (srch - r1.height());
-			r1.translate(0, dy);
-		}
-		if (flags & kWIFFlipX) {
-			const int dx = (srcx < 0) ? srcx : (srcw - r1.width());
-			r1.translate(dx, 0);
-		}
-		if (xmapPtr) {
-			decompress16BitWizImage<kWizXMap>(dst, dstPitch, dstType, src, r1, flags, xmapPtr);
-		} else {
-			decompress16BitWizImage<kWizCopy>(dst, dstPitch, dstType, src, r1, flags);
-		}
-	}
-}
+	} else if (comp == 5) {
+		bytesPerPixel = 2;
 #endif
-
-void Wiz::copyWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
-	Common::Rect r1, r2;
-	if (calcClipRects(dstw, dsth, srcx, srcy, srcw, srch, rect, r1, r2)) {
-		dst += r2.top * dstPitch + r2.left * bitDepth;
-		if (flags & kWIFFlipY) {
-			const int dy = (srcy < 0) ? srcy : (srch - r1.height());
-			r1.translate(0, dy);
-		}
-		if (flags & kWIFFlipX) {
-			const int dx = (srcx < 0) ? srcx : (srcw - r1.width());
-			r1.translate(dx, 0);
-		}
-		if (xmapPtr) {
-			decompressWizImage<kWizXMap>(dst, dstPitch, dstType, src, r1, flags, palPtr, xmapPtr, bitDepth);
-		} else if (palPtr) {
-			decompressWizImage<kWizRMap>(dst, dstPitch, dstType, src, r1, flags, palPtr, NULL, bitDepth);
-		} else {
-			decompressWizImage<kWizCopy>(dst, dstPitch, dstType, src, r1, flags, NULL, NULL, bitDepth);
-		}
-	}
-}
-
-static void decodeWizMask(uint8 *&dst, uint8 &mask, int w, int maskType) {
-	switch (maskType) {
-	case 0:
-		while (w--) {
-			mask >>= 1;
-			if (mask == 0) {
-				mask = 0x80;
-				++dst;
-			}
-		}
-		break;
-	case 1:
-		while (w--) {
-			*dst &= ~mask;
-			mask >>= 1;
-			if (mask == 0) {
-				mask = 0x80;
-				++dst;
-			}
-		}
-		break;
-	case 2:
-		while (w--) {
-			*dst |= mask;
-			mask >>= 1;
-			if (mask == 0) {
-				mask = 0x80;
-				++dst;
-			}
-		}
-		break;
-	default:
-		break;
-	}
-}
-
-#ifdef USE_RGB_COLOR
-void Wiz::copyMaskWizImage(uint8 *dst, const uint8 *src, const uint8 *mask, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, const uint8 *palPtr) {
-	Common::Rect srcRect, dstRect;
-	if (!calcClipRects(dstw, dsth, srcx, srcy, srcw, srch, rect, srcRect, dstRect)) {
-		return;
-	}
-	dst += dstRect.top * dstPitch + dstRect.left * 2;
-	if (flags & kWIFFlipY) {
-		const int dy = (srcy < 0) ? srcy : (srch - srcRect.height());
-		srcRect.translate(0, dy);
-	}
-	if (flags & kWIFFlipX) {
-		const int dx = (srcx < 0) ? srcx : (srcw - srcRect.width());
-		srcRect.translate(dx, 0);
+	} else {
+		return NULL;
 	}
+	if (width * height * bytesPerPixel > kMaxDecodedSize / 4)
+		return NULL;
 
-	const uint8 *dataPtr, *dataPtrNext;
-	const uint8 *maskPtr, *maskPtrNext;
-	uint8 code, *dstPtr, *dstPtrNext;
-	int h, w, dstInc;
-
-	dataPtr = src;
-	dstPtr = dst;
-	maskPtr = mask;
-
-	// Skip over the first 'srcRect->top' lines in the data
-	dataPtr += dstRect.top * dstPitch + dstRect.left * 2;
+	const uint32 key = ((uint32)resNum << 16) | (state & 0xFFFF);
+	Common::HashMap<uint32, WizDecodedImage *>::iterator i = _decodedImages.find(key);
 
-	h = dstRect.height();
-	w = dstRect.width();
-	if (h <= 0 || w <= 0)
-		return;
-
-	dstInc = 2;
-	if (flags & kWIFFlipX) {
-		dstPtr += (w - 1) * 2;
-		dstInc = -2;
-	}
-
-	while (h--) {
-		w = dstRect.width();
-		uint16 lineSize = READ_LE_UINT16(maskPtr); maskPtr += 2;
-		dataPtrNext = dataPtr + dstPitch;
-		dstPtrNext = dstPtr + dstPitch;
-		maskPtrNext = maskPtr + lineSize;
-		if (lineSize != 0) {
-			while (w > 0) {
-				code = *maskPtr++;
-				if (code & 1) {
-					code >>= 1;
-					dataPtr += dstInc * code;
-					dstPtr += dstInc * code;
-					w -= code;
-				} else if (code & 2) {
-					code = (code >> 2) + 1;
-					w -= code;
-					if (w < 0) {
-						code += w;
-					}
-					while (code--) {
-						if (*maskPtr != 5)
-							write16BitColor<kWizCopy>(dstPtr, dataPtr, dstType, palPtr);
-						dataPtr += 2;
-						dstPtr += dstInc;
-					}
-					maskPtr++;
-				} else {
-					code = (code >> 2) + 1;
-					w -= code;
-					if (w < 0) {
-						code += w;
-					}
-					while (code--) {
-						if (*maskPtr != 5)
-							write16BitColor<kWizCopy>(dstPtr, dataPtr, dstType, palPtr);
-						dataPtr += 2;
-						dstPtr += dstInc;
-						maskPtr++;
-					}
-				}
-			}
+	// Images which were changed by the scripts are decoded every time
+	// they are drawn, like before
+	if (_vm->_res->isModified(rtImage, resNum)) {
+		if (i != _decodedImages.end()) {
+			_decodedSize -= i->_value->getSize();
+			delete i->_value;
+			_decodedImages.erase(i);
 		}
-		dataPtr = dataPtrNext;
-		dstPtr = dstPtrNext;
-		maskPtr = maskPtrNext;
-	}
-}
-#endif
-
-void Wiz::copyWizImageWithMask(uint8 *dst, const uint8 *src, int dstPitch, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int maskT, int maskP) {
-	Common::Rect srcRect, dstRect;
-	if (!calcClipRects(dstw, dsth, srcx, srcy, srcw, srch, rect, srcRect, dstRect)) {
-		return;
+		return NULL;
 	}
-	dstPitch /= 8;
-	dst += dstRect.top * dstPitch + dstRect.left / 8;
 
-	const uint8 *dataPtr, *dataPtrNext;
-	uint8 code, mask, *dstPtr, *dstPtrNext;
-	int h, w, xoff;
-	uint16 off;
-
-	dstPtr = dst;
-	dataPtr = src;
-
-	// Skip over the first 'srcRect->top' lines in the data
-	h = srcRect.top;
-	while (h--) {
-		dataPtr += READ_LE_UINT16(dataPtr) + 2;
-	}
-	h = srcRect.height();
-	w = srcRect.width();
-	if (h <= 0 || w <= 0)
-		return;
-
-	while (h--) {
-		xoff = srcRect.left;
-		w = srcRect.width();
-		mask = revBitMask(dstRect.left & 7);
-		off = READ_LE_UINT16(dataPtr); dataPtr += 2;
-		dstPtrNext = dstPtr + dstPitch;
-		dataPtrNext = dataPtr + off;
-		if (off != 0) {
-			while (w > 0) {
-				code = *dataPtr++;
-				if (code & 1) {
-					code >>= 1;
-					if (xoff > 0) {
-						xoff -= code;
-						if (xoff >= 0)
-							continue;
-
-						code = -xoff;
-					}
-					decodeWizMask(dstPtr, mask, code, maskT);
-					w -= code;
-				} else if (code & 2) {
-					code = (code >> 2) + 1;
-					if (xoff > 0) {
-						xoff -= code;
-						++dataPtr;
-						if (xoff >= 0)
-							continue;
-
-						code = -xoff;
-						--dataPtr;
-					}
-					w -= code;
-					if (w < 0) {
-						code += w;
-					}
-					decodeWizMask(dstPtr, mask, code, maskP);
-					dataPtr++;
-				} else {
-					code = (code >> 2) + 1;
-					if (xoff > 0) {
-						xoff -= code;
-						dataPtr += code;
-						if (xoff >= 0)
-							continue;
-
-						code = -xoff;
-						dataPtr += xoff;
-					}
-					w -= code;
-					if (w < 0) {
-						code += w;
-					}
-					decodeWizMask(dstPtr, mask, code, maskP);
-					dataPtr += code;
-				}
-			}
+	WizDecodedImage *image = NULL;
+	if (i != _decodedImages.end()) {
+		image = i->_value;
+		if (image->resource == dataPtr) {
+			image->lastUse = ++_decodedUseCounter;
+			++_cacheStats.hits;
+			return image;
 		}
-		dataPtr = dataPtrNext;
-		dstPtr = dstPtrNext;
+		// The resource was loaded again
+		_decodedSize -= image->getSize();
+	} else {
+		image = new WizDecodedImage();
 	}
-}
 
-#ifdef USE_RGB_COLOR
-void Wiz::copyRaw16BitWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, int transColor) {
-	Common::Rect r1, r2;
-	if (calcClipRects(dstw, dsth, srcx, srcy, srcw, srch, rect, r1, r2)) {
-		if (flags & kWIFFlipX) {
-			int l = r1.left;
-			int r = r1.right;
-			r1.left = srcw - r;
-			r1.right = srcw - l;
-		}
-		if (flags & kWIFFlipY) {
-			int t = r1.top;
-			int b = r1.bottom;
-			r1.top = srch - b;
-			r1.bottom = srch - t;
-		}
-		int h = r1.height();
-		int w = r1.width();
-		src += (r1.top * srcw + r1.left) * 2;
-		dst += r2.top * dstPitch + r2.left * 2;
-		while (h--) {
-			for (int i = 0; i < w; ++ i) {
-				uint16 col = READ_LE_UINT16(src + 2 * i);
-				if (transColor == -1 || transColor != col) {
-					writeColor(dst + i * 2, dstType, col);
-				}
-			}
-			src += srcw * 2;
-			dst += dstPitch;
-		}
+	const uint8 *wizd = _vm->findWrappedBlock(MKTAG('W','I','Z','D'), dataPtr, state, 0);
+	if (!wizd || !decodeWizImage(*image, wizd, width, height, bytesPerPixel)) {
+		delete image;
+		_decodedImages.erase(key);
+		return NULL;
 	}
+
+	++_cacheStats.misses;
+	image->resource = dataPtr;
+	image->lastUse = ++_decodedUseCounter;
+	_decodedImages.erase(key);
+	evictDecodedImages(image->getSize());
+	_decodedImages[key] = image;
+	_decodedSize += image->getSize();
+	return image;
 }
-#endif
 
-void Wiz::copyRawWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, const uint8 *palPtr, int transColor, uint8 bitDepth) {
-	Common::Rect r1, r2;
-	if (calcClipRects(dstw, dsth, srcx, srcy, srcw, srch, rect, r1, r2)) {
-		if (flags & kWIFFlipX) {
-			int l = r1.left;
-			int r = r1.right;
-			r1.left = srcw - r;
-			r1.right = srcw - l;
-		}
-		if (flags & kWIFFlipY) {
-			int t = r1.top;
-			int b = r1.bottom;
-			r1.top = srch - b;
-			r1.bottom = srch - t;
-		}
-		int h = r1.height();
-		int w = r1.width();
-		src += r1.top * srcw + r1.left;
-		dst += r2.top * dstPitch + r2.left * bitDepth;
-		if (palPtr) {
-			decompressRawWizImage<kWizRMap>(dst, dstPitch, dstType, src, srcw, w, h, transColor, palPtr, bitDepth);
-		} else {
-			decompressRawWizImage<kWizCopy>(dst, dstPitch, dstType, src, srcw, w, h, transColor, NULL, bitDepth);
+void Wiz::evictDecodedImages(uint32 size) {
+	while (!_decodedImages.empty() && _decodedSize + size > kMaxDecodedSize) {
+		Common::HashMap<uint32, WizDecodedImage *>::iterator oldest = _decodedImages.begin();
+		for (Common::HashMap<uint32, WizDecodedImage *>::iterator i = _decodedImages.begin(); i != _decodedImages.end(); ++i) {
+			if (i->_value->lastUse < oldest->_value->lastUse)
+				oldest = i;
 		}
+		_decodedSize -= oldest->_value->getSize();
+		delete oldest->_value;
+		_decodedImages.erase(oldest);
+		++_cacheStats.evicted;
 	}
 }
 
-#ifdef USE_RGB_COLOR
-template<int type>
-void Wiz::write16BitColor(uint8 *dstPtr, const uint8 *dataPtr, int dstType, const uint8 *xmapPtr) {
-	uint16 col = READ_LE_UINT16(dataPtr);
-	if (type == kWizXMap) {
-		uint16 srcColor = (col >> 1) & 0x7DEF;
-		uint16 dstColor = (READ_UINT16(dstPtr) >> 1) & 0x7DEF;
-		uint16 newColor = srcColor + dstColor;
-		writeColor(dstPtr, dstType, newColor);
-	}
-	if (type == kWizCopy) {
-		writeColor(dstPtr, dstType, col);
-	}
+void Wiz::clearDecodedImages() {
+	for (Common::HashMap<uint32, WizDecodedImage *>::iterator i = _decodedImages.begin(); i != _decodedImages.end(); ++i)
+		delete i->_value;
+	_decodedImages.clear();
+	_decodedSize = 0;
 }
 
-template<int type>
-void Wiz::decompress16BitWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *xmapPtr) {
-	const uint8 *dataPtr, *dataPtrNext;
-	uint8 code;
-	uint8 *dstPtr, *dstPtrNext;
-	int h, w, xoff, dstInc;
+bool Wiz::drawDecodedWizImage(uint8 *dst, int resNum, int state, uint8 *dataPtr, int comp, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
+	if (!_useDecodedImages || (flags & (kWIFZPlaneOn | kWIFZPlaneOff)))
+		return false;
 
-	if (type == kWizXMap) {
-		assert(xmapPtr != 0);
-	}
+	const WizDecodedImage *image = getDecodedWizImage(resNum, state, dataPtr, comp, srcw, srch);
+	if (!image)
+		return false;
 
-	dstPtr = dst;
-	dataPtr = src;
-
-	// Skip over the first 'srcRect->top' lines in the data
-	h = srcRect.top;
-	while (h--) {
-		dataPtr += READ_LE_UINT16(dataPtr) + 2;
-	}
-	h = srcRect.height();
-	w = srcRect.width();
-	if (h <= 0 || w <= 0)
-		return;
-
-	if (flags & kWIFFlipY) {
-		dstPtr += (h - 1) * dstPitch;
-		dstPitch = -dstPitch;
-	}
-	dstInc = 2;
-	if (flags & kWIFFlipX) {
-		dstPtr += (w - 1) * 2;
-		dstInc = -2;
-	}
-
-	while (h--) {
-		xoff = srcRect.left;
-		w = srcRect.width();
-		uint16 lineSize = READ_LE_UINT16(dataPtr); dataPtr += 2;
-		dstPtrNext = dstPtr + dstPitch;
-		dataPtrNext = dataPtr + lineSize;
-		if (lineSize != 0) {
-			while (w > 0) {
-				code = *dataPtr++;
-				if (code & 1) {
-					code >>= 1;
-					if (xoff > 0) {
-						xoff -= code;
-						if (xoff >= 0)
-							continue;
-
-						code = -xoff;
-					}
-					dstPtr += dstInc * code;
-					w -= code;
-				} else if (code & 2) {
-					code = (code >> 2) + 1;
-					if (xoff > 0) {
-						xoff -= code;
-						dataPtr += 2;
-						if (xoff >= 0)
-							continue;
-
-						code = -xoff;
-						dataPtr -= 2;
-					}
-					w -= code;
-					if (w < 0) {
-						code += w;
-					}
-					while (code--) {
-						write16BitColor<type>(dstPtr, dataPtr, dstType, xmapPtr);
-						dstPtr += dstInc;
-					}
-					dataPtr += 2;
-				} else {
-					code = (code >> 2) + 1;
-					if (xoff > 0) {
-						xoff -= code;
-						dataPtr += code * 2;
-						if (xoff >= 0)
-							continue;
-
-						code = -xoff;
-						dataPtr += xoff * 2;
-					}
-					w -= code;
-					if (w < 0) {
-						code += w;
-					}
-					while (code--) {
-						write16BitColor<type>(dstPtr, dataPtr, dstType, xmapPtr);
-						dataPtr += 2;
-						dstPtr += dstInc;
-					}
-				}
-			}
-		}
-		dataPtr = dataPtrNext;
-		dstPtr = dstPtrNext;
-	}
+	copyDecodedWizImage(dst, *image, dstPitch, dstType, dstw, dsth, srcx, srcy, srcw, srch, rect, flags, palPtr, xmapPtr, bitDepth);
+	return true;
 }
-#endif
 
-template<int type>
-void Wiz::write8BitColor(uint8 *dstPtr, const uint8 *dataPtr, int dstType, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
-	if (bitDepth == 2) {
-		if (type == kWizXMap) {
-			uint16 color = READ_LE_UINT16(palPtr + *dataPtr * 2);
-			uint16 srcColor = (color >> 1) & 0x7DEF;
-			uint16 dstColor = (READ_UINT16(dstPtr) >> 1) & 0x7DEF;
-			uint16 newColor = srcColor + dstColor;
-			writeColor(dstPtr, dstType, newColor);
-		}
-		if (type == kWizRMap) {
-			writeColor(dstPtr, dstType, READ_LE_UINT16(palPtr + *dataPtr * 2));
-		}
-		if (type == kWizCopy) {
-			writeColor(dstPtr, dstType, *dataPtr);
-		}
-	} else {
-		if (type == kWizXMap) {
-			*dstPtr = xmapPtr[*dataPtr * 256 + *dstPtr];
-		}
-		if (type == kWizRMap) {
-			*dstPtr = palPtr[*dataPtr];
-		}
-		if (type == kWizCopy) {
-			*dstPtr = *dataPtr;
-		}
-	}
+void Wiz::clearRecordedDraws() {
+	_recordedDraws.clear();
+	_recordedPalettes.clear();
 }
 
-template<int type>
-void Wiz::decompressWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
-	const uint8 *dataPtr, *dataPtrNext;
-	uint8 code, *dstPtr, *dstPtrNext;
-	int h, w, xoff, dstInc;
-
-	if (type == kWizXMap) {
-		assert(xmapPtr != 0);
-	}
-	if (type == kWizRMap) {
-		assert(palPtr != 0);
-	}
-
-	dstPtr = dst;
-	dataPtr = src;
+void Wiz::replayWizDraws(uint8 *dst, int dstPitch, int dstw, int dsth) {
+	for (uint i = 0; i < _recordedDraws.size(); ++i) {
+		const WizDrawCall &call = _recordedDraws[i];
 
-	// Skip over the first 'srcRect->top' lines in the data
-	h = srcRect.top;
-	while (h--) {
-		dataPtr += READ_LE_UINT16(dataPtr) + 2;
-	}
-	h = srcRect.height();
-	w = srcRect.width();
-	if (h <= 0 || w <= 0)
-		return;
-
-	if (flags & kWIFFlipY) {
-		dstPtr += (h - 1) * dstPitch;
-		dstPitch = -dstPitch;
-	}
-	dstInc = bitDepth;
-	if (flags & kWIFFlipX) {
-		dstPtr += (w - 1) * bitDepth;
-		dstInc = -bitDepth;
-	}
-
-	while (h--) {
-		xoff = srcRect.left;
-		w = srcRect.width();
-		uint16 lineSize = READ_LE_UINT16(dataPtr); dataPtr += 2;
-		dstPtrNext = dstPtr + dstPitch;
-		dataPtrNext = dataPtr + lineSize;
-		if (lineSize != 0) {
-			while (w > 0) {
-				code = *dataPtr++;
-				if (code & 1) {
-					code >>= 1;
-					if (xoff > 0) {
-						xoff -= code;
-						if (xoff >= 0)
-							continue;
-
-						code = -xoff;
-					}
-					dstPtr += dstInc * code;
-					w -= code;
-				} else if (code & 2) {
-					code = (code >> 2) + 1;
-					if (xoff > 0) {
-						xoff -= code;
-						++dataPtr;
-						if (xoff >= 0)
-							continue;
-
-						code = -xoff;
-						--dataPtr;
-					}
-					w -= code;
-					if (w < 0) {
-						code += w;
-					}
-					while (code--) {
-						write8BitColor<type>(dstPtr, dataPtr, dstType, palPtr, xmapPtr, bitDepth);
-						dstPtr += dstInc;
-					}
-					dataPtr++;
-				} else {
-					code = (code >> 2) + 1;
-					if (xoff > 0) {
-						xoff -= code;
-						dataPtr += code;
-						if (xoff >= 0)
-							continue;
-
-						code = -xoff;
-						dataPtr += xoff;
-					}
-					w -= code;
-					if (w < 0) {
-						code += w;
-					}
-					while (code--) {
-						write8BitColor<type>(dstPtr, dataPtr, dstType, palPtr, xmapPtr, bitDepth);
-						dataPtr++;
-						dstPtr += dstInc;
-					}
-				}
-			}
+		const uint8 *palPtr = (call.palette >= 0) ? &_recordedPalettes[call.palette] : NULL;
+		const uint8 *xmapPtr = NULL;
+		if (call.shadow) {
+			uint8 *shadowPtr = _vm->getResourceAddress(rtImage, call.shadow);
+			xmapPtr = shadowPtr ? _vm->findResourceData(MKTAG('X','M','A','P'), shadowPtr) : NULL;
+			if (!xmapPtr)
+				continue;
 		}
-		dataPtr = dataPtrNext;
-		dstPtr = dstPtrNext;
-	}
-}
-
-// NOTE: These templates are used outside this file. We don't want the compiler to optimize them away, so we need to explicitely instantiate them.
-template void Wiz::decompressWizImage<kWizXMap>(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
-template void Wiz::decompressWizImage<kWizRMap>(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
-template void Wiz::decompressWizImage<kWizCopy>(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
 
-template<int type>
-void Wiz::decompressRawWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, int srcPitch, int w, int h, int transColor, const uint8 *palPtr, uint8 bitDepth) {
-	if (type == kWizRMap) {
-		assert(palPtr != 0);
-	}
+		uint8 *dataPtr = _vm->getResourceAddress(rtImage, call.resNum);
+		if (!dataPtr)
+			continue;
+		uint8 *wizh = _vm->findWrappedBlock(MKTAG('W','I','Z','H'), dataPtr, call.state, 0);
+		if (!wizh)
+			continue;
+		const int comp = READ_LE_UINT32(wizh + 0x0);
+		const int width = READ_LE_UINT32(wizh + 0x4);
+		const int height = READ_LE_UINT32(wizh + 0x8);
 
-	if (w <= 0 || h <= 0) {
-		return;
-	}
-	while (h--) {
-		for (int i = 0; i < w; ++i) {
-			uint8 col = src[i];
-			if (transColor == -1 || transColor != col) {
-				if (type == kWizRMap) {
-					if (bitDepth == 2) {
-						writeColor(dst + i * 2, dstType, READ_LE_UINT16(palPtr + col * 2));
-					} else {
-						dst[i] = palPtr[col];
-					}
-				}
-				if (type == kWizCopy) {
-					if (bitDepth == 2) {
-						writeColor(dst + i * 2, dstType, col);
-					} else {
-						dst[i] = col;
-					}
-				}
-			}
+		if (!drawDecodedWizImage(dst, call.resNum, call.state, dataPtr, comp, dstPitch, kDstScreen, dstw, dsth, call.x1, call.y1, width, height,
+				&call.clip, call.flags, palPtr, xmapPtr, _vm->_bytesPerPixel)) {
+			drawWizImageEx(dst, dataPtr, NULL, dstPitch, kDstScreen, dstw, dsth, call.x1, call.y1, width, height, call.state, &call.clip,
+				call.flags, palPtr, call.transColor, _vm->_bytesPerPixel, xmapPtr, call.conditionBits);
 		}
-		src += srcPitch;
-		dst += dstPitch;
 	}
 }
 
@@ -1581,8 +993,38 @@ uint8 *Wiz::drawWizImage(int resNum, int state, int maskNum, int maskState, int
 		width = rScreen.width();
 		height = rScreen.height();
 	} else {
-		drawWizImageEx(dst, dataPtr, mask, dstPitch, dstType, cw, ch, x1, y1, width, height,
-			state, &rScreen, flags, palPtr, transColor, _vm->_bytesPerPixel, xmapPtr, conditionBits);
+		if (_recordDraws && dstType == kDstScreen && !maskNum && _recordedDraws.size() < kMaxRecordedDraws) {
+			WizDrawCall call;
+			call.resNum = resNum;
+			call.state = state;
+			call.x1 = x1;
+			call.y1 = y1;
+			call.shadow = shadow;
+			call.flags = flags;
+			call.transColor = transColor;
+			call.clip = rScreen;
+			call.palette = -1;
+			call.conditionBits = conditionBits;
+			if (palPtr) {
+				// The palette may be part of a resource which is expired
+				// before the draws are replayed, so it is copied. Draws
+				// mostly share the palette of the previous one.
+				const uint paletteSize = 256 * _vm->_bytesPerPixel;
+				const uint lastPalette = _recordedPalettes.size() - MIN<uint>(paletteSize, _recordedPalettes.size());
+				if (_recordedPalettes.size() < paletteSize || memcmp(&_recordedPalettes[lastPalette], palPtr, paletteSize)) {
+					_recordedPalettes.resize(_recordedPalettes.size() + paletteSize);
+					memcpy(&_recordedPalettes[_recordedPalettes.size() - paletteSize], palPtr, paletteSize);
+				}
+				call.palette = _recordedPalettes.size() - paletteSize;
+			}
+			_recordedDraws.push_back(call);
+		}
+
+		if (maskNum || !drawDecodedWizImage(dst, resNum, state, dataPtr, comp, dstPitch, dstType, cw, ch, x1, y1, width, height,
+				&rScreen, flags, palPtr, xmapPtr, _vm->_bytesPerPixel)) {
+			drawWizImageEx(dst, dataPtr, mask, dstPitch, dstType, cw, ch, x1, y1, width, height,
+				state, &rScreen, flags, palPtr, transColor, _vm->_bytesPerPixel, xmapPtr, conditionBits);
+		}
 	}
 
 	if (!(flags & kWIFBlitToMemBuffer) && dstResNum == 0) {
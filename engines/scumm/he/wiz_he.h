@@ -22,6 +22,8 @@
 #if !defined(SCUMM_HE_WIZ_HE_H) && defined(ENABLE_HE)
 #define SCUMM_HE_WIZ_HE_H
 
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "common/rect.h"
 
 namespace Scumm {
@@ -230,6 +232,49 @@ enum DstSurface {
  	kDstCursor   = 3
 };
 
+/**
+ * A compressed Wiz image decoded into the runs of its opaque pixels, which
+ * can be drawn again without parsing the RLE data.
+ */
+struct WizDecodedImage {
+	struct Span {
+		uint16 x;
+		uint16 width;
+		uint32 offset;  ///< Offset of the first pixel of the span in pixels
+	};
+
+	const uint8 *resource;  ///< Address of the resource the image was decoded from
+	uint8 bytesPerPixel;
+	int width;
+	int height;
+	uint32 lastUse;
+
+	Common::Array<uint32> rows;  ///< Index of the first span of every row, plus the end of the last row
+	Common::Array<Span> spans;
+	Common::Array<uint8> pixels;
+
+	uint32 getSize() const {
+		return sizeof(WizDecodedImage) + rows.size() * sizeof(uint32) + spans.size() * sizeof(Span) + pixels.size();
+	}
+};
+
+/**
+ * A call to Wiz::drawWizImage, recorded to replay the sprites of a scene with
+ * the 'wiz' debugger command.
+ */
+struct WizDrawCall {
+	int resNum;
+	int state;
+	int x1;
+	int y1;
+	int shadow;
+	int flags;
+	int transColor;
+	Common::Rect clip;
+	int palette;  ///< Offset of the palette in Wiz::_recordedPalettes, or -1 for none
+	uint32 conditionBits;
+};
+
 class ScummEngine_v71he;
 
 class Wiz {
@@ -239,11 +284,23 @@ public:
 		NUM_IMAGES   = 255
 	};
 
+	enum {
+		kMaxDecodedSize = 8 * 1024 * 1024,
+		kMaxRecordedDraws = 16384
+	};
+
+	struct CacheStats {
+		uint32 hits;     ///< Draws of images which were decoded already
+		uint32 misses;   ///< Images which had to be decoded
+		uint32 evicted;  ///< Images dropped to stay within kMaxDecodedSize
+	};
+
 	WizImage _images[NUM_IMAGES];
 	uint16 _imagesNum;
 	WizPolygon _polygons[NUM_POLYGONS];
 
 	Wiz(ScummEngine_v71he *vm);
+	~Wiz();
 
 	void clearWizBuffer();
 	Common::Rect _rectOverride;
@@ -280,6 +337,19 @@ public:
 
 	void flushWizBuffer();
 
+	bool _useDecodedImages;
+	CacheStats _cacheStats;
+	void clearDecodedImages();
+	uint getDecodedImageCount() const { return _decodedImages.size(); }
+	uint32 getDecodedImageSize() const { return _decodedSize; }
+	static bool decodeWizImage(WizDecodedImage &image, const uint8 *src, int width, int height, uint8 bytesPerPixel);
+
+	bool _recordDraws;
+	Common::Array<WizDrawCall> _recordedDraws;
+	Common::Array<uint8> _recordedPalettes;
+	void clearRecordedDraws();
+	void replayWizDraws(uint8 *dst, int dstPitch, int dstw, int dsth);
+
 	void getWizImageSpot(int resId, int state, int32 &x, int32 &y);
 	void getWizImageSpot(uint8 *data, int state, int32 &x, int32 &y);
 	void loadWizCursor(int resId, int palette);
@@ -293,6 +363,7 @@ public:
 
 	uint8 *drawWizImage(int resNum, int state, int maskNum, int maskState, int x1, int y1, int zorder, int shadow, int zbuffer, const Common::Rect *clipBox, int flags, int dstResNum, const uint8 *palPtr, uint32 conditionBits);
 	void drawWizImageEx(uint8 *dst, uint8 *src, uint8 *mask, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, int state, const Common::Rect *rect, int flags, const uint8 *palPtr, int transColor, uint8 bitDepth, const uint8 *xmapPtr, uint32 conditionBits);
+	bool drawDecodedWizImage(uint8 *dst, int resNum, int state, uint8 *dataPtr, int comp, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
 	void drawWizPolygon(int resNum, int state, int id, int flags, int shadow, int dstResNum, int palette);
 	void drawWizComplexPolygon(int resNum, int state, int po_x, int po_y, int shadow, int angle, int zoom, const Common::Rect *r, int flags, int dstResNum, int palette);
 	void drawWizPolygonTransform(int resNum, int state, Common::Point *wp, int flags, int shadow, int dstResNum, int palette);
@@ -313,17 +384,21 @@ public:
 	static void copyWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitdepth);
 	static void copyRawWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, const uint8 *palPtr, int transColor, uint8 bitdepth);
 #ifdef USE_RGB_COLOR
+	static void copyDecodedWizImage(uint8 *dst, const WizDecodedImage &image, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
 	static void copy16BitWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, const uint8 *xmapPtr);
 	static void copyRaw16BitWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, int transColor);
 	template<int type> static void decompress16BitWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *xmapPtr = NULL);
 #endif
 	template<int type> static void decompressWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitdepth);
 	template<int type> static void decompressRawWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, int srcPitch, int w, int h, int transColor, const uint8 *palPtr, uint8 bitdepth);
+	template<int type> static void copyDecodedWizImage(uint8 *dst, int dstPitch, int dstType, const WizDecodedImage &image, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
 
 #ifdef USE_RGB_COLOR
 	template<int type> static void write16BitColor(uint8 *dst, const uint8 *src, int dstType, const uint8 *xmapPtr);
+	template<int type> static void write16BitRun(uint8 *dst, const uint8 *src, int count, int dstInc, int dstType, const uint8 *xmapPtr);
 #endif
 	template<int type> static void write8BitColor(uint8 *dst, const uint8 *src, int dstType, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
+	template<int type> static void write8BitRun(uint8 *dst, const uint8 *src, int count, int dstInc, int dstType, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
 	static void writeColor(uint8 *dstPtr, int dstType, uint16 color);
 
 	uint16 getWizPixelColor(const uint8 *data, int x, int y, int w, int h, uint8 bitDepth, uint16 color);
@@ -333,6 +408,13 @@ public:
 
 private:
 	ScummEngine_v71he *_vm;
+
+	Common::HashMap<uint32, WizDecodedImage *> _decodedImages;
+	uint32 _decodedSize;
+	uint32 _decodedUseCounter;
+
+	const WizDecodedImage *getDecodedWizImage(int resNum, int state, uint8 *dataPtr, int comp, int width, int height);
+	void evictDecodedImages(uint32 size);
 };
 
 } // End of namespace Scumm
@@ -28,6 +28,14 @@
 #include "scumm/imuse_digi/dimuse_engine.h"
 #include "scumm/imuse_digi/dimuse_internalmixer.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define DIMUSE_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DIMUSE_NEON
+#endif
+
 namespace Scumm {
 
 IMuseDigiInternalMixer::IMuseDigiInternalMixer(Audio::Mixer *mixer) {
@@ -35,6 +43,7 @@ IMuseDigiInternalMixer::IMuseDigiInternalMixer(Audio::Mixer *mixer) {
 	_mixer = mixer;
 	_radioChatter = 0;
 	_amp8Table = nullptr;
+	_useSIMD = true;
 }
 
 IMuseDigiInternalMixer::~IMuseDigiInternalMixer() {
@@ -162,6 +171,10 @@ void IMuseDigiInternalMixer::clearRadioChatter() {
 	_radioChatter = 0;
 }
 
+void IMuseDigiInternalMixer::setUseSIMD(bool enable) {
+	_useSIMD = enable;
+}
+
 int IMuseDigiInternalMixer::clearMixerBuffer() {
 	if (!_mixBuf)
 		return -1;
@@ -196,6 +209,9 @@ void IMuseDigiInternalMixer::mix(uint8 *srcBuf, int32 inFrameCount, int wordSize
 					// Linear volume quantization from the lookup table
 					rightChannelVolume = _stereoVolumeTable[17 * channelVolume + channelPan];
 					leftChannelVolume = _stereoVolumeTable[17 * channelVolume - channelPan];
+					if (mixEqualRate(srcBuf, inFrameCount, wordSize, channelCount, feedSize, mixBufStartIndex, leftChannelVolume, rightChannelVolume))
+						return;
+
 					if (wordSize == 8) {
 						mixBits8ConvertToStereo(
 							srcBuf,
@@ -228,6 +244,9 @@ void IMuseDigiInternalMixer::mix(uint8 *srcBuf, int32 inFrameCount, int wordSize
 					if (channelVolume >= 17)
 						channelVolume = 16;
 
+					if (mixEqualRate(srcBuf, inFrameCount, wordSize, channelCount, feedSize, mixBufStartIndex, channelVolume, channelVolume))
+						return;
+
 					if (wordSize == 8)
 						ampTable = &_amp8Table[channelVolume * 128];
 					else
@@ -307,6 +326,268 @@ int IMuseDigiInternalMixer::loop(uint8 **destBuffer, int len) {
 	return 0;
 }
 
+#if defined(DIMUSE_SSE2) || defined(DIMUSE_NEON)
+
+// The amplitude tables hold trunc(factor * sample / 127) for 12-bit samples
+// centered around zero, where the factor is 0 for volume 0 and 8 * volume - 1
+// otherwise. The 8-bit table is the same one for samples scaled by 16, and
+// 16-bit samples index the 12-bit table shifted down by 4 bits. Hence all word
+// sizes are unpacked to centered 12-bit samples, whose amplitudes the kernels
+// below compute eight at a time instead of looking them up. Multiplying by the
+// factor and by 1/127 in single precision yields the same value as the tables
+// for every volume and sample.
+
+enum {
+	kMixChunkSize = 256
+};
+
+enum MixLayout {
+	kMixDirect,  // One mix buffer cell per sample
+	kMixDownmix, // One cell for the average of a stereo sample pair
+	kMixUpmix    // A left and a right cell per mono sample
+};
+
+static inline float getAmplitudeFactor(int volume) {
+	return volume ? (float)(8 * volume - 1) : 0.0f;
+}
+
+/**
+ * Unpacks count samples (an even number of them for 12-bit audio) from every
+ * step-th source sample and returns the number of bytes read.
+ */
+static int unpackSamples(int16 *dst, const uint8 *src, int wordSize, int step, int count) {
+	int i = 0;
+	if (wordSize == 8) {
+#if defined(DIMUSE_SSE2)
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i center = _mm_set1_epi16(128);
+		const __m128i lowBytes = _mm_set1_epi16(0xFF);
+		for (; i + 8 <= count; i += 8) {
+			__m128i samples;
+			if (step == 1)
+				samples = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(src + i)), zero);
+			else
+				samples = _mm_and_si128(_mm_loadu_si128((const __m128i *)(src + 2 * i)), lowBytes);
+			_mm_storeu_si128((__m128i *)(dst + i), _mm_slli_epi16(_mm_sub_epi16(samples, center), 4));
+		}
+#else
+		const int16x8_t center = vdupq_n_s16(128);
+		for (; i + 8 <= count; i += 8) {
+			const uint8x8_t bytes = step == 1 ? vld1_u8(src + i) : vld2_u8(src + 2 * i).val[0];
+			vst1q_s16(dst + i, vshlq_n_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(bytes)), center), 4));
+		}
+#endif
+		for (; i < count; i++)
+			dst[i] = (src[i * step] - 128) * 16;
+		return count * step;
+	} else if (wordSize == 12) {
+#if defined(DIMUSE_SSE2)
+		// Every 32-bit lane holds a triplet of bytes and the first byte of the
+		// next one, hence the last triplet of the source is never loaded here
+		const __m128i lowMask = _mm_set1_epi32(0xFFF);
+		const __m128i byteMask = _mm_set1_epi32(0xFF);
+		const __m128i nibbleMask = _mm_set1_epi32(0xF00);
+		const __m128i center = _mm_set1_epi16(2048);
+		for (; i + 10 <= count; i += 8, src += 12) {
+			const __m128i triplets = _mm_set_epi32(READ_LE_UINT32(src + 9), READ_LE_UINT32(src + 6), READ_LE_UINT32(src + 3), READ_LE_UINT32(src));
+			const __m128i first = _mm_and_si128(triplets, lowMask);
+			const __m128i second = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(triplets, 16), byteMask),
+			                                    _mm_and_si128(_mm_srli_epi32(triplets, 4), nibbleMask));
+			_mm_storeu_si128((__m128i *)(dst + i), _mm_sub_epi16(_mm_or_si128(first, _mm_slli_epi32(second, 16)), center));
+		}
+#else
+		const int16x8_t center = vdupq_n_s16(2048);
+		for (; i + 16 <= count; i += 16, src += 24) {
+			const uint8x8x3_t triplets = vld3_u8(src);
+			const uint16x8_t middle = vmovl_u8(triplets.val[1]);
+			const uint16x8_t first = vorrq_u16(vmovl_u8(triplets.val[0]), vshlq_n_u16(vandq_u16(middle, vdupq_n_u16(0xF)), 8));
+			const uint16x8_t second = vorrq_u16(vmovl_u8(triplets.val[2]), vshlq_n_u16(vandq_u16(middle, vdupq_n_u16(0xF0)), 4));
+			const int16x8x2_t samples = vzipq_s16(vsubq_s16(vreinterpretq_s16_u16(first), center), vsubq_s16(vreinterpretq_s16_u16(second), center));
+			vst1q_s16(dst + i, samples.val[0]);
+			vst1q_s16(dst + i + 8, samples.val[1]);
+		}
+#endif
+		for (; i < count; i += 2, src += 3) {
+			dst[i] = (src[0] | ((src[1] & 0xF) << 8)) - 2048;
+			dst[i + 1] = (src[2] | ((src[1] & 0xF0) << 4)) - 2048;
+		}
+		return count / 2 * 3;
+	} else {
+		const uint16 *src16 = (const uint16 *)src;
+#if defined(DIMUSE_SSE2)
+		for (; i + 8 <= count; i += 8)
+			_mm_storeu_si128((__m128i *)(dst + i), _mm_srai_epi16(_mm_loadu_si128((const __m128i *)(src16 + i)), 4));
+#else
+		for (; i + 8 <= count; i += 8)
+			vst1q_s16(dst + i, vshrq_n_s16(vreinterpretq_s16_u16(vld1q_u16(src16 + i)), 4));
+#endif
+		for (; i < count; i++)
+			dst[i] = (int16)src16[i] >> 4;
+		return count * 2;
+	}
+}
+
+#if defined(DIMUSE_SSE2)
+static inline __m128i computeAmplitudes(__m128i samples, __m128 factor) {
+	const __m128 scale = _mm_set1_ps(1.0f / 127.0f);
+	const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+	const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+	return _mm_packs_epi32(_mm_cvttps_epi32(_mm_mul_ps(_mm_mul_ps(_mm_cvtepi32_ps(lo), factor), scale)),
+	                       _mm_cvttps_epi32(_mm_mul_ps(_mm_mul_ps(_mm_cvtepi32_ps(hi), factor), scale)));
+}
+#else
+static inline int16x8_t computeAmplitudes(int16x8_t samples, float32x4_t factor) {
+	const float32x4_t scale = vdupq_n_f32(1.0f / 127.0f);
+	const float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(samples)));
+	const float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(samples)));
+	return vcombine_s16(vmovn_s32(vcvtq_s32_f32(vmulq_f32(vmulq_f32(lo, factor), scale))),
+	                    vmovn_s32(vcvtq_s32_f32(vmulq_f32(vmulq_f32(hi, factor), scale))));
+}
+#endif
+
+static void mixDirectRun(uint16 *dst, const int16 *samples, int count, const int16 *ampTable, float factor) {
+#if defined(DIMUSE_SSE2)
+	const __m128 f = _mm_set1_ps(factor);
+	for (; count >= 8; count -= 8, samples += 8, dst += 8) {
+		const __m128i amplitudes = computeAmplitudes(_mm_loadu_si128((const __m128i *)samples), f);
+		_mm_storeu_si128((__m128i *)dst, _mm_add_epi16(_mm_loadu_si128((const __m128i *)dst), amplitudes));
+	}
+#else
+	const float32x4_t f = vdupq_n_f32(factor);
+	for (; count >= 8; count -= 8, samples += 8, dst += 8) {
+		const int16x8_t amplitudes = computeAmplitudes(vld1q_s16(samples), f);
+		vst1q_u16(dst, vaddq_u16(vld1q_u16(dst), vreinterpretq_u16_s16(amplitudes)));
+	}
+#endif
+	for (; count > 0; --count)
+		*dst++ += ampTable[*samples++];
+}
+
+static void mixDownmixRun(uint16 *dst, const int16 *samples, int count, const int16 *ampTable, float factor) {
+#if defined(DIMUSE_SSE2)
+	const __m128 f = _mm_set1_ps(factor);
+	const __m128i ones = _mm_set1_epi16(1);
+	for (; count >= 8; count -= 8, samples += 16, dst += 8) {
+		const __m128i lo = _mm_madd_epi16(computeAmplitudes(_mm_loadu_si128((const __m128i *)samples), f), ones);
+		const __m128i hi = _mm_madd_epi16(computeAmplitudes(_mm_loadu_si128((const __m128i *)(samples + 8)), f), ones);
+		const __m128i averages = _mm_packs_epi32(_mm_srai_epi32(lo, 1), _mm_srai_epi32(hi, 1));
+		_mm_storeu_si128((__m128i *)dst, _mm_add_epi16(_mm_loadu_si128((const __m128i *)dst), averages));
+	}
+#else
+	const float32x4_t f = vdupq_n_f32(factor);
+	for (; count >= 8; count -= 8, samples += 16, dst += 8) {
+		const int32x4_t lo = vpaddlq_s16(computeAmplitudes(vld1q_s16(samples), f));
+		const int32x4_t hi = vpaddlq_s16(computeAmplitudes(vld1q_s16(samples + 8), f));
+		const int16x8_t averages = vcombine_s16(vshrn_n_s32(lo, 1), vshrn_n_s32(hi, 1));
+		vst1q_u16(dst, vaddq_u16(vld1q_u16(dst), vreinterpretq_u16_s16(averages)));
+	}
+#endif
+	for (; count > 0; --count, samples += 2)
+		*dst++ += (ampTable[samples[0]] + ampTable[samples[1]]) >> 1;
+}
+
+static void mixUpmixRun(uint16 *dst, const int16 *samples, int count, const int16 *leftAmpTable, const int16 *rightAmpTable, float leftFactor, float rightFactor) {
+#if defined(DIMUSE_SSE2)
+	const __m128 lf = _mm_set1_ps(leftFactor);
+	const __m128 rf = _mm_set1_ps(rightFactor);
+	for (; count >= 8; count -= 8, samples += 8, dst += 16) {
+		const __m128i s = _mm_loadu_si128((const __m128i *)samples);
+		const __m128i left = computeAmplitudes(s, lf);
+		const __m128i right = computeAmplitudes(s, rf);
+		_mm_storeu_si128((__m128i *)dst, _mm_add_epi16(_mm_loadu_si128((const __m128i *)dst), _mm_unpacklo_epi16(left, right)));
+		_mm_storeu_si128((__m128i *)(dst + 8), _mm_add_epi16(_mm_loadu_si128((const __m128i *)(dst + 8)), _mm_unpackhi_epi16(left, right)));
+	}
+#else
+	const float32x4_t lf = vdupq_n_f32(leftFactor);
+	const float32x4_t rf = vdupq_n_f32(rightFactor);
+	for (; count >= 8; count -= 8, samples += 8, dst += 16) {
+		const int16x8_t s = vld1q_s16(samples);
+		uint16x8x2_t cells = vld2q_u16(dst);
+		cells.val[0] = vaddq_u16(cells.val[0], vreinterpretq_u16_s16(computeAmplitudes(s, lf)));
+		cells.val[1] = vaddq_u16(cells.val[1], vreinterpretq_u16_s16(computeAmplitudes(s, rf)));
+		vst2q_u16(dst, cells);
+	}
+#endif
+	for (; count > 0; --count, dst += 2) {
+		dst[0] += leftAmpTable[*samples];
+		dst[1] += rightAmpTable[*samples++];
+	}
+}
+
+#endif
+
+bool IMuseDigiInternalMixer::mixEqualRate(uint8 *srcBuf, int32 inFrameCount, int wordSize, int channelCount, int feedSize, int32 mixBufStartIndex, int leftVolume, int rightVolume) {
+#if defined(DIMUSE_SSE2) || defined(DIMUSE_NEON)
+	uint16 *mixBufCurCell;
+	MixLayout layout = kMixDirect;
+	int step = 1;
+	int count;
+
+	if (!_useSIMD || feedSize != inFrameCount)
+		return false;
+
+	// Radio chatter and odd 12-bit frame counts are left to the table based loops
+	if (channelCount == 1 && _outChannelCount == 2) {
+		if (wordSize == 8 && _radioChatter)
+			return false;
+
+		layout = kMixUpmix;
+		if (wordSize == 12) {
+			mixBufCurCell = (uint16 *)(&_mixBuf[4 * mixBufStartIndex]);
+			count = (inFrameCount / 2) * 2;
+		} else {
+			mixBufCurCell = (uint16 *)(&_mixBuf[2 * mixBufStartIndex]);
+			count = feedSize;
+		}
+	} else if (_outChannelCount == 1) {
+		mixBufCurCell = (uint16 *)(&_mixBuf[2 * mixBufStartIndex]);
+		if (channelCount == 1) {
+			if ((wordSize == 8 && _radioChatter) || (wordSize == 12 && (inFrameCount & 1)))
+				return false;
+			count = feedSize;
+		} else if (wordSize == 8) {
+			// 8-bit stereo sounds are converted to mono by taking the left channel
+			step = 2;
+			count = feedSize;
+		} else {
+			layout = kMixDownmix;
+			count = 2 * feedSize;
+		}
+	} else {
+		mixBufCurCell = (uint16 *)(&_mixBuf[4 * mixBufStartIndex]);
+		count = 2 * feedSize;
+	}
+
+	const int16 *leftAmpTable = (const int16 *)&_amp12Table[leftVolume * 2048] + 2048;
+	const int16 *rightAmpTable = (const int16 *)&_amp12Table[rightVolume * 2048] + 2048;
+	const float leftFactor = getAmplitudeFactor(leftVolume);
+	const float rightFactor = getAmplitudeFactor(rightVolume);
+	const uint8 *srcBuf_ptr = srcBuf;
+	int16 samples[kMixChunkSize];
+
+	while (count > 0) {
+		const int length = MIN<int>(count, kMixChunkSize);
+		srcBuf_ptr += unpackSamples(samples, srcBuf_ptr, wordSize, step, length);
+
+		if (layout == kMixUpmix) {
+			mixUpmixRun(mixBufCurCell, samples, length, leftAmpTable, rightAmpTable, leftFactor, rightFactor);
+			mixBufCurCell += 2 * length;
+		} else if (layout == kMixDownmix) {
+			mixDownmixRun(mixBufCurCell, samples, length / 2, leftAmpTable, leftFactor);
+			mixBufCurCell += length / 2;
+		} else {
+			mixDirectRun(mixBufCurCell, samples, length, leftAmpTable, leftFactor);
+			mixBufCurCell += length;
+		}
+		count -= length;
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
+
 void IMuseDigiInternalMixer::mixBits8Mono(uint8 *srcBuf, int32 inFrameCount, int feedSize, int32 mixBufStartIndex, int32 *ampTable) {
 	uint16 *mixBufCurCell;
 	uint8 *srcBuf_ptr;
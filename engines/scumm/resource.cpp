@@ -49,9 +49,15 @@ enum {
 	RF_USAGE_MAX = RF_USAGE,
 
 	RS_MODIFIED = 0x10,
+	RS_EXPIRED = 0x20,
 	RF_OFFHEAP = 0x40
 };
 
+enum {
+	// The number of costumes and sounds prefetched when entering a room
+	kMaxRoomResources = 32
+};
+
 
 
 extern const char *nameOfResType(ResType type);
@@ -616,12 +622,41 @@ void ScummEngine::ensureResourceLoaded(ResType type, ResId idx) {
 	if (idx <= _res->_types[type].size() && _res->_types[type][idx]._address)
 		return;
 
+	if (idx < _res->_types[type].size()) {
+		ResourceManager::Resource &res = _res->_types[type][idx];
+		if (_prefetchingResources) {
+			_res->_stats.prefetches++;
+		} else {
+			_res->_stats.misses++;
+			if (res.isExpired())
+				_res->_stats.reloads++;
+			if (_prefetchResources && (type == rtCostume || type == rtSound))
+				_res->recordRoomResource(_roomResource, type, idx);
+		}
+	}
+
 	loadResource(type, idx);
 
 	if (_game.version == 5 && type == rtRoom && (int)idx == _roomResource)
 		VAR(VAR_ROOM_FLAG) = 1;
 }
 
+void ScummEngine::prefetchRoomResources() {
+	if (!_prefetchResources)
+		return;
+
+	const ResourceManager::RoomResourceList *list = _res->getRoomResources(_roomResource);
+	if (!list)
+		return;
+
+	_prefetchingResources = true;
+	for (uint i = 0; i < list->size() && _res->canPrefetch(); i++) {
+		const ResourceManager::RoomResource &res = (*list)[i];
+		ensureResourceLoaded(res.type, res.idx);
+	}
+	_prefetchingResources = false;
+}
+
 int ScummEngine::loadResource(ResType type, ResId idx) {
 	int roomNr;
 	uint32 fileOffs;
@@ -639,6 +674,9 @@ int ScummEngine::loadResource(ResType type, ResId idx) {
 	if (idx >= _res->_types[type].size())
 		error("%s %d undefined %d %d", nameOfResType(type), idx, _res->_types[type].size(), roomNr);
 
+	// Resources which are loaded again are no longer expired
+	_res->_types[type][idx].clearExpired();
+
 	if (roomNr == 0)
 		roomNr = _roomResource;
 
@@ -752,7 +790,8 @@ byte *ScummEngine::getResourceAddress(ResType type, ResId idx) {
 		return nullptr;
 
 	// If the resource is missing, but loadable from the game data files, try to do so.
-	if (!_res->_types[type][idx]._address && _res->_types[type]._mode != kDynamicResTypeMode) {
+	const bool loaded = _res->_types[type][idx]._address != nullptr;
+	if (!loaded && _res->_types[type]._mode != kDynamicResTypeMode) {
 		ensureResourceLoaded(type, idx);
 	}
 
@@ -763,6 +802,9 @@ byte *ScummEngine::getResourceAddress(ResType type, ResId idx) {
 	}
 
 	_res->setResourceCounter(type, idx, 1);
+	_res->_types[type][idx].markAccessed();
+	if (loaded)
+		_res->_stats.hits++;
 
 	debugC(DEBUG_RESOURCE, "getResourceAddress(%s,%d) == %p", nameOfResType(type), idx, (void *)ptr);
 	return ptr;
@@ -796,10 +838,12 @@ void ResourceManager::increaseResourceCounters() {
 	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
 		ResId idx = _types[type].size();
 		while (idx-- > 0) {
-			byte counter = _types[type][idx].getResourceCounter();
+			Resource &res = _types[type][idx];
+			byte counter = res.getResourceCounter();
 			if (counter && counter < RF_USAGE_MAX) {
 				setResourceCounter(type, idx, counter + 1);
 			}
+			res.ageAccesses();
 		}
 	}
 }
@@ -852,26 +896,13 @@ byte *ResourceManager::createResource(ResType type, ResId idx, uint32 size) {
 	return ptr;
 }
 
-ResourceManager::Resource::Resource() {
-	_address = nullptr;
-	_size = 0;
-	_flags = 0;
-	_status = 0;
-	_roomno = 0;
-	_roomoffs = 0;
-}
-
-ResourceManager::Resource::~Resource() {
-	delete[] _address;
-	_address = nullptr;
-}
-
 void ResourceManager::Resource::nuke() {
 	delete[] _address;
 	_address = nullptr;
 	_size = 0;
 	_flags = 0;
-	_status &= ~RS_MODIFIED;
+	_accesses = 0;
+	_status &= ~(RS_MODIFIED | RS_EXPIRED);
 }
 
 ResourceManager::ResTypeData::ResTypeData() {
@@ -887,6 +918,7 @@ ResourceManager::ResourceManager(ScummEngine *vm) : _vm(vm) {
 	_maxHeapThreshold = 0;
 	_minHeapThreshold = 0;
 	_expireCounter = 0;
+	resetStats();
 }
 
 ResourceManager::~ResourceManager() {
@@ -1047,10 +1079,22 @@ void ResourceManager::Resource::setOnHeap() {
 	_status &= ~RF_OFFHEAP;
 }
 
+void ResourceManager::Resource::setExpired() {
+	_status |= RS_EXPIRED;
+}
+
+void ResourceManager::Resource::clearExpired() {
+	_status &= ~RS_EXPIRED;
+}
+
+bool ResourceManager::Resource::isExpired() const {
+	return (_status & RS_EXPIRED) != 0;
+}
+
 void ResourceManager::expireResources(uint32 size) {
-	byte best_counter;
 	ResType best_type;
 	int best_res = 0;
+	uint64 best_score;
 	uint32 oldAllocatedSize;
 
 	if (_expireCounter != 0xFF) {
@@ -1065,7 +1109,7 @@ void ResourceManager::expireResources(uint32 size) {
 
 	do {
 		best_type = rtInvalid;
-		best_counter = 2;
+		best_score = 0;
 
 		for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
 			if (_types[type]._mode != kDynamicResTypeMode) {
@@ -1075,10 +1119,13 @@ void ResourceManager::expireResources(uint32 size) {
 				while (idx-- > 0) {
 					Resource &tmp = _types[type][idx];
 					byte counter = tmp.getResourceCounter();
-					if (!tmp.isLocked() && counter >= best_counter && tmp._address && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
-						best_counter = counter;
-						best_type = type;
-						best_res = idx;
+					if (!tmp.isLocked() && counter >= 2 && tmp._address && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
+						const uint64 score = getExpiryScore(counter, tmp._size, tmp.getAccesses());
+						if (score >= best_score) {
+							best_score = score;
+							best_type = type;
+							best_res = idx;
+						}
 					}
 				}
 			}
@@ -1086,7 +1133,10 @@ void ResourceManager::expireResources(uint32 size) {
 
 		if (!best_type)
 			break;
+		_stats.expired++;
+		_stats.expiredSize += _types[best_type][best_res]._size;
 		nukeResource(best_type, best_res);
+		_types[best_type][best_res].setExpired();
 	} while (size + _allocatedSize > _minHeapThreshold);
 
 	increaseResourceCounters();
@@ -1173,6 +1223,31 @@ void ResourceManager::resourceStats() {
 	debug(1, "Total allocated size=%d, locked=%d(%d)", _allocatedSize, lockedSize, lockedNum);
 }
 
+void ResourceManager::resetStats() {
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+void ResourceManager::recordRoomResource(int room, ResType type, ResId idx) {
+	RoomResourceList &list = _roomResources[room];
+	if (list.size() >= kMaxRoomResources)
+		return;
+
+	for (uint i = 0; i < list.size(); i++) {
+		if (list[i].type == type && list[i].idx == idx)
+			return;
+	}
+
+	RoomResource res;
+	res.type = type;
+	res.idx = idx;
+	list.push_back(res);
+}
+
+const ResourceManager::RoomResourceList *ResourceManager::getRoomResources(int room) const {
+	Common::HashMap<int, RoomResourceList>::const_iterator it = _roomResources.find(room);
+	return it != _roomResources.end() ? &it->_value : nullptr;
+}
+
 void ScummEngine_v5::readMAXS(int blockSize) {
 	_numVariables = _fileHandle->readUint16LE();      // 800
 	_fileHandle->readUint16LE();                      // 16
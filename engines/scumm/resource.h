@@ -23,6 +23,7 @@
 #define SCUMM_RESOURCE_H
 
 #include "common/array.h"
+#include "common/hashmap.h"
 #include "scumm/scumm.h"	// for ResType
 
 namespace Scumm {
@@ -104,11 +105,18 @@ public:
 		byte _flags;
 
 		/**
-		 * The status of the resource. Currently only one bit is used, which
-		 * indicates whether the resource is modified.
+		 * The status of the resource. It indicates whether the resource is
+		 * modified, stored off heap, or was expired to free memory.
 		 */
 		byte _status;
 
+		/**
+		 * How often the resource was accessed recently. The count is halved
+		 * whenever the resource counters are increased, so old accesses
+		 * weigh less than recent ones.
+		 */
+		uint16 _accesses;
+
 	public:
 		/**
 		 * The id of the room (resp. the disk) the resource is contained in.
@@ -126,14 +134,24 @@ public:
 		uint32 _roomoffs;
 
 	public:
-		Resource();
-		~Resource();
+		Resource() : _address(nullptr), _size(0), _flags(0), _status(0), _accesses(0), _roomno(0), _roomoffs(0) {}
+		~Resource() {
+			delete[] _address;
+			_address = nullptr;
+		}
 
 		void nuke();
 
 		inline void setResourceCounter(byte counter);
 		inline byte getResourceCounter() const;
 
+		void markAccessed() {
+			if (_accesses < 0xFFFF)
+				_accesses++;
+		}
+		void ageAccesses() { _accesses /= 2; }
+		uint16 getAccesses() const { return _accesses; }
+
 		void lock();
 		void unlock();
 		bool isLocked() const;
@@ -144,6 +162,10 @@ public:
 		void setOffHeap();
 		void setOnHeap();
 		bool isOffHeap() const;
+
+		void setExpired();
+		void clearExpired();
+		bool isExpired() const;
 	};
 
 	/**
@@ -170,11 +192,38 @@ public:
 	};
 	ResTypeData _types[rtLast + 1];
 
+	/**
+	 * Statistics about the loading and expiring of resources, printed by the
+	 * 'resources' debugger command.
+	 */
+	struct Stats {
+		uint32 hits;        ///< Accesses to resources which were loaded
+		uint32 misses;      ///< Resources which had to be loaded when accessed
+		uint32 reloads;     ///< Misses of resources which had been expired before
+		uint32 prefetches;  ///< Resources loaded when entering a room
+		uint32 expired;     ///< Resources expired to free memory
+		uint32 expiredSize; ///< Memory freed by expiring resources
+	};
+	Stats _stats;
+
+	/**
+	 * A resource loaded when accessed during a visit of a room, which is
+	 * loaded ahead the next time the room is entered.
+	 */
+	struct RoomResource {
+		ResType type;
+		ResId idx;
+	};
+	typedef Common::Array<RoomResource> RoomResourceList;
+
 protected:
 	uint32 _allocatedSize;
 	uint32 _maxHeapThreshold, _minHeapThreshold;
 	byte _expireCounter;
 
+	/** The resources to prefetch for every room, see recordRoomResource */
+	Common::HashMap<int, RoomResourceList> _roomResources;
+
 public:
 	ResourceManager(ScummEngine *vm);
 	~ResourceManager();
@@ -215,14 +264,45 @@ public:
 	void setResourceCounter(ResType type, ResId idx, byte counter);
 
 	/**
-	 * Increment the counter of all unlocked loaded resources.
-	 * The maximal count is 255.
+	 * Increment the counter of all unlocked loaded resources, and age their
+	 * access counts.
+	 * The maximal count is 127.
 	 * This is called by increaseExpireCounter and expireResources,
 	 * but also by ScummEngine::startScene.
 	 */
 	void increaseResourceCounters();
 
 	void resourceStats();
+	void resetStats();
+
+	/**
+	 * How much a resource should be expired rather than others. Resources
+	 * which weren't used for a long time, are rarely used and free a lot of
+	 * memory score highest.
+	 */
+	static uint64 getExpiryScore(byte counter, uint32 size, uint16 accesses) {
+		return (uint64)counter * ((uint64)size + 1) / (accesses + 1);
+	}
+
+	/**
+	 * Remember that a costume or sound had to be loaded while in the given
+	 * room, so it can be prefetched when entering the room again.
+	 */
+	void recordRoomResource(int room, ResType type, ResId idx);
+
+	/**
+	 * Return the resources to prefetch when entering the given room.
+	 */
+	const RoomResourceList *getRoomResources(int room) const;
+
+	/**
+	 * Whether there is room on the heap for loading resources ahead,
+	 * without having to expire others.
+	 */
+	bool canPrefetch() const { return _allocatedSize < _minHeapThreshold; }
+
+	uint32 getAllocatedSize() const { return _allocatedSize; }
+	uint32 getHeapThreshold() const { return _maxHeapThreshold; }
 
 //protected:
 	bool validateResource(const char *str, ResType type, ResId idx) const;
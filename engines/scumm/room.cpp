@@ -145,6 +145,10 @@ void ScummEngine::startScene(int room, Actor *a, int objectNr) {
 
 	resetRoomObjects();
 
+	// Load the costumes and sounds which were needed during previous visits
+	// of the room, before its scripts ask for them, if enabled
+	prefetchRoomResources();
+
 	if (VAR_ROOM_WIDTH != 0xFF && VAR_ROOM_HEIGHT != 0xFF) {
 		VAR(VAR_ROOM_WIDTH) = _roomWidth;
 		VAR(VAR_ROOM_HEIGHT) = _roomHeight;
@@ -440,19 +440,10 @@ void ScummEngine::resetScriptPointer() {
 	_scriptPointer = _scriptOrgPointer + vm.slot[_currentScript].offs;
 }
 
-/**
- * This method checks whether the resource that contains the active script
- * moved, and if so, updates the script pointer accordingly.
- *
- * The script resource may have moved because it might have been garbage
- * collected by ResourceManager::expireResources.
- */
-void ScummEngine::refreshScriptPointer() {
-	if (*_lastCodePtr != _scriptOrgPointer) {
-		long oldoffs = _scriptPointer - _scriptOrgPointer;
-		getScriptBaseAddress();
-		_scriptPointer = _scriptOrgPointer + oldoffs;
-	}
+void ScummEngine::relocateScriptPointer() {
+	long oldoffs = _scriptPointer - _scriptOrgPointer;
+	getScriptBaseAddress();
+	_scriptPointer = _scriptOrgPointer + oldoffs;
 }
 
 /** Execute a script - Read opcode, and execute it from the table */
@@ -488,8 +479,11 @@ void ScummEngine::executeScript() {
 }
 
 void ScummEngine::executeOpcode(byte i) {
-	if (_opcodes[i].proc && _opcodes[i].proc->isValid())
-		(*_opcodes[i].proc)();
+	if (_profileOpcodes)
+		_opcodeCounts[i]++;
+
+	if (_opcodes[i].proc)
+		(this->*_opcodes[i].proc)();
 	else {
 		error("Invalid opcode '%x' at %lx", i, (long)(_scriptPointer - _scriptOrgPointer));
 	}
@@ -503,11 +497,6 @@ const char *ScummEngine::getOpcodeDesc(byte i) {
 #endif
 }
 
-byte ScummEngine::fetchScriptByte() {
-	refreshScriptPointer();
-	return *_scriptPointer++;
-}
-
 uint ScummEngine::fetchScriptWord() {
 	refreshScriptPointer();
 	uint a = READ_LE_UINT16(_scriptPointer);
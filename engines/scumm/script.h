@@ -26,28 +26,29 @@
 
 namespace Scumm {
 
-typedef Common::Functor0<void> Opcode;
+class ScummEngine;
+
+/**
+ * An opcode handler. The handlers of the engine subclasses are stored as
+ * handlers of ScummEngine, so they are called directly, without going
+ * through a functor.
+ */
+typedef void (ScummEngine::*Opcode)();
 
 struct OpcodeEntry : Common::NonCopyable {
-	Opcode *proc;
+	Opcode proc;
 #ifndef REDUCE_MEMORY_USAGE
 	const char *desc;
 #endif
 
 #ifndef REDUCE_MEMORY_USAGE
-	OpcodeEntry() : proc(0), desc(0) {}
+	OpcodeEntry() : proc(nullptr), desc(nullptr) {}
 #else
-	OpcodeEntry() : proc(0) {}
+	OpcodeEntry() : proc(nullptr) {}
 #endif
-	~OpcodeEntry() {
-		setProc(0, 0);
-	}
 
-	void setProc(Opcode *p, const char *d) {
-		if (proc != p) {
-			delete proc;
-			proc = p;
-		}
+	void setProc(Opcode p, const char *d) {
+		proc = p;
 #ifndef REDUCE_MEMORY_USAGE
 		desc = d;
 #endif
@@ -58,9 +59,9 @@ struct OpcodeEntry : Common::NonCopyable {
 // This is to help devices with small memory (PDA, smartphones, ...)
 // to save abit of memory used by opcode names in the Scumm engine.
 #ifndef REDUCE_MEMORY_USAGE
-#	define _OPCODE(ver, x)	setProc(new Common::Functor0Mem<void, ver>(this, &ver::x), #x)
+#	define _OPCODE(ver, x)	setProc(static_cast<Opcode>(&ver::x), #x)
 #else
-#	define _OPCODE(ver, x)	setProc(new Common::Functor0Mem<void, ver>(this, &ver::x), "")
+#	define _OPCODE(ver, x)	setProc(static_cast<Opcode>(&ver::x), "")
 #endif
 
 /**
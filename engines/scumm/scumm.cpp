@@ -576,6 +576,12 @@ ScummEngine::ScummEngine(OSystem *syst, const DetectorResult &dr)
 
 	_hexdumpScripts = false;
 	_showStack = false;
+	_profileOpcodes = false;
+	_prefetchResources = false;
+	_prefetchingResources = false;
+	memset(_opcodeCounts, 0, sizeof(_opcodeCounts));
+	_showFrameStats = false;
+	memset(&_frameStats, 0, sizeof(_frameStats));
 
 	if (_game.platform == Common::kPlatformFMTowns && _game.version == 3) {	// FM-TOWNS V3 games originally use 320x240, and we have an option to trim to 200
 		_screenWidth = 320;
@@ -1629,7 +1635,20 @@ void ScummEngine::setupScumm(const Common::String &macResourceFile) {
 		maxHeapThreshold = 550000;
 	}
 
-	_res->setHeapThreshold(400000, maxHeapThreshold);
+	// The budget (in KB) can be raised on systems with plenty of memory, so
+	// fewer resources have to be reloaded from the data files. Expiring
+	// resources then only frees a quarter of it, so the resources used
+	// frequently stay in memory.
+	if (ConfMan.hasKey("resource_budget") && ConfMan.getInt("resource_budget") > 0) {
+		maxHeapThreshold = ConfMan.getInt("resource_budget") * 1024;
+		_res->setHeapThreshold(maxHeapThreshold * 3 / 4, maxHeapThreshold);
+	} else {
+		_res->setHeapThreshold(400000, maxHeapThreshold);
+	}
+
+	// Prefetching may load resources from another disk than the one of the
+	// room, which prompts for a disk change in multi-disk releases
+	_prefetchResources = ConfMan.hasKey("prefetch_resources") && ConfMan.getBool("prefetch_resources");
 
 	free(_compositeBuf);
 	_compositeBuf = (byte *)malloc(_screenWidth * _textSurfaceMultiplier * _screenHeight * _textSurfaceMultiplier * _outputPixelFormat.bytesPerPixel);
@@ -505,6 +505,18 @@ protected:
 	bool _showStack;
 	bool _debugMode;
 
+	/** Whether to count how often every opcode is executed, see the 'opcodes' debugger command */
+	bool _profileOpcodes;
+	uint32 _opcodeCounts[256];
+
+	/** Screen updates of the current frame, shown on screen by 'show frame' */
+	struct FrameStats {
+		uint32 pixels;      ///< Pixels copied to the screen
+		uint32 rects;       ///< Number of copyRectToScreen calls
+	};
+	bool _showFrameStats;
+	FrameStats _frameStats;
+
 	// Save/Load class - some of this may be GUI
 	byte _saveLoadFlag, _saveLoadSlot;
 	uint32 _lastSaveTime;
@@ -607,8 +619,22 @@ protected:
 	void resetScriptPointer();
 	int getVerbEntrypoint(int obj, int entry);
 
-	void refreshScriptPointer();
-	byte fetchScriptByte();
+	/**
+	 * Check whether the resource that contains the active script moved, and
+	 * if so, update the script pointer accordingly.
+	 *
+	 * The script resource may have moved because it might have been garbage
+	 * collected by ResourceManager::expireResources.
+	 */
+	void refreshScriptPointer() {
+		if (*_lastCodePtr != _scriptOrgPointer)
+			relocateScriptPointer();
+	}
+	void relocateScriptPointer();
+	byte fetchScriptByte() {
+		refreshScriptPointer();
+		return *_scriptPointer++;
+	}
 	virtual uint fetchScriptWord();
 	virtual int fetchScriptWordSigned();
 	uint fetchScriptDWord();
@@ -663,6 +689,8 @@ protected:
 //	void allocResTypeData(ResType type, uint32 tag, int num, int mode);
 //	byte *createResource(int type, int index, uint32 size);
 	int loadResource(ResType type, ResId idx);
+	/** Load the resources recorded for the current room, see ResourceManager::recordRoomResource */
+	void prefetchRoomResources();
 //	void nukeResource(ResType type, ResId idx);
 	int getResourceRoomNr(ResType type, ResId idx);
 	virtual uint32 getResourceRoomOffset(ResType type, ResId idx);
@@ -675,6 +703,9 @@ public:
 	void ensureResourceLoaded(ResType type, ResId idx);
 
 protected:
+	bool _prefetchResources;
+	bool _prefetchingResources;
+
 	Common::Mutex _resourceAccessMutex; // Used in getResourceSize(), getResourceAddress() and findResource()
 										// to avoid race conditions between the audio thread of Digital iMUSE
 										// and the main SCUMM thread
@@ -973,6 +1004,9 @@ protected:
 
 	void ditherCGA(byte *dst, int dstPitch, int x, int y, int width, int height) const;
 
+	Common::Rect _frameStatsRect;
+	void drawFrameStats();
+
 public:
 	VirtScreen *findVirtScreen(int y);
 	byte *getMaskBuffer(int x, int y, int z);
@@ -1016,8 +1016,9 @@ bool Debugger::cmdListMarks(int argc, const char **argv) {
 	Common::ConfigManager::Domain::const_iterator dit;
 	Common::StringArray marks;
 	for (dit = domain->begin(); dit != domain->end(); ++dit) {
-		if (dit->_key.hasPrefix("mark_")) {
-			marks.push_back(dit->_key.substr(5));
+		const Common::String &key = dit->_key;
+		if (key.hasPrefix("mark_")) {
+			marks.push_back(key.substr(5));
 		}
 	}
 
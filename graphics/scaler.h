@@ -53,4 +53,13 @@ extern bool createThumbnailFromScreen(Graphics::Surface *surf);
  */
 extern bool createThumbnail(Graphics::Surface *surf, const uint8 *pixels, int w, int h, const uint8 *palette);
 
+/**
+ * Creates a thumbnail from a surface.
+ *
+ * @param surf      destination surface (will always have 16 bpp after this for now)
+ * @param in        the surface to create the thumbnail from (8, 16 or 32 bpp)
+ * @param palette   palette in RGB format, only used for 8 bpp surfaces
+ */
+extern bool createThumbnail(Graphics::Surface *surf, const Graphics::Surface &in, const uint8 *palette);
+
 #endif
@@ -28,62 +28,142 @@
 #include "graphics/scaler/intern.h"
 #include "graphics/palette.h"
 
-template<typename ColorMask>
-uint16 quadBlockInterpolate(const uint8 *src, uint32 srcPitch) {
-	uint16 colorx1y1 = *(((const uint16 *)src));
-	uint16 colorx2y1 = *(((const uint16 *)src) + 1);
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define THUMBNAIL_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define THUMBNAIL_NEON
+#endif
+
+#if defined(THUMBNAIL_SSE2)
+/**
+ * Sums the channels of the two RGB565 pixels in every 32 bit lane.
+ */
+static inline void sumPixelPairs565(__m128i pixels, __m128i &r, __m128i &g, __m128i &b) {
+	const __m128i mask5 = _mm_set1_epi32(0x1F);
+	const __m128i mask6 = _mm_set1_epi32(0x3F);
+
+	r = _mm_add_epi32(r, _mm_add_epi32(_mm_and_si128(_mm_srli_epi32(pixels, 11), mask5), _mm_srli_epi32(pixels, 27)));
+	g = _mm_add_epi32(g, _mm_add_epi32(_mm_and_si128(_mm_srli_epi32(pixels, 5), mask6), _mm_and_si128(_mm_srli_epi32(pixels, 21), mask6)));
+	b = _mm_add_epi32(b, _mm_add_epi32(_mm_and_si128(pixels, mask5), _mm_and_si128(_mm_srli_epi32(pixels, 16), mask5)));
+}
+
+/**
+ * Averages the 2x2 blocks of 8 RGB565 pixels from two lines, resulting in
+ * 4 pixels in 32 bit lanes.
+ */
+static inline __m128i halveBlocks565(const uint16 *top, const uint16 *bottom) {
+	__m128i r = _mm_setzero_si128(), g = _mm_setzero_si128(), b = _mm_setzero_si128();
+	sumPixelPairs565(_mm_loadu_si128((const __m128i *)top), r, g, b);
+	sumPixelPairs565(_mm_loadu_si128((const __m128i *)bottom), r, g, b);
+
+	const __m128i color = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(_mm_srli_epi32(r, 2), 11),
+	                                                 _mm_slli_epi32(_mm_srli_epi32(g, 2), 5)),
+	                                   _mm_srli_epi32(b, 2));
+	// Sign extend, so packing the lanes with saturation keeps all the bits
+	return _mm_srai_epi32(_mm_slli_epi32(color, 16), 16);
+}
+#elif defined(THUMBNAIL_NEON)
+static inline void sumPixelPairs565(uint32x4_t pixels, uint32x4_t &r, uint32x4_t &g, uint32x4_t &b) {
+	const uint32x4_t mask5 = vdupq_n_u32(0x1F);
+	const uint32x4_t mask6 = vdupq_n_u32(0x3F);
+
+	r = vaddq_u32(r, vaddq_u32(vandq_u32(vshrq_n_u32(pixels, 11), mask5), vshrq_n_u32(pixels, 27)));
+	g = vaddq_u32(g, vaddq_u32(vandq_u32(vshrq_n_u32(pixels, 5), mask6), vandq_u32(vshrq_n_u32(pixels, 21), mask6)));
+	b = vaddq_u32(b, vaddq_u32(vandq_u32(pixels, mask5), vandq_u32(vshrq_n_u32(pixels, 16), mask5)));
+}
 
-	uint16 colorx1y2 = *(((const uint16 *)(src + srcPitch)));
-	uint16 colorx2y2 = *(((const uint16 *)(src + srcPitch)) + 1);
+static inline uint16x4_t halveBlocks565(const uint16 *top, const uint16 *bottom) {
+	uint32x4_t r = vdupq_n_u32(0), g = vdupq_n_u32(0), b = vdupq_n_u32(0);
+	sumPixelPairs565(vreinterpretq_u32_u16(vld1q_u16(top)), r, g, b);
+	sumPixelPairs565(vreinterpretq_u32_u16(vld1q_u16(bottom)), r, g, b);
 
-	return interpolate16_1_1_1_1<ColorMask>(colorx1y1, colorx2y1, colorx1y2, colorx2y2);
+	const uint32x4_t color = vorrq_u32(vorrq_u32(vshlq_n_u32(vshrq_n_u32(r, 2), 11),
+	                                             vshlq_n_u32(vshrq_n_u32(g, 2), 5)),
+	                                   vshrq_n_u32(b, 2));
+	return vmovn_u32(color);
 }
+#endif
+
+/**
+ * Halves an RGB565 image in both directions, averaging blocks of 2x2 pixels.
+ * The destination may be the source itself.
+ */
+static void halveThumbnail(const uint8 *src, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
+	typedef Graphics::ColorMasks<565> ColorMask;
 
-template<typename ColorMask>
-void createThumbnail_2(const uint8 *src, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
 	// Make sure the width and height is a multiple of 2.
 	width &= ~1;
 	height &= ~1;
 
 	for (int y = 0; y < height; y += 2) {
-		for (int x = 0; x < width; x += 2, dstPtr += 2) {
-			*((uint16 *)dstPtr) = quadBlockInterpolate<ColorMask>(src + 2 * x, srcPitch);
-		}
-		dstPtr += (dstPitch - 2 * width / 2);
+		const uint16 *top = (const uint16 *)src;
+		const uint16 *bottom = (const uint16 *)(src + srcPitch);
+		uint16 *dst = (uint16 *)dstPtr;
+
+		int x = 0;
+#if defined(THUMBNAIL_SSE2)
+		for (; x + 16 <= width; x += 16)
+			_mm_storeu_si128((__m128i *)(dst + x / 2), _mm_packs_epi32(halveBlocks565(top + x, bottom + x), halveBlocks565(top + x + 8, bottom + x + 8)));
+#elif defined(THUMBNAIL_NEON)
+		for (; x + 16 <= width; x += 16)
+			vst1q_u16(dst + x / 2, vcombine_u16(halveBlocks565(top + x, bottom + x), halveBlocks565(top + x + 8, bottom + x + 8)));
+#endif
+		for (; x < width; x += 2)
+			dst[x / 2] = interpolate16_1_1_1_1<ColorMask>(top[x], top[x + 1], bottom[x], bottom[x + 1]);
+
+		dstPtr += dstPitch;
 		src += 2 * srcPitch;
 	}
 }
 
-template<typename ColorMask>
-void createThumbnail_4(const uint8 *src, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
-	// Make sure the width and height is a multiple of 4
-	width &= ~3;
-	height &= ~3;
-
-	for (int y = 0; y < height; y += 4) {
-		for (int x = 0; x < width; x += 4, dstPtr += 2) {
-			uint16 upleft = quadBlockInterpolate<ColorMask>(src + 2 * x, srcPitch);
-			uint16 upright = quadBlockInterpolate<ColorMask>(src + 2 * (x + 2), srcPitch);
-			uint16 downleft = quadBlockInterpolate<ColorMask>(src + srcPitch * 2 + 2 * x, srcPitch);
-			uint16 downright = quadBlockInterpolate<ColorMask>(src + srcPitch * 2 + 2 * (x + 2), srcPitch);
+/**
+ * Scales an RGB565 image with a box filter: every destination pixel is the
+ * average of the source pixels it covers, weighted by the covered area.
+ */
+static void boxScaleThumbnail(const Graphics::Surface &in, byte *dstPtr, uint32 dstPitch, int dstWidth, int dstHeight) {
+	// A source pixel is dstWidth x dstHeight units large, a destination pixel
+	// in.w x in.h units
+	const uint32 area = in.w * in.h;
+
+	for (int y = 0; y < dstHeight; ++y) {
+		const int top = y * in.h;
+		const int bottom = top + in.h;
+		uint16 *dst = (uint16 *)dstPtr;
+
+		for (int x = 0; x < dstWidth; ++x) {
+			const int left = x * in.w;
+			const int right = left + in.w;
+			uint32 r = 0, g = 0, b = 0;
+
+			for (int srcY = top / dstHeight; srcY * dstHeight < bottom; ++srcY) {
+				const uint32 coverY = MIN(bottom, (srcY + 1) * dstHeight) - MAX(top, srcY * dstHeight);
+				const uint16 *src = (const uint16 *)in.getBasePtr(0, srcY);
+
+				for (int srcX = left / dstWidth; srcX * dstWidth < right; ++srcX) {
+					const uint32 cover = coverY * (MIN(right, (srcX + 1) * dstWidth) - MAX(left, srcX * dstWidth));
+					const uint16 color = src[srcX];
+					r += (color >> 11) * cover;
+					g += ((color >> 5) & 0x3F) * cover;
+					b += (color & 0x1F) * cover;
+				}
+			}
 
-			*((uint16 *)dstPtr) = interpolate16_1_1_1_1<ColorMask>(upleft, upright, downleft, downright);
+			r = (r + area / 2) / area;
+			g = (g + area / 2) / area;
+			b = (b + area / 2) / area;
+			dst[x] = (r << 11) | (g << 5) | b;
 		}
-		dstPtr += (dstPitch - 2 * width / 4);
-		src += 4 * srcPitch;
+
+		dstPtr += dstPitch;
 	}
 }
 
-template<typename ColorMask>
 static void scaleThumbnail(Graphics::Surface &in, Graphics::Surface &out) {
-	while (in.w / out.w >= 4 || in.h / out.h >= 4) {
-		createThumbnail_4<ColorMask>((const uint8 *)in.getPixels(), in.pitch, (uint8 *)in.getPixels(), in.pitch, in.w, in.h);
-		in.w /= 4;
-		in.h /= 4;
-	}
-
+	// Halving twice is the same as averaging blocks of 4x4 pixels
 	while (in.w / out.w >= 2 || in.h / out.h >= 2) {
-		createThumbnail_2<ColorMask>((const uint8 *)in.getPixels(), in.pitch, (uint8 *)in.getPixels(), in.pitch, in.w, in.h);
+		halveThumbnail((const uint8 *)in.getPixels(), in.pitch, (uint8 *)in.getPixels(), in.pitch, in.w, in.h);
 		in.w /= 2;
 		in.h /= 2;
 	}
@@ -117,49 +197,48 @@ static void scaleThumbnail(Graphics::Surface &in, Graphics::Surface &out) {
 
 		// Center the image on the output surface
 		byte *dst = (byte *)out.getBasePtr((out.w - targetWidth) / 2, (out.h - targetHeight) / 2);
-		const uint dstLineIncrease = out.pitch - targetWidth * out.format.bytesPerPixel;
-
-		const float scaleFactorX = (float)targetWidth / in.w;
-		const float scaleFactorY = (float)targetHeight / in.h;
-
-		for (int y = 0; y < targetHeight; ++y) {
-			const float yFrac = (y / scaleFactorY);
-			const int y1 = (int)yFrac;
-			const int y2 = (y1 + 1 < in.h) ? (y1 + 1) : (in.h - 1);
-
-			for (int x = 0; x < targetWidth; ++x) {
-				const float xFrac = (x / scaleFactorX);
-				const int x1 = (int)xFrac;
-				const int x2 = (x1 + 1 < in.w) ? (x1 + 1) : (in.w - 1);
-
-				// Look up colors at the points
-				uint8 p1R, p1G, p1B;
-				in.format.colorToRGBT<ColorMask>(READ_UINT16(in.getBasePtr(x1, y1)), p1R, p1G, p1B);
-				uint8 p2R, p2G, p2B;
-				in.format.colorToRGBT<ColorMask>(READ_UINT16(in.getBasePtr(x2, y1)), p2R, p2G, p2B);
-				uint8 p3R, p3G, p3B;
-				in.format.colorToRGBT<ColorMask>(READ_UINT16(in.getBasePtr(x1, y2)), p3R, p3G, p3B);
-				uint8 p4R, p4G, p4B;
-				in.format.colorToRGBT<ColorMask>(READ_UINT16(in.getBasePtr(x2, y2)), p4R, p4G, p4B);
-
-				const float xDiff = xFrac - x1;
-				const float yDiff = yFrac - y1;
-
-				uint8 pR = (uint8)((1 - yDiff) * ((1 - xDiff) * p1R + xDiff * p2R) + yDiff * ((1 - xDiff) * p3R + xDiff * p4R));
-				uint8 pG = (uint8)((1 - yDiff) * ((1 - xDiff) * p1G + xDiff * p2G) + yDiff * ((1 - xDiff) * p3G + xDiff * p4G));
-				uint8 pB = (uint8)((1 - yDiff) * ((1 - xDiff) * p1B + xDiff * p2B) + yDiff * ((1 - xDiff) * p3B + xDiff * p4B));
-
-				WRITE_UINT16(dst, out.format.RGBToColorT<ColorMask>(pR, pG, pB));
-				dst += 2;
-			}
+		boxScaleThumbnail(in, dst, out.pitch, targetWidth, targetHeight);
+	}
+}
+
+/**
+ * Converts a surface to RGB565, looking up the colors of 8 bpp surfaces in
+ * the palette.
+ * WARNING: out.free() must be called by the user to avoid leaking.
+ */
+static void convertTo565(const Graphics::Surface &in, const byte *palette, Graphics::Surface &out) {
+	assert(in.format.bytesPerPixel == 1 || in.format.bytesPerPixel == 2
+	       || in.format.bytesPerPixel == 4);
+	assert(in.getPixels() != 0);
+
+	out.create(in.w, in.h, Graphics::createPixelFormat<565>());
 
-			// Move to the next line
-			dst = (byte *)dst + dstLineIncrease;
+	uint16 colors[256];
+	if (in.format.bytesPerPixel == 1) {
+		for (int i = 0; i < 256; ++i)
+			colors[i] = out.format.RGBToColor(palette[i * 3 + 0], palette[i * 3 + 1], palette[i * 3 + 2]);
+	}
+
+	for (int y = 0; y < in.h; ++y) {
+		const byte *src = (const byte *)in.getBasePtr(0, y);
+		uint16 *dst = (uint16 *)out.getBasePtr(0, y);
+
+		if (in.format == out.format) {
+			memcpy(dst, src, in.w * 2);
+		} else if (in.format.bytesPerPixel == 1) {
+			for (int x = 0; x < in.w; ++x)
+				dst[x] = colors[src[x]];
+		} else {
+			for (int x = 0; x < in.w; ++x, src += in.format.bytesPerPixel) {
+				const uint32 col = (in.format.bytesPerPixel == 2) ? READ_UINT16(src) : READ_UINT32(src);
+				byte r, g, b;
+				in.format.colorToRGB(col, r, g, b);
+				dst[x] = out.format.RGBToColor(r, g, b);
+			}
 		}
 	}
 }
 
-
 /**
  * Copies the current screen contents to a new surface, using RGB565 format.
  * WARNING: surf->free() must be called by the user to avoid leaking.
@@ -171,43 +250,14 @@ static bool grabScreen565(Graphics::Surface *surf) {
 	if (!screen)
 		return false;
 
-	assert(screen->format.bytesPerPixel == 1 || screen->format.bytesPerPixel == 2
-	       || screen->format.bytesPerPixel == 4);
-	assert(screen->getPixels() != 0);
-
-	Graphics::PixelFormat screenFormat = g_system->getScreenFormat();
-
-	surf->create(screen->w, screen->h, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+	Graphics::Surface in = *screen;
+	in.format = g_system->getScreenFormat();
 
-	byte *palette = 0;
-	if (screenFormat.bytesPerPixel == 1) {
-		palette = new byte[256 * 3];
-		assert(palette);
+	byte palette[256 * 3];
+	if (in.format.bytesPerPixel == 1)
 		g_system->getPaletteManager()->grabPalette(palette, 0, 256);
-	}
-
-	for (int y = 0; y < screen->h; ++y) {
-		for (int x = 0; x < screen->w; ++x) {
-			byte r = 0, g = 0, b = 0;
-
-			if (screenFormat.bytesPerPixel == 1) {
-				uint8 pixel = *(uint8 *)screen->getBasePtr(x, y);
-				r = palette[pixel * 3 + 0];
-				g = palette[pixel * 3 + 1];
-				b = palette[pixel * 3 + 2];
-			} else if (screenFormat.bytesPerPixel == 2) {
-				uint16 col = READ_UINT16(screen->getBasePtr(x, y));
-				screenFormat.colorToRGB(col, r, g, b);
-			} else if (screenFormat.bytesPerPixel == 4) {
-				uint32 col = READ_UINT32(screen->getBasePtr(x, y));
-				screenFormat.colorToRGB(col, r, g, b);
-			}
-
-			*((uint16 *)surf->getBasePtr(x, y)) = surf->format.RGBToColor(r, g, b);
-		}
-	}
 
-	delete[] palette;
+	convertTo565(in, palette, *surf);
 
 	g_system->unlockScreen();
 	return true;
@@ -223,7 +273,7 @@ static bool createThumbnail(Graphics::Surface &out, Graphics::Surface &in) {
 
 	out.create(kThumbnailWidth, height, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
 	assert(out.format == Graphics::createPixelFormat<565>());
-	scaleThumbnail<Graphics::ColorMasks<565> >(in, out);
+	scaleThumbnail(in, out);
 	in.free();
 	return true;
 }
@@ -239,24 +289,20 @@ bool createThumbnailFromScreen(Graphics::Surface *surf) {
 	return createThumbnail(*surf, screen);
 }
 
-bool createThumbnail(Graphics::Surface *surf, const uint8 *pixels, int w, int h, const uint8 *palette) {
+bool createThumbnail(Graphics::Surface *surf, const Graphics::Surface &in, const uint8 *palette) {
 	assert(surf);
 
 	Graphics::Surface screen;
-	screen.create(w, h, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+	convertTo565(in, palette, screen);
 
-	for (int y = 0; y < screen.h; ++y) {
-		for (int x = 0; x < screen.w; ++x) {
-			byte r, g, b;
-			r = palette[pixels[y * w + x] * 3];
-			g = palette[pixels[y * w + x] * 3 + 1];
-			b = palette[pixels[y * w + x] * 3 + 2];
+	return createThumbnail(*surf, screen);
+}
 
-			*((uint16 *)screen.getBasePtr(x, y)) = screen.format.RGBToColor(r, g, b);
-		}
-	}
+bool createThumbnail(Graphics::Surface *surf, const uint8 *pixels, int w, int h, const uint8 *palette) {
+	Graphics::Surface in;
+	in.init(w, h, w, const_cast<uint8 *>(pixels), Graphics::PixelFormat::createFormatCLUT8());
 
-	return createThumbnail(*surf, screen);
+	return createThumbnail(surf, in, palette);
 }
 
 // this is somewhat awkward, but createScreenShot should logically be in graphics,
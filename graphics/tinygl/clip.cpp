@@ -57,6 +57,9 @@ void GLContext::gl_transform_to_viewport(GLVertex *v) {
 	if (texture_2d_enabled) {
 		v->zp.s = (int)(v->tex_coord.X * ZB_POINT_ST_MAX);
 		v->zp.t = (int)(v->tex_coord.Y * ZB_POINT_ST_MAX);
+	} else {
+		v->zp.s = 0;
+		v->zp.t = 0;
 	}
 }
 
@@ -76,6 +76,40 @@ void TexelBuffer::getARGBAt(
 	);
 }
 
+void TexelBuffer::getARGBAt4(
+	uint wrap_s, uint wrap_t,
+	int s, int t, int ds, int dt,
+	uint *a, uint *r, uint *g, uint *b
+) const {
+	uint pixels[4], fracS[4], fracT[4];
+	for (int i = 0; i < 4; i++) {
+		uint x, y;
+		x = wrap(wrap_s, s, _fracTextureUnit, _fracTextureMask) * _widthRatio;
+		y = wrap(wrap_t, t, _fracTextureUnit, _fracTextureMask) * _heightRatio;
+		pixels[i] = (x >> ZB_POINT_ST_FRAC_BITS) + (y >> ZB_POINT_ST_FRAC_BITS) * _width;
+		fracS[i] = x & ZB_POINT_ST_FRAC_MASK;
+		fracT[i] = y & ZB_POINT_ST_FRAC_MASK;
+		s += ds;
+		t += dt;
+	}
+	getARGBAt4(pixels, fracS, fracT, a, r, g, b);
+}
+
+void TexelBuffer::getARGBAt4(
+	const uint *pixels,
+	const uint *ds, const uint *dt,
+	uint *a, uint *r, uint *g, uint *b
+) const {
+	for (int i = 0; i < 4; i++) {
+		uint8 c_a, c_r, c_g, c_b;
+		getARGBAt(pixels[i], ds[i], dt[i], c_a, c_r, c_g, c_b);
+		a[i] = c_a;
+		r[i] = c_r;
+		g[i] = c_g;
+		b[i] = c_b;
+	}
+}
+
 // Nearest: store texture in original size.
 NearestTexelBuffer::NearestTexelBuffer(const Graphics::PixelBuffer &buf, uint width, uint height, uint textureSize) : TexelBuffer(width, height, textureSize) {
 	uint pixel_count = _width * _height;
@@ -95,6 +129,25 @@ void NearestTexelBuffer::getARGBAt(
 	_buf.getARGBAt(pixel, a, r, g, b);
 }
 
+void NearestTexelBuffer::getARGBAt4(
+	const uint *pixels,
+	const uint *, const uint *,
+	uint *a, uint *r, uint *g, uint *b
+) const {
+	const Graphics::PixelFormat &format = _buf.getFormat();
+	for (int i = 0; i < 4; i++) {
+		uint8 c_a, c_r, c_g, c_b;
+		if (format.bytesPerPixel == 4)
+			format.colorToARGB(((const uint32 *)_buf.getRawBuffer())[pixels[i]], c_a, c_r, c_g, c_b);
+		else
+			_buf.getARGBAt(pixels[i], c_a, c_r, c_g, c_b);
+		a[i] = c_a;
+		r[i] = c_r;
+		g[i] = c_g;
+		b[i] = c_b;
+	}
+}
+
 // Bilinear: each texture coordinates corresponds to the 4 original image
 // pixels linear interpolation has to work on, so that they are near each
 // other in CPU data cache, and a single actual memory fetch happens. This
@@ -36,6 +36,12 @@ public:
 		int s, int t,
 		uint8 &a, uint8 &r, uint8 &g, uint8 &b
 	) const;
+	// Same as getARGBAt() for four texels whose coordinates advance by ds and dt
+	void getARGBAt4(
+		uint wrap_s, uint wrap_t,
+		int s, int t, int ds, int dt,
+		uint *a, uint *r, uint *g, uint *b
+	) const;
 
 protected:
 	virtual void getARGBAt(
@@ -43,6 +49,11 @@ protected:
 		uint ds, uint dt,
 		uint8 &a, uint8 &r, uint8 &g, uint8 &b
 	) const = 0;
+	virtual void getARGBAt4(
+		const uint *pixels,
+		const uint *ds, const uint *dt,
+		uint *a, uint *r, uint *g, uint *b
+	) const;
 	uint _width, _height, _fracTextureUnit, _fracTextureMask;
 	float _widthRatio, _heightRatio;
 };
@@ -58,6 +69,11 @@ protected:
 		uint, uint,
 		uint8 &a, uint8 &r, uint8 &g, uint8 &b
 	) const override;
+	void getARGBAt4(
+		const uint *pixels,
+		const uint *, const uint *,
+		uint *a, uint *r, uint *g, uint *b
+	) const override;
 
 private:
 	Graphics::PixelBuffer _buf;
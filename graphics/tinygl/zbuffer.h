@@ -319,6 +319,27 @@ private:
 	template <bool kDepthWrite, bool kEnableScissor, bool kStencilEnabled, bool kDepthTestEnabled>
 	FORCEINLINE void putPixelDepth(uint *pz, byte *ps, int _a, int x, int y, uint &z, int &dzdx);
 
+	// Vectorized equivalents of putPixelDepth() and putPixelNoTexture() for spans
+	// without scissor, stencil and alpha test. They fill as many groups of four
+	// pixels as fit into count, advance the interpolated values past them and
+	// return the number of pixels filled.
+	template <bool kDepthWrite, bool kDepthTestEnabled>
+	int fillSpanDepth(uint *pz, int count, uint &z, int dzdx);
+
+	template <bool kDepthWrite, bool kSmoothMode, bool kEnableBlending, bool kDepthTestEnabled>
+	int fillSpanNoTexture(int fbOffset, uint *pz, int count, uint &z, uint &r, uint &g, uint &b, uint &a,
+	                      int dzdx, int drdx, int dgdx, int dbdx, uint dadx);
+
+	// Vectorized equivalent of putPixelTexture() with lighting, for the NB_INTERP
+	// pixels between two perspective corrections. It fills all of them and
+	// advances the interpolated values past them.
+	template <bool kDepthWrite, bool kSmoothMode, bool kEnableBlending, bool kDepthTestEnabled>
+	void fillSpanTexture(int fbOffset, const TexelBuffer *texture, uint *pz, uint &z, int &s, int &t,
+	                     uint &r, uint &g, uint &b, uint &a,
+	                     int dzdx, int dsdx, int dtdx, int drdx, int dgdx, int dbdx, uint dadx);
+
+	bool canFillSpansSIMD(bool colorSpans) const;
+
 
 	template <bool kEnableAlphaTest>
 	FORCEINLINE void writePixel(int pixel, int value) {
@@ -569,6 +590,15 @@ public:
 		_textureSizeMask = textureSizeMask;
 	}
 
+	/**
+	 * Select whether triangle spans may be filled with SSE2 or NEON, where
+	 * available. The output is the same either way, so this is mostly useful
+	 * for comparing both paths.
+	 */
+	void setUseSIMD(bool useSIMD) {
+		_useSIMD = useSIMD;
+	}
+
 private:
 
 	/**
@@ -659,6 +689,8 @@ private:
 	Common::Rect _clipRectangle;
 	bool _enableScissor;
 
+	bool _useSIMD;
+
 	const TexelBuffer *_currentTexture;
 	uint _wrapS, _wrapT;
 	bool _blendingEnabled;
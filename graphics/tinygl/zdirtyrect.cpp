@@ -96,7 +96,7 @@ void GLContext::disposeResources() {
 }
 
 void GLContext::disposeDrawCallLists() {
-	typedef Common::List<DrawCall *>::const_iterator DrawCallIterator;
+	typedef Common::Array<DrawCall *>::const_iterator DrawCallIterator;
 	for (DrawCallIterator it = _previousFrameDrawCallsQueue.begin(); it != _previousFrameDrawCallsQueue.end(); ++it) {
 		delete *it;
 	}
@@ -114,9 +114,14 @@ static inline void _appendDirtyRectangle(const DrawCall &call, Common::List<Dirt
 }
 
 void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas) {
-	typedef Common::List<DrawCall *>::const_iterator DrawCallIterator;
+	typedef Common::Array<DrawCall *>::const_iterator DrawCallIterator;
 	typedef Common::List<DirtyRectangle>::iterator RectangleIterator;
 
+	if (presentBufferDirtyTiles(dirtyAreas)) {
+		endDirtyRectsFrame();
+		return;
+	}
+
 	Common::List<DirtyRectangle> rectangles;
 
 	DrawCallIterator itFrame = _drawCallsQueue.begin();
@@ -221,13 +226,118 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 		}
 	}
 
+	endDirtyRectsFrame();
+}
+
+bool GLContext::presentBufferDirtyTiles(Common::List<Common::Rect> &dirtyAreas) {
+	typedef Common::Array<DrawCall *>::const_iterator DrawCallIterator;
+
+	// Both frames are compared tile by tile, so all their draw calls must give
+	// the same pixels when clipped to the tiles.
+	for (DrawCallIterator it = _drawCallsQueue.begin(); it != _drawCallsQueue.end(); ++it) {
+		if (!(*it)->isClipInvariant())
+			return false;
+	}
+	for (DrawCallIterator it = _previousFrameDrawCallsQueue.begin(); it != _previousFrameDrawCallsQueue.end(); ++it) {
+		if (!(*it)->isClipInvariant())
+			return false;
+	}
+
+	// Instead of merging the dirty regions of all changed draw calls, every tile
+	// of the screen is compared on its own: it keeps its contents from the previous
+	// frame when the same draw calls touch it, in the same order.
+	_renderTiles.resize(0);
+	_tileDrawCalls.resize(0);
+	for (int y = renderRect.top - renderRect.top % DIRTY_TILE_SIZE; y < renderRect.bottom; y += DIRTY_TILE_SIZE) {
+		for (int x = renderRect.left - renderRect.left % DIRTY_TILE_SIZE; x < renderRect.right; x += DIRTY_TILE_SIZE) {
+			const Common::Rect rect = Common::Rect(x, y, x + DIRTY_TILE_SIZE, y + DIRTY_TILE_SIZE).findIntersectingRect(renderRect);
+			binRenderTile(rect);
+
+			if (!isRenderTileChanged(_renderTiles.back())) {
+				_tileDrawCalls.resize(_renderTiles.back().firstDrawCall);
+				_renderTiles.pop_back();
+			}
+		}
+	}
+
+	for (uint i = 0; i < _renderTiles.size(); i++) {
+		const RenderTile &tile = _renderTiles[i];
+		for (uint j = 0; j < tile.numDrawCalls; j++) {
+			_tileDrawCalls[tile.firstDrawCall + j]->execute(tile.rect, true);
+		}
+	}
+
+	// Report rows of adjacent tiles as one area.
+	Common::Rect area;
+	for (uint i = 0; i < _renderTiles.size(); i++) {
+		const Common::Rect &rect = _renderTiles[i].rect;
+		if (!area.isEmpty() && area.right == rect.left && area.top == rect.top && area.bottom == rect.bottom) {
+			area.right = rect.right;
+			continue;
+		}
+		if (!area.isEmpty())
+			dirtyAreas.push_back(area);
+		area = rect;
+	}
+	if (!area.isEmpty())
+		dirtyAreas.push_back(area);
+
+	if (_debugRectsEnabled) {
+		fb->enableBlending(false);
+		fb->enableAlphaTest(false);
+
+		for (uint i = 0; i < _renderTiles.size(); i++) {
+			debugDrawRectangle(_renderTiles[i].rect, 255, 0, 0);
+		}
+
+		fb->enableBlending(blending_enabled);
+		fb->enableAlphaTest(alpha_test_enabled);
+	}
+
+	return true;
+}
+
+void GLContext::binRenderTile(const Common::Rect &rect) {
+	typedef Common::Array<DrawCall *>::const_iterator DrawCallIterator;
+
+	RenderTile tile;
+	tile.rect = rect;
+	tile.firstDrawCall = _tileDrawCalls.size();
+	for (DrawCallIterator it = _drawCallsQueue.begin(); it != _drawCallsQueue.end(); ++it) {
+		if (rect.intersects((*it)->getDirtyRegion()))
+			_tileDrawCalls.push_back(*it);
+	}
+	tile.numDrawCalls = _tileDrawCalls.size() - tile.firstDrawCall;
+	_renderTiles.push_back(tile);
+}
+
+bool GLContext::isRenderTileChanged(const RenderTile &tile) const {
+	typedef Common::Array<DrawCall *>::const_iterator DrawCallIterator;
+
+	uint current = 0;
+	for (DrawCallIterator it = _previousFrameDrawCallsQueue.begin(); it != _previousFrameDrawCallsQueue.end(); ++it) {
+		if (!tile.rect.intersects((*it)->getDirtyRegion()))
+			continue;
+		if (current == tile.numDrawCalls || *_tileDrawCalls[tile.firstDrawCall + current] != **it)
+			return true;
+		current++;
+	}
+	return current != tile.numDrawCalls;
+}
+
+void GLContext::endDirtyRectsFrame() {
+	typedef Common::Array<DrawCall *>::const_iterator DrawCallIterator;
+
 	// Dispose not necessary draw calls.
 	for (DrawCallIterator it = _previousFrameDrawCallsQueue.begin(); it !=  _previousFrameDrawCallsQueue.end(); ++it) {
 		delete *it;
 	}
 
-	_previousFrameDrawCallsQueue = _drawCallsQueue;
-	_drawCallsQueue.clear();
+	// Copy the pointers instead of assigning the array, so that both queues keep
+	// their storage and no allocation happens once they are large enough.
+	_previousFrameDrawCallsQueue.resize(0);
+	_previousFrameDrawCallsQueue.push_back(_drawCallsQueue);
+	_drawCallsQueue.resize(0);
 
 	disposeResources();
 
@@ -236,7 +346,7 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 }
 
 void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
-	typedef Common::List<DrawCall *>::const_iterator DrawCallIterator;
+	typedef Common::Array<DrawCall *>::const_iterator DrawCallIterator;
 
 	dirtyAreas.push_back(Common::Rect(fb->getPixelBufferWidth(), fb->getPixelBufferHeight()));
 
@@ -245,7 +355,7 @@ void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
 		delete *it;
 	}
 
-	_drawCallsQueue.clear();
+	_drawCallsQueue.resize(0);
 
 	disposeResources();
 
@@ -399,11 +509,16 @@ void RasterizationDrawCall::execute(bool restoreState) const {
 		break;
 	case TGL_QUADS:
 		for(int i = 0; i < cnt; i += 4) {
+			// Restore the edge flags afterwards, the vertices are compared with the next frame
+			const int edgeFlag0 = c->vertex[i + 0].edge_flag;
+			const int edgeFlag2 = c->vertex[i + 2].edge_flag;
 			c->vertex[i + 2].edge_flag = 0;
 			c->gl_draw_triangle(&c->vertex[i], &c->vertex[i + 1], &c->vertex[i + 2]);
 			c->vertex[i + 2].edge_flag = 1;
 			c->vertex[i + 0].edge_flag = 0;
 			c->gl_draw_triangle(&c->vertex[i], &c->vertex[i + 2], &c->vertex[i + 3]);
+			c->vertex[i + 0].edge_flag = edgeFlag0;
+			c->vertex[i + 2].edge_flag = edgeFlag2;
 		}
 		break;
 	case TGL_QUAD_STRIP:
@@ -545,6 +660,16 @@ void RasterizationDrawCall::execute(const Common::Rect &clippingRectangle, bool
 	c->fb->resetScissorRectangle();
 }
 
+bool RasterizationDrawCall::isClipInvariant() const {
+	// Quad strips shift their vertices while being drawn, so they can't be drawn
+	// more than once, and outlined quads depend on the edge flags of their vertices.
+	if (_state.beginType == TGL_QUAD_STRIP)
+		return false;
+	if (_state.beginType == TGL_QUADS)
+		return _state.polygonModeFront == TGL_FILL && _state.polygonModeBack == TGL_FILL;
+	return true;
+}
+
 bool RasterizationDrawCall::operator==(const RasterizationDrawCall &other) const {
 	if (_vertexCount == other._vertexCount &&
 		_drawTriangleFront == other._drawTriangleFront &&
@@ -608,6 +733,20 @@ void BlittingDrawCall::execute(const Common::Rect &clippingRectangle, bool resto
 	Internal::tglBlitResetScissorRect();
 }
 
+bool BlittingDrawCall::isClipInvariant() const {
+	// Clipping flipped, scaled or rotated blits shifts their source pixels
+	switch (_mode) {
+	case BlitMode_Regular:
+		return !_transform._flipHorizontally && !_transform._flipVertically && _transform._rotation == 0 &&
+		       _transform._destinationRectangle.width() == 0 && _transform._destinationRectangle.height() == 0;
+	case BlitMode_Fast:
+	case BlitMode_ZBuffer:
+		return true;
+	default:
+		return false;
+	}
+}
+
 BlittingDrawCall::BlittingState BlittingDrawCall::captureState() const {
 	BlittingState state;
 	TinyGL::GLContext *c = gl_get_context();
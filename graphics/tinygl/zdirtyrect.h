@@ -57,6 +57,9 @@ public:
 	virtual void execute(const Common::Rect &clippingRectangle, bool restoreState) const = 0;
 	DrawCallType getType() const { return _type; }
 	virtual const Common::Rect getDirtyRegion() const { return _dirtyRegion; }
+	// Whether executing the call once per clipping rectangle writes the same pixels
+	// as executing it once without clipping, which is required to redraw single tiles.
+	virtual bool isClipInvariant() const { return true; }
 protected:
 	Common::Rect _dirtyRegion;
 private:
@@ -89,6 +92,7 @@ public:
 	bool operator==(const RasterizationDrawCall &other) const;
 	virtual void execute(bool restoreState) const;
 	virtual void execute(const Common::Rect &clippingRectangle, bool restoreState) const;
+	virtual bool isClipInvariant() const;
 
 	void *operator new(size_t size) {
 		return Internal::allocateFrame(size);
@@ -165,6 +169,7 @@ public:
 	bool operator==(const BlittingDrawCall &other) const;
 	virtual void execute(bool restoreState) const;
 	virtual void execute(const Common::Rect &clippingRectangle, bool restoreState) const;
+	virtual bool isClipInvariant() const;
 
 	BlittingMode getBlittingMode() const { return _mode; }
 
@@ -205,6 +210,14 @@ private:
 	BlittingState _blitState;
 };
 
+// A part of the screen, together with the draw calls touching it in submission order,
+// stored as a range of GLContext::_tileDrawCalls.
+struct RenderTile {
+	Common::Rect rect;
+	uint firstDrawCall;
+	uint numDrawCalls;
+};
+
 } // end of namespace TinyGL
 
 #endif
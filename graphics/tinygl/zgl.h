@@ -37,6 +37,7 @@
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 #include "graphics/tinygl/gl.h"
+#include "graphics/tinygl/tinygl.h"
 #include "graphics/tinygl/zbuffer.h"
 #include "graphics/tinygl/zmath.h"
 #include "graphics/tinygl/zblit.h"
@@ -76,6 +77,9 @@ enum {
 #define MAX_DISPLAY_LISTS 1024
 #define OP_BUFFER_MAX_SIZE 512
 
+// Size of the tiles compared between frames when only dirty rectangles are redrawn
+#define DIRTY_TILE_SIZE 32
+
 #define TGL_OFFSET_FILL    0x1
 #define TGL_OFFSET_LINE    0x2
 #define TGL_OFFSET_POINT   0x4
@@ -427,13 +431,17 @@ struct GLContext {
 	// blit test
 	Common::List<BlitImage *> _blitImages;
 
-	// Draw call queue
-	Common::List<DrawCall *> _drawCallsQueue;
-	Common::List<DrawCall *> _previousFrameDrawCallsQueue;
+	// Draw call queue, the arrays keep their storage from frame to frame
+	Common::Array<DrawCall *> _drawCallsQueue;
+	Common::Array<DrawCall *> _previousFrameDrawCallsQueue;
 	int _currentAllocatorIndex;
 	LinearAllocator _drawCallAllocator[2];
 	bool _debugRectsEnabled;
 
+	// Tiles of the frame being presented, the arrays keep their storage as well
+	Common::Array<RenderTile> _renderTiles;
+	Common::Array<const DrawCall *> _tileDrawCalls;
+
 	void gl_vertex_transform(GLVertex *v);
 
 public:
@@ -481,7 +489,11 @@ public:
 	void disposeDrawCallLists();
 
 	void presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas);
+	bool presentBufferDirtyTiles(Common::List<Common::Rect> &dirtyAreas);
+	void binRenderTile(const Common::Rect &rect);
+	bool isRenderTileChanged(const RenderTile &tile) const;
 	void presentBufferSimple(Common::List<Common::Rect> &dirtyAreas);
+	void endDirtyRectsFrame();
 
 	void debugDrawRectangle(Common::Rect rect, int r, int g, int b);
 
@@ -30,15 +30,310 @@
 #include "graphics/tinygl/zbuffer.h"
 #include "graphics/tinygl/zgl.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define TINYGL_SPANS_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define TINYGL_SPANS_NEON
+#endif
+
 namespace TinyGL {
 
 static const int NB_INTERP = 8;
 
+#if defined(TINYGL_SPANS_SSE2)
+
+typedef __m128i SpanVec;
+
+static FORCEINLINE SpanVec spanSet(uint v) { return _mm_set1_epi32((int)v); }
+static FORCEINLINE SpanVec spanRamp(uint v, uint step) {
+	return _mm_add_epi32(_mm_set1_epi32((int)v), _mm_set_epi32((int)(3 * step), (int)(2 * step), (int)step, 0));
+}
+static FORCEINLINE SpanVec spanLoad(const uint *p) { return _mm_loadu_si128((const __m128i *)p); }
+static FORCEINLINE void spanStore(uint *p, SpanVec v) { _mm_storeu_si128((__m128i *)p, v); }
+static FORCEINLINE SpanVec spanAdd(SpanVec a, SpanVec b) { return _mm_add_epi32(a, b); }
+static FORCEINLINE SpanVec spanSub(SpanVec a, SpanVec b) { return _mm_sub_epi32(a, b); }
+static FORCEINLINE SpanVec spanAnd(SpanVec a, SpanVec b) { return _mm_and_si128(a, b); }
+static FORCEINLINE SpanVec spanOr(SpanVec a, SpanVec b) { return _mm_or_si128(a, b); }
+static FORCEINLINE SpanVec spanNot(SpanVec a) { return _mm_xor_si128(a, _mm_set1_epi32(-1)); }
+static FORCEINLINE SpanVec spanShr(SpanVec a, int n) { return _mm_srl_epi32(a, _mm_cvtsi32_si128(n)); }
+static FORCEINLINE SpanVec spanShl(SpanVec a, int n) { return _mm_sll_epi32(a, _mm_cvtsi32_si128(n)); }
+static FORCEINLINE SpanVec spanEq(SpanVec a, SpanVec b) { return _mm_cmpeq_epi32(a, b); }
+static FORCEINLINE SpanVec spanLess(SpanVec a, SpanVec b) {
+	// Unsigned comparison
+	const __m128i bias = _mm_set1_epi32((int)0x80000000);
+	return _mm_cmplt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+}
+static FORCEINLINE SpanVec spanSelect(SpanVec mask, SpanVec a, SpanVec b) {
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+static FORCEINLINE bool spanAny(SpanVec mask) { return _mm_movemask_epi8(mask) != 0; }
+// The lanes hold values below 256 for the multiplication and below 65536 for the minimum
+static FORCEINLINE SpanVec spanMulSmall(SpanVec a, SpanVec b) { return _mm_mullo_epi16(a, b); }
+static FORCEINLINE SpanVec spanMinSmall(SpanVec a, SpanVec b) { return _mm_min_epi16(a, b); }
+
+#elif defined(TINYGL_SPANS_NEON)
+
+typedef uint32x4_t SpanVec;
+
+static FORCEINLINE SpanVec spanSet(uint v) { return vdupq_n_u32(v); }
+static FORCEINLINE SpanVec spanRamp(uint v, uint step) {
+	static const uint32 ramp[4] = { 0, 1, 2, 3 };
+	return vmlaq_n_u32(vdupq_n_u32(v), vld1q_u32(ramp), step);
+}
+static FORCEINLINE SpanVec spanLoad(const uint *p) { return vld1q_u32((const uint32 *)p); }
+static FORCEINLINE void spanStore(uint *p, SpanVec v) { vst1q_u32((uint32 *)p, v); }
+static FORCEINLINE SpanVec spanAdd(SpanVec a, SpanVec b) { return vaddq_u32(a, b); }
+static FORCEINLINE SpanVec spanSub(SpanVec a, SpanVec b) { return vsubq_u32(a, b); }
+static FORCEINLINE SpanVec spanAnd(SpanVec a, SpanVec b) { return vandq_u32(a, b); }
+static FORCEINLINE SpanVec spanOr(SpanVec a, SpanVec b) { return vorrq_u32(a, b); }
+static FORCEINLINE SpanVec spanNot(SpanVec a) { return vmvnq_u32(a); }
+static FORCEINLINE SpanVec spanShr(SpanVec a, int n) { return vshlq_u32(a, vdupq_n_s32(-n)); }
+static FORCEINLINE SpanVec spanShl(SpanVec a, int n) { return vshlq_u32(a, vdupq_n_s32(n)); }
+static FORCEINLINE SpanVec spanEq(SpanVec a, SpanVec b) { return vceqq_u32(a, b); }
+static FORCEINLINE SpanVec spanLess(SpanVec a, SpanVec b) { return vcltq_u32(a, b); }
+static FORCEINLINE SpanVec spanSelect(SpanVec mask, SpanVec a, SpanVec b) { return vbslq_u32(mask, a, b); }
+static FORCEINLINE bool spanAny(SpanVec mask) {
+	uint32x2_t m = vorr_u32(vget_low_u32(mask), vget_high_u32(mask));
+	return (vget_lane_u32(m, 0) | vget_lane_u32(m, 1)) != 0;
+}
+static FORCEINLINE SpanVec spanMulSmall(SpanVec a, SpanVec b) { return vmulq_u32(a, b); }
+static FORCEINLINE SpanVec spanMinSmall(SpanVec a, SpanVec b) { return vminq_u32(a, b); }
+
+#endif
+
+#if defined(TINYGL_SPANS_SSE2) || defined(TINYGL_SPANS_NEON)
+
+// Same as FrameBuffer::compareDepth(), for four pixels
+static FORCEINLINE SpanVec spanDepthTest(int depthFunc, SpanVec zSrc, SpanVec zDst) {
+	switch (depthFunc) {
+	case TGL_LESS:
+		return spanLess(zDst, zSrc);
+	case TGL_EQUAL:
+		return spanEq(zDst, zSrc);
+	case TGL_LEQUAL:
+		return spanNot(spanLess(zSrc, zDst));
+	case TGL_GREATER:
+		return spanLess(zSrc, zDst);
+	case TGL_NOTEQUAL:
+		return spanNot(spanEq(zDst, zSrc));
+	case TGL_GEQUAL:
+		return spanNot(spanLess(zDst, zSrc));
+	case TGL_ALWAYS:
+		return spanSet(0xFFFFFFFF);
+	default:
+		return spanSet(0);
+	}
+}
+
+// Same as writePixel() with the usual alpha blending or without blending, for
+// four pixels whose components are bytes
+template <bool kEnableBlending>
+static FORCEINLINE SpanVec spanColor(const Graphics::PixelFormat &format, SpanVec aSrc, SpanVec rSrc, SpanVec gSrc, SpanVec bSrc, SpanVec pDst) {
+	if (kEnableBlending) {
+		const SpanVec byteMask = spanSet(0xFF);
+		const SpanVec aInv = spanSub(byteMask, aSrc);
+		const SpanVec rDst = spanAnd(spanShr(pDst, format.rShift), byteMask);
+		const SpanVec gDst = spanAnd(spanShr(pDst, format.gShift), byteMask);
+		const SpanVec bDst = spanAnd(spanShr(pDst, format.bShift), byteMask);
+		const SpanVec rOut = spanMinSmall(spanAdd(spanShr(spanMulSmall(rSrc, aSrc), 8), spanShr(spanMulSmall(rDst, aInv), 8)), byteMask);
+		const SpanVec gOut = spanMinSmall(spanAdd(spanShr(spanMulSmall(gSrc, aSrc), 8), spanShr(spanMulSmall(gDst, aInv), 8)), byteMask);
+		const SpanVec bOut = spanMinSmall(spanAdd(spanShr(spanMulSmall(bSrc, aSrc), 8), spanShr(spanMulSmall(bDst, aInv), 8)), byteMask);
+		return spanOr(spanOr(spanSet(format.ARGBToColor(255, 0, 0, 0)), spanShl(rOut, format.rShift)),
+		              spanOr(spanShl(gOut, format.gShift), spanShl(bOut, format.bShift)));
+	} else {
+		return spanOr(spanOr(spanShl(spanShr(aSrc, format.aLoss), format.aShift), spanShl(spanShr(rSrc, format.rLoss), format.rShift)),
+		              spanOr(spanShl(spanShr(gSrc, format.gLoss), format.gShift), spanShl(spanShr(bSrc, format.bLoss), format.bShift)));
+	}
+}
+
+bool FrameBuffer::canFillSpansSIMD(bool colorSpans) const {
+	if (!_useSIMD)
+		return false;
+	if (!colorSpans)
+		return true;
+	if (_pbufBpp != 4)
+		return false;
+	if (!_blendingEnabled)
+		return true;
+	// Only the usual alpha blending, on a format with 8 bits per color component
+	return _sourceBlendingFactor == TGL_SRC_ALPHA && _destinationBlendingFactor == TGL_ONE_MINUS_SRC_ALPHA &&
+	       _pbufFormat.rLoss == 0 && _pbufFormat.gLoss == 0 && _pbufFormat.bLoss == 0;
+}
+
+template <bool kDepthWrite, bool kDepthTestEnabled>
+int FrameBuffer::fillSpanDepth(uint *pz, int count, uint &z, int dzdx) {
+	const int filled = count & ~3;
+
+	if (kDepthWrite) {
+		const SpanVec zStep = spanSet(4 * dzdx);
+		SpanVec zv = spanRamp(z, dzdx);
+		for (int i = 0; i < filled; i += 4) {
+			const SpanVec zDst = spanLoad(pz + i);
+			const SpanVec pass = kDepthTestEnabled ? spanDepthTest(_depthFunc, zv, zDst) : spanSet(0xFFFFFFFF);
+			spanStore(pz + i, spanSelect(pass, zv, zDst));
+			zv = spanAdd(zv, zStep);
+		}
+	}
+
+	z += filled * dzdx;
+	return filled;
+}
+
+template <bool kDepthWrite, bool kSmoothMode, bool kEnableBlending, bool kDepthTestEnabled>
+int FrameBuffer::fillSpanNoTexture(int fbOffset, uint *pz, int count, uint &z, uint &r, uint &g, uint &b, uint &a,
+                                   int dzdx, int drdx, int dgdx, int dbdx, uint dadx) {
+	const int filled = count & ~3;
+	const Graphics::PixelFormat &format = _pbufFormat;
+	uint *pp = (uint *)_pbuf.getRawBuffer(fbOffset);
+
+	const SpanVec byteMask = spanSet(0xFF);
+
+	SpanVec zv = spanRamp(z, dzdx);
+	SpanVec rv = kSmoothMode ? spanRamp(r, drdx) : spanSet(r);
+	SpanVec gv = kSmoothMode ? spanRamp(g, dgdx) : spanSet(g);
+	SpanVec bv = kSmoothMode ? spanRamp(b, dbdx) : spanSet(b);
+	SpanVec av = kSmoothMode ? spanRamp(a, dadx) : spanSet(a);
+
+	for (int i = 0; i < filled; i += 4) {
+		const SpanVec zDst = spanLoad(pz + i);
+		const SpanVec pass = kDepthTestEnabled ? spanDepthTest(_depthFunc, zv, zDst) : spanSet(0xFFFFFFFF);
+
+		if (spanAny(pass)) {
+			// The components are truncated to bytes, like writePixel() does
+			const SpanVec aSrc = spanAnd(spanShr(av, ZB_POINT_ALPHA_BITS - 8), byteMask);
+			const SpanVec rSrc = spanAnd(spanShr(rv, ZB_POINT_RED_BITS - 8), byteMask);
+			const SpanVec gSrc = spanAnd(spanShr(gv, ZB_POINT_GREEN_BITS - 8), byteMask);
+			const SpanVec bSrc = spanAnd(spanShr(bv, ZB_POINT_BLUE_BITS - 8), byteMask);
+			const SpanVec pDst = spanLoad(pp + i);
+
+			const SpanVec color = spanColor<kEnableBlending>(format, aSrc, rSrc, gSrc, bSrc, pDst);
+			spanStore(pp + i, spanSelect(pass, color, pDst));
+			if (kDepthWrite) {
+				spanStore(pz + i, spanSelect(pass, zv, zDst));
+			}
+		}
+
+		zv = spanAdd(zv, spanSet(4 * dzdx));
+		if (kSmoothMode) {
+			rv = spanAdd(rv, spanSet(4 * drdx));
+			gv = spanAdd(gv, spanSet(4 * dgdx));
+			bv = spanAdd(bv, spanSet(4 * dbdx));
+			av = spanAdd(av, spanSet(4 * dadx));
+		}
+	}
+
+	z += filled * dzdx;
+	if (kSmoothMode) {
+		r += filled * drdx;
+		g += filled * dgdx;
+		b += filled * dbdx;
+		a += filled * dadx;
+	}
+	return filled;
+}
+
+template <bool kDepthWrite, bool kSmoothMode, bool kEnableBlending, bool kDepthTestEnabled>
+void FrameBuffer::fillSpanTexture(int fbOffset, const TexelBuffer *texture, uint *pz, uint &z, int &s, int &t,
+                                  uint &r, uint &g, uint &b, uint &a,
+                                  int dzdx, int dsdx, int dtdx, int drdx, int dgdx, int dbdx, uint dadx) {
+	const Graphics::PixelFormat &format = _pbufFormat;
+	uint *pp = (uint *)_pbuf.getRawBuffer(fbOffset);
+
+	const SpanVec byteMask = spanSet(0xFF);
+
+	SpanVec zv = spanRamp(z, dzdx);
+	SpanVec rv = kSmoothMode ? spanRamp(r, drdx) : spanSet(r);
+	SpanVec gv = kSmoothMode ? spanRamp(g, dgdx) : spanSet(g);
+	SpanVec bv = kSmoothMode ? spanRamp(b, dbdx) : spanSet(b);
+	SpanVec av = kSmoothMode ? spanRamp(a, dadx) : spanSet(a);
+
+	int si = s, ti = t;
+	for (int i = 0; i < NB_INTERP; i += 4) {
+		const SpanVec zDst = spanLoad(pz + i);
+		const SpanVec pass = kDepthTestEnabled ? spanDepthTest(_depthFunc, zv, zDst) : spanSet(0xFFFFFFFF);
+
+		if (spanAny(pass)) {
+			// SSE2 and NEON have no gather loads, the texels are fetched one by one
+			uint texA[4], texR[4], texG[4], texB[4];
+			texture->getARGBAt4(_wrapS, _wrapT, si, ti, dsdx, dtdx, texA, texR, texG, texB);
+
+			// Modulate the texels like putPixelTexture() does. The results are
+			// truncated to bytes, so only the low 16 bits of the products matter.
+			const SpanVec aSrc = spanAnd(spanShr(spanMulSmall(spanLoad(texA), spanShr(av, ZB_POINT_ALPHA_BITS - 8)), ZB_POINT_ALPHA_BITS - 8), byteMask);
+			const SpanVec rSrc = spanAnd(spanShr(spanMulSmall(spanLoad(texR), spanShr(rv, ZB_POINT_RED_BITS - 8)), ZB_POINT_RED_BITS - 8), byteMask);
+			const SpanVec gSrc = spanAnd(spanShr(spanMulSmall(spanLoad(texG), spanShr(gv, ZB_POINT_GREEN_BITS - 8)), ZB_POINT_GREEN_BITS - 8), byteMask);
+			const SpanVec bSrc = spanAnd(spanShr(spanMulSmall(spanLoad(texB), spanShr(bv, ZB_POINT_BLUE_BITS - 8)), ZB_POINT_BLUE_BITS - 8), byteMask);
+			const SpanVec pDst = spanLoad(pp + i);
+			const SpanVec color = spanColor<kEnableBlending>(format, aSrc, rSrc, gSrc, bSrc, pDst);
+
+			spanStore(pp + i, spanSelect(pass, color, pDst));
+			if (kDepthWrite) {
+				spanStore(pz + i, spanSelect(pass, zv, zDst));
+			}
+		}
+
+		si += 4 * dsdx;
+		ti += 4 * dtdx;
+		zv = spanAdd(zv, spanSet(4 * dzdx));
+		if (kSmoothMode) {
+			rv = spanAdd(rv, spanSet(4 * drdx));
+			gv = spanAdd(gv, spanSet(4 * dgdx));
+			bv = spanAdd(bv, spanSet(4 * dbdx));
+			av = spanAdd(av, spanSet(4 * dadx));
+		}
+	}
+
+	z += NB_INTERP * dzdx;
+	s += NB_INTERP * dsdx;
+	t += NB_INTERP * dtdx;
+	if (kSmoothMode) {
+		r += NB_INTERP * drdx;
+		g += NB_INTERP * dgdx;
+		b += NB_INTERP * dbdx;
+		a += NB_INTERP * dadx;
+	}
+}
+
+#else
+
+bool FrameBuffer::canFillSpansSIMD(bool colorSpans) const {
+	return false;
+}
+
+template <bool kDepthWrite, bool kDepthTestEnabled>
+int FrameBuffer::fillSpanDepth(uint *pz, int count, uint &z, int dzdx) {
+	return 0;
+}
+
+template <bool kDepthWrite, bool kSmoothMode, bool kEnableBlending, bool kDepthTestEnabled>
+int FrameBuffer::fillSpanNoTexture(int fbOffset, uint *pz, int count, uint &z, uint &r, uint &g, uint &b, uint &a,
+                                   int dzdx, int drdx, int dgdx, int dbdx, uint dadx) {
+	return 0;
+}
+
+template <bool kDepthWrite, bool kSmoothMode, bool kEnableBlending, bool kDepthTestEnabled>
+void FrameBuffer::fillSpanTexture(int fbOffset, const TexelBuffer *texture, uint *pz, uint &z, int &s, int &t,
+                                  uint &r, uint &g, uint &b, uint &a,
+                                  int dzdx, int dsdx, int dtdx, int drdx, int dgdx, int dbdx, uint dadx) {
+}
+
+#endif
+
 template <bool kDepthWrite, bool kSmoothMode, bool kEnableAlphaTest, bool kEnableScissor, bool kEnableBlending, bool kStencilEnabled, bool kDepthTestEnabled>
 FORCEINLINE void FrameBuffer::putPixelNoTexture(int fbOffset, uint *pz, byte *ps, int _a,
 	                                        int x, int y, uint &z, uint &r, uint &g, uint &b, uint &a,
 	                                        int &dzdx, int &drdx, int &dgdx, int &dbdx, uint dadx) {
 	if (kEnableScissor && scissorPixel(x + _a, y)) {
+		// Keep interpolating, the pixels after the clipped ones must not depend on the scissor rectangle
+		z += dzdx;
+		if (kSmoothMode) {
+			r += drdx;
+			g += dgdx;
+			b += dbdx;
+			a += dadx;
+		}
 		return;
 	}
 	if (kStencilEnabled) {
@@ -76,6 +371,16 @@ FORCEINLINE void FrameBuffer::putPixelTexture(int fbOffset, const TexelBuffer *t
 	                                      uint &r, uint &g, uint &b, uint &a,
 	                                      int &dzdx, int &dsdx, int &dtdx, int &drdx, int &dgdx, int &dbdx, uint dadx) {
 	if (kEnableScissor && scissorPixel(x + _a, y)) {
+		// Keep interpolating, the pixels after the clipped ones must not depend on the scissor rectangle
+		z += dzdx;
+		s += dsdx;
+		t += dtdx;
+		if (kSmoothMode) {
+			a += dadx;
+			r += drdx;
+			g += dgdx;
+			b += dbdx;
+		}
 		return;
 	}
 	if (kStencilEnabled) {
@@ -123,6 +428,8 @@ FORCEINLINE void FrameBuffer::putPixelTexture(int fbOffset, const TexelBuffer *t
 template <bool kDepthWrite, bool kEnableScissor, bool kStencilEnabled, bool kDepthTestEnabled>
 FORCEINLINE void FrameBuffer::putPixelDepth(uint *pz, byte *ps, int _a, int x, int y, uint &z, int &dzdx) {
 	if (kEnableScissor && scissorPixel(x + _a, y)) {
+		// Keep interpolating, the pixels after the clipped ones must not depend on the scissor rectangle
+		z += dzdx;
 		return;
 	}
 	if (kStencilEnabled) {
@@ -313,6 +620,11 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 		pr1 = p0;
 		pr2 = p2;
 	}
+	// Spans which only need the depth and color tests can be filled four pixels at a time
+	const bool simdSpans = kInterpZ && !kEnableScissor && !kStencilEnabled &&
+	                       (!kInterpRGB || !kAlphaTestEnabled) &&
+	                       canFillSpansSIMD(kInterpRGB);
+
 	nb_lines = p1->y - p0->y;
 	y = p0->y;
 	for (part = 0; part < 2; part++) {
@@ -408,6 +720,12 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 				if (kStencilEnabled) {
 					ps = ps1 + x1;
 				}
+				if (simdSpans && n >= 3) {
+					const int filled = fillSpanDepth<kDepthWrite, kDepthTestEnabled>(pz, n + 1, z, dzdx);
+					pz += filled;
+					n -= filled;
+					x += filled;
+				}
 				while (n >= 3) {
 					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kDepthTestEnabled>(pz, ps, 0, x, y, z, dzdx);
 					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kDepthTestEnabled>(pz, ps, 1, x, y, z, dzdx);
@@ -451,6 +769,14 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 				if (kStencilEnabled) {
 					ps = ps1 + x1;
 				}
+				if (simdSpans && n >= 3) {
+					const int filled = fillSpanNoTexture<kDepthWrite, kSmoothMode != 0, kBlendingEnabled, kDepthTestEnabled>
+					                   (pp, pz, n + 1, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx);
+					pp += filled;
+					pz += filled;
+					n -= filled;
+					x += filled;
+				}
 				while (n >= 3) {
 					putPixelNoTexture<kDepthWrite, kSmoothMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>(pp, pz, ps, 0, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx);
 					putPixelNoTexture<kDepthWrite, kSmoothMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>(pp, pz, ps, 1, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx);
@@ -517,9 +843,14 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 						fz += fndzdx;
 						zinv = (float)(1.0 / fz);
 					}
-					for (int _a = 0; _a < NB_INTERP; _a++) {
-						putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
-						               (pp, texture, _wrapS, _wrapT, pz, ps, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx);
+					if (simdSpans) {
+						fillSpanTexture<kDepthWrite, kSmoothMode != 0, kBlendingEnabled, kDepthTestEnabled>
+						               (pp, texture, pz, z, s, t, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx);
+					} else {
+						for (int _a = 0; _a < NB_INTERP; _a++) {
+							putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
+							               (pp, texture, _wrapS, _wrapT, pz, ps, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx);
+						}
 					}
 					pp += NB_INTERP;
 					if (kInterpZ) {
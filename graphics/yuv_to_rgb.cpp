@@ -82,9 +82,19 @@
 // BASIS, AND BROWN UNIVERSITY HAS NO OBLIGATION TO PROVIDE MAINTENANCE,
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
+#include "common/util.h"
+
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define YUV_TO_RGB_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define YUV_TO_RGB_NEON
+#endif
+
 namespace Common {
 DECLARE_SINGLETON(Graphics::YUVToRGBManager);
 }
@@ -100,8 +110,12 @@ public:
 	const uint32 *getRGBToPix() const { return _rgbToPix; }
 	const uint32 *getAlphaToPix() const { return _alphaToPix; }
 
+	/** Alpha bits which the RGB tables add to every pixel */
+	uint32 getAlphaBits() const { return _alphaBits; }
+
 private:
 	Graphics::PixelFormat _format;
+	uint32 _alphaBits;
 	YUVToRGBManager::LuminanceScale _scale;
 	uint32 _rgbToPix[3 * 768]; // 9216 bytes
 	uint32 _alphaToPix[256];   // 958 bytes
@@ -112,6 +126,7 @@ YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::Lu
 	_scale = scale;
 
 	int alphaValue = alphaMode ? 0 : 255;
+	_alphaBits = format.ARGBToColor(alphaValue, 0, 0, 0);
 
 	uint32 *r_2_pix_alloc = &_rgbToPix[0 * 768];
 	uint32 *g_2_pix_alloc = &_rgbToPix[1 * 768];
@@ -168,6 +183,11 @@ YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::Lu
 YUVToRGBManager::YUVToRGBManager() {
 	_lookup = 0;
 	_alphaMode = false;
+#if defined(YUV_TO_RGB_SSE2) || defined(YUV_TO_RGB_NEON)
+	_useSIMD = true;
+#else
+	_useSIMD = false;
+#endif
 
 	int16 *Cr_r_tab = &_colorTab[0 * 256];
 	int16 *Cr_g_tab = &_colorTab[1 * 256];
@@ -202,12 +222,232 @@ const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, Y
 	return _lookup;
 }
 
+#if defined(YUV_TO_RGB_SSE2) || defined(YUV_TO_RGB_NEON)
+
+/**
+ * The vectorized routines compute the color components arithmetically rather
+ * than through the lookup tables. The chroma contributions are still read from
+ * the color tables, so the results are identical to the table based code.
+ *
+ * Each call converts 8 pixels. For 4:2:0 data, every chroma sample covers two
+ * neighbouring pixels.
+ */
+
+/** Number of pixels for which the chroma contributions are computed in one go */
+#define YUV_SIMD_CHUNK 128
+
+#if defined(YUV_TO_RGB_SSE2)
+
+struct YUVToRGBSIMDState {
+	YUVToRGBSIMDState(const PixelFormat &format, uint32 alphaBits, bool itu) : _itu(itu) {
+		rLoss = _mm_cvtsi32_si128(format.rLoss);
+		gLoss = _mm_cvtsi32_si128(format.gLoss);
+		bLoss = _mm_cvtsi32_si128(format.bLoss);
+		aLoss = _mm_cvtsi32_si128(format.aLoss);
+		rShift = _mm_cvtsi32_si128(format.rShift);
+		gShift = _mm_cvtsi32_si128(format.gShift);
+		bShift = _mm_cvtsi32_si128(format.bShift);
+		aShift = _mm_cvtsi32_si128(format.aShift);
+		alpha16 = _mm_set1_epi16((int16)alphaBits);
+		alpha32 = _mm_set1_epi32(alphaBits);
+	}
+
+	bool _itu;
+	__m128i rLoss, gLoss, bLoss, aLoss;
+	__m128i rShift, gShift, bShift, aShift;
+	__m128i alpha16, alpha32;
+};
+
+static inline __m128i loadChroma(const int16 *src, bool halfChroma) {
+	if (halfChroma) {
+		const __m128i c = _mm_loadl_epi64((const __m128i *)src);
+		return _mm_unpacklo_epi16(c, c);
+	}
+	return _mm_loadu_si128((const __m128i *)src);
+}
+
+/** Clamp a component and scale it from the ITU range if necessary */
+static inline __m128i clampComponent(__m128i v, bool itu) {
+	if (itu) {
+		v = _mm_min_epi16(_mm_max_epi16(v, _mm_set1_epi16(16)), _mm_set1_epi16(235));
+		// (v - 16) * 255 / 219, exact for the whole input range
+		v = _mm_mullo_epi16(_mm_sub_epi16(v, _mm_set1_epi16(16)), _mm_set1_epi16(255));
+		return _mm_srli_epi16(_mm_mulhi_epu16(v, _mm_set1_epi16((int16)38305)), 7);
+	}
+	return _mm_min_epi16(_mm_max_epi16(v, _mm_setzero_si128()), _mm_set1_epi16(255));
+}
+
+template<typename PixelInt, bool halfChroma>
+static inline void convert8Pixels(byte *dst, const byte *ySrc, const byte *aSrc, const int16 *dR, const int16 *dG, const int16 *dB, const YUVToRGBSIMDState &st) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i y = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)ySrc), zero);
+
+	const __m128i r = _mm_srl_epi16(clampComponent(_mm_add_epi16(y, loadChroma(dR, halfChroma)), st._itu), st.rLoss);
+	const __m128i g = _mm_srl_epi16(clampComponent(_mm_add_epi16(y, loadChroma(dG, halfChroma)), st._itu), st.gLoss);
+	const __m128i b = _mm_srl_epi16(clampComponent(_mm_add_epi16(y, loadChroma(dB, halfChroma)), st._itu), st.bLoss);
+	__m128i a = zero;
+	if (aSrc)
+		a = _mm_srl_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)aSrc), zero), st.aLoss);
+
+	if (sizeof(PixelInt) == 2) {
+		__m128i pix = _mm_or_si128(_mm_sll_epi16(r, st.rShift), _mm_sll_epi16(g, st.gShift));
+		pix = _mm_or_si128(pix, _mm_or_si128(_mm_sll_epi16(b, st.bShift), st.alpha16));
+		if (aSrc)
+			pix = _mm_or_si128(pix, _mm_sll_epi16(a, st.aShift));
+		_mm_storeu_si128((__m128i *)dst, pix);
+	} else {
+		__m128i lo = _mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(r, zero), st.rShift), _mm_sll_epi32(_mm_unpacklo_epi16(g, zero), st.gShift));
+		__m128i hi = _mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(r, zero), st.rShift), _mm_sll_epi32(_mm_unpackhi_epi16(g, zero), st.gShift));
+		lo = _mm_or_si128(lo, _mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(b, zero), st.bShift), st.alpha32));
+		hi = _mm_or_si128(hi, _mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(b, zero), st.bShift), st.alpha32));
+		if (aSrc) {
+			lo = _mm_or_si128(lo, _mm_sll_epi32(_mm_unpacklo_epi16(a, zero), st.aShift));
+			hi = _mm_or_si128(hi, _mm_sll_epi32(_mm_unpackhi_epi16(a, zero), st.aShift));
+		}
+		_mm_storeu_si128((__m128i *)dst, lo);
+		_mm_storeu_si128((__m128i *)(dst + 16), hi);
+	}
+}
+
+#elif defined(YUV_TO_RGB_NEON)
+
+struct YUVToRGBSIMDState {
+	YUVToRGBSIMDState(const PixelFormat &format, uint32 alphaBits, bool itu) : _itu(itu) {
+		rLoss = vdupq_n_s16(-format.rLoss);
+		gLoss = vdupq_n_s16(-format.gLoss);
+		bLoss = vdupq_n_s16(-format.bLoss);
+		aLoss = vdupq_n_s16(-format.aLoss);
+		rShift16 = vdupq_n_s16(format.rShift);
+		gShift16 = vdupq_n_s16(format.gShift);
+		bShift16 = vdupq_n_s16(format.bShift);
+		aShift16 = vdupq_n_s16(format.aShift);
+		rShift32 = vdupq_n_s32(format.rShift);
+		gShift32 = vdupq_n_s32(format.gShift);
+		bShift32 = vdupq_n_s32(format.bShift);
+		aShift32 = vdupq_n_s32(format.aShift);
+		alpha16 = vdupq_n_u16((uint16)alphaBits);
+		alpha32 = vdupq_n_u32(alphaBits);
+	}
+
+	bool _itu;
+	int16x8_t rLoss, gLoss, bLoss, aLoss;
+	int16x8_t rShift16, gShift16, bShift16, aShift16;
+	int32x4_t rShift32, gShift32, bShift32, aShift32;
+	uint16x8_t alpha16;
+	uint32x4_t alpha32;
+};
+
+static inline int16x8_t loadChroma(const int16 *src, bool halfChroma) {
+	if (halfChroma) {
+		const int16x4_t c = vld1_s16(src);
+		const int16x4x2_t z = vzip_s16(c, c);
+		return vcombine_s16(z.val[0], z.val[1]);
+	}
+	return vld1q_s16(src);
+}
+
+/** Clamp a component and scale it from the ITU range if necessary */
+static inline uint16x8_t clampComponent(int16x8_t v, bool itu) {
+	if (itu) {
+		v = vminq_s16(vmaxq_s16(v, vdupq_n_s16(16)), vdupq_n_s16(235));
+		// (v - 16) * 255 / 219, exact for the whole input range
+		const uint16x8_t m = vmulq_u16(vreinterpretq_u16_s16(vsubq_s16(v, vdupq_n_s16(16))), vdupq_n_u16(255));
+		const uint32x4_t lo = vmull_u16(vget_low_u16(m), vdup_n_u16(38305));
+		const uint32x4_t hi = vmull_u16(vget_high_u16(m), vdup_n_u16(38305));
+		return vshrq_n_u16(vcombine_u16(vshrn_n_u32(lo, 16), vshrn_n_u32(hi, 16)), 7);
+	}
+	return vreinterpretq_u16_s16(vminq_s16(vmaxq_s16(v, vdupq_n_s16(0)), vdupq_n_s16(255)));
+}
+
+template<typename PixelInt, bool halfChroma>
+static inline void convert8Pixels(byte *dst, const byte *ySrc, const byte *aSrc, const int16 *dR, const int16 *dG, const int16 *dB, const YUVToRGBSIMDState &st) {
+	const int16x8_t y = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(ySrc)));
+
+	const uint16x8_t r = vshlq_u16(clampComponent(vaddq_s16(y, loadChroma(dR, halfChroma)), st._itu), st.rLoss);
+	const uint16x8_t g = vshlq_u16(clampComponent(vaddq_s16(y, loadChroma(dG, halfChroma)), st._itu), st.gLoss);
+	const uint16x8_t b = vshlq_u16(clampComponent(vaddq_s16(y, loadChroma(dB, halfChroma)), st._itu), st.bLoss);
+	uint16x8_t a = vdupq_n_u16(0);
+	if (aSrc)
+		a = vshlq_u16(vmovl_u8(vld1_u8(aSrc)), st.aLoss);
+
+	if (sizeof(PixelInt) == 2) {
+		uint16x8_t pix = vorrq_u16(vshlq_u16(r, st.rShift16), vshlq_u16(g, st.gShift16));
+		pix = vorrq_u16(pix, vorrq_u16(vshlq_u16(b, st.bShift16), st.alpha16));
+		if (aSrc)
+			pix = vorrq_u16(pix, vshlq_u16(a, st.aShift16));
+		vst1q_u16((uint16 *)dst, pix);
+	} else {
+		uint32x4_t lo = vorrq_u32(vshlq_u32(vmovl_u16(vget_low_u16(r)), st.rShift32), vshlq_u32(vmovl_u16(vget_low_u16(g)), st.gShift32));
+		uint32x4_t hi = vorrq_u32(vshlq_u32(vmovl_u16(vget_high_u16(r)), st.rShift32), vshlq_u32(vmovl_u16(vget_high_u16(g)), st.gShift32));
+		lo = vorrq_u32(lo, vorrq_u32(vshlq_u32(vmovl_u16(vget_low_u16(b)), st.bShift32), st.alpha32));
+		hi = vorrq_u32(hi, vorrq_u32(vshlq_u32(vmovl_u16(vget_high_u16(b)), st.bShift32), st.alpha32));
+		if (aSrc) {
+			lo = vorrq_u32(lo, vshlq_u32(vmovl_u16(vget_low_u16(a)), st.aShift32));
+			hi = vorrq_u32(hi, vshlq_u32(vmovl_u16(vget_high_u16(a)), st.aShift32));
+		}
+		vst1q_u32((uint32 *)dst, lo);
+		vst1q_u32((uint32 *)(dst + 16), hi);
+	}
+}
+
+#endif
+
+/**
+ * Convert the first 'width' pixels of 'rows' consecutive rows sharing the
+ * same chroma samples. 'width' must be a multiple of 8.
+ */
+template<typename PixelInt, bool halfChroma>
+static void convertRowsSIMD(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yPitch, int rows, int width) {
+	const int16 *Cr_r_tab = colorTab;
+	const int16 *Cr_g_tab = Cr_r_tab + 256;
+	const int16 *Cb_g_tab = Cr_g_tab + 256;
+	const int16 *Cb_b_tab = Cb_g_tab + 256;
+
+	const YUVToRGBSIMDState st(lookup->getFormat(), lookup->getAlphaBits(), lookup->getScale() == YUVToRGBManager::kScaleITU);
+
+	int16 dR[YUV_SIMD_CHUNK], dG[YUV_SIMD_CHUNK], dB[YUV_SIMD_CHUNK];
+
+	for (int x = 0; x < width; x += YUV_SIMD_CHUNK) {
+		const int pixels = MIN<int>(YUV_SIMD_CHUNK, width - x);
+		const int chromaStart = halfChroma ? (x >> 1) : x;
+		const int chromaCount = halfChroma ? (pixels >> 1) : pixels;
+
+		// Compute the chroma contributions, without the table offsets
+		for (int i = 0; i < chromaCount; i++) {
+			const byte u = uSrc[chromaStart + i];
+			const byte v = vSrc[chromaStart + i];
+			dR[i] = Cr_r_tab[v] - (0 * 768 + 256);
+			dG[i] = Cr_g_tab[v] + Cb_g_tab[u] - (1 * 768 + 256);
+			dB[i] = Cb_b_tab[u] - (2 * 768 + 256);
+		}
+
+		for (int row = 0; row < rows; row++) {
+			byte *dst = dstPtr + row * dstPitch + x * sizeof(PixelInt);
+			const byte *y = ySrc + row * yPitch + x;
+			const byte *a = aSrc ? aSrc + row * yPitch + x : nullptr;
+
+			for (int i = 0; i < pixels; i += 8) {
+				const int c = halfChroma ? (i >> 1) : i;
+				convert8Pixels<PixelInt, halfChroma>(dst + i * sizeof(PixelInt), y + i, a ? a + i : nullptr, dR + c, dG + c, dB + c, st);
+			}
+		}
+	}
+}
+
+#endif
+
+int YUVToRGBManager::getSIMDWidth(int yWidth) const {
+	// The vectorized routines convert 8 pixels at a time, the remaining
+	// pixels of each row go through the lookup tables.
+	return _useSIMD ? (yWidth & ~7) : 0;
+}
+
 #define PUT_PIXEL(s, d) \
 	L = &rgbToPix[(s)]; \
 	*((PixelInt *)(d)) = (L[cr_r] | L[crb_g] | L[cb_b])
 
 template<typename PixelInt>
-void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch, int simdWidth) {
 	// Keep the tables in pointers here to avoid a dereference on each pixel
 	const int16 *Cr_r_tab = colorTab;
 	const int16 *Cr_g_tab = Cr_r_tab + 256;
@@ -216,7 +456,17 @@ void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	const uint32 *rgbToPix = lookup->getRGBToPix();
 
 	for (int h = 0; h < yHeight; h++) {
-		for (int w = 0; w < yWidth; w++) {
+#if defined(YUV_TO_RGB_SSE2) || defined(YUV_TO_RGB_NEON)
+		if (simdWidth) {
+			convertRowsSIMD<PixelInt, false>(dstPtr, dstPitch, lookup, colorTab, ySrc, uSrc, vSrc, nullptr, yPitch, 1, simdWidth);
+			dstPtr += simdWidth * sizeof(PixelInt);
+			ySrc += simdWidth;
+			uSrc += simdWidth;
+			vSrc += simdWidth;
+		}
+#endif
+
+		for (int w = simdWidth; w < yWidth; w++) {
 			const uint32 *L;
 
 			int16 cr_r  = Cr_r_tab[*vSrc];
@@ -244,16 +494,17 @@ void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert(ySrc && uSrc && vSrc);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	const int simdWidth = getSIMDWidth(yWidth);
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUV444ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV444ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch, simdWidth);
 	else
-		convertYUV444ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV444ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch, simdWidth);
 }
 
 template<typename PixelInt>
-void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch, int simdWidth) {
 	int halfHeight = yHeight >> 1;
 	int halfWidth = yWidth >> 1;
 
@@ -265,7 +516,17 @@ void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	const uint32 *rgbToPix = lookup->getRGBToPix();
 
 	for (int h = 0; h < halfHeight; h++) {
-		for (int w = 0; w < halfWidth; w++) {
+#if defined(YUV_TO_RGB_SSE2) || defined(YUV_TO_RGB_NEON)
+		if (simdWidth) {
+			convertRowsSIMD<PixelInt, true>(dstPtr, dstPitch, lookup, colorTab, ySrc, uSrc, vSrc, nullptr, yPitch, 2, simdWidth);
+			dstPtr += simdWidth * sizeof(PixelInt);
+			ySrc += simdWidth;
+			uSrc += simdWidth >> 1;
+			vSrc += simdWidth >> 1;
+		}
+#endif
+
+		for (int w = simdWidth >> 1; w < halfWidth; w++) {
 			const uint32 *L;
 
 			int16 cr_r  = Cr_r_tab[*vSrc];
@@ -300,12 +561,13 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert((yHeight & 1) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	const int simdWidth = getSIMDWidth(yWidth);
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch, simdWidth);
 	else
-		convertYUV420ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV420ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch, simdWidth);
 }
 
 #define PUT_PIXELA(s, a, d) \
@@ -313,7 +575,7 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	*((PixelInt *)(d)) = (L[cr_r] | L[crb_g] | L[cb_b] | aToPix[a])
 
 template<typename PixelInt>
-void convertYUVA420ToRGBA(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+void convertYUVA420ToRGBA(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch, int simdWidth) {
 	int halfHeight = yHeight >> 1;
 	int halfWidth = yWidth >> 1;
 
@@ -326,7 +588,18 @@ void convertYUVA420ToRGBA(byte *dstPtr, int dstPitch, const YUVToRGBLookup *look
 	const uint32 *aToPix = lookup->getAlphaToPix();
 
 	for (int h = 0; h < halfHeight; h++) {
-		for (int w = 0; w < halfWidth; w++) {
+#if defined(YUV_TO_RGB_SSE2) || defined(YUV_TO_RGB_NEON)
+		if (simdWidth) {
+			convertRowsSIMD<PixelInt, true>(dstPtr, dstPitch, lookup, colorTab, ySrc, uSrc, vSrc, aSrc, yPitch, 2, simdWidth);
+			dstPtr += simdWidth * sizeof(PixelInt);
+			ySrc += simdWidth;
+			aSrc += simdWidth;
+			uSrc += simdWidth >> 1;
+			vSrc += simdWidth >> 1;
+		}
+#endif
+
+		for (int w = simdWidth >> 1; w < halfWidth; w++) {
 			const uint32 *L;
 
 			int16 cr_r  = Cr_r_tab[*vSrc];
@@ -364,12 +637,13 @@ void YUVToRGBManager::convert420Alpha(Graphics::Surface *dst, YUVToRGBManager::L
 	assert((yHeight & 1) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale, true);
+	const int simdWidth = getSIMDWidth(yWidth);
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUVA420ToRGBA<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUVA420ToRGBA<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch, simdWidth);
 	else
-		convertYUVA420ToRGBA<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUVA420ToRGBA<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch, simdWidth);
 }
 
 #define READ_QUAD(ptr, prefix) \
@@ -26,6 +26,7 @@
 #include "common/debug.h"
 #include "common/debug-channels.h"
 #include "common/system.h"
+#include "common/timer.h"
 
 #ifndef DISABLE_MD5
 #include "common/md5.h"
@@ -78,6 +79,8 @@ Debugger::Debugger() {
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
 	registerCmd("debugflag_enable",	WRAP_METHOD(Debugger, cmdDebugFlagEnable));
 	registerCmd("debugflag_disable",	WRAP_METHOD(Debugger, cmdDebugFlagDisable));
+
+	registerCmd("timer_stats",		WRAP_METHOD(Debugger, cmdTimerStats));
 }
 
 Debugger::~Debugger() {
@@ -810,6 +813,39 @@ bool Debugger::cmdDebugFlagDisable(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdTimerStats(int argc, const char **argv) {
+	Common::TimerManager *timerManager = g_system->getTimerManager();
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset"))) {
+		debugPrintf("timer_stats [reset]\n");
+		return true;
+	}
+
+	Common::Array<Common::TimerManager::TimerStats> stats;
+	if (!timerManager || !timerManager->getTimerStats(stats)) {
+		debugPrintf("The timer manager doesn't keep statistics\n");
+		return true;
+	}
+
+	if (argc == 2) {
+		timerManager->resetTimerStats();
+		debugPrintf("Reset the statistics of %u timers\n", stats.size());
+		return true;
+	}
+
+	debugPrintf("Latencies in ms: <1 <2 <4 <8 <16 <32 <64 >=64\n");
+	for (uint i = 0; i < stats.size(); i++) {
+		const Common::TimerManager::TimerStats &timer = stats[i];
+		debugPrintf("%s: interval %d us, %u calls, %u overruns, max latency %u us, max run time %u us\n",
+		            timer.id.c_str(), timer.interval, timer.calls, timer.overruns, timer.maxLatency, timer.maxRunTime);
+
+		Common::String histogram;
+		for (int j = 0; j < Common::TimerManager::TimerStats::kLatencyBuckets; j++)
+			histogram += Common::String::format(" %u", timer.latencies[j]);
+		debugPrintf("  latencies:%s\n", histogram.c_str());
+	}
+	return true;
+}
+
 // Console handler
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 bool Debugger::debuggerInputCallback(GUI::ConsoleDialog *console, const char *input, void *refCon) {
@@ -0,0 +1,106 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/softsynth/opl/mame.h"
+
+#include "common/endian.h"
+#include "common/md5.h"
+#include "common/memstream.h"
+
+#include "../null_osystem.h"
+
+class OPLTestSuite : public CxxTest::TestSuite
+{
+private:
+	/**
+	 * Render a fixed register write trace through the MAME emulator,
+	 * interleaving writes with render calls of varying length like
+	 * EmulatedOPL does with its timer callbacks, and return the MD5 of
+	 * the generated samples. In rhythm mode, the drums are keyed on and
+	 * off along with the melodic channels.
+	 */
+	Common::String renderMAMETrace(bool rhythm) {
+		static const int slotOffsets[9] = { 0, 1, 2, 8, 9, 10, 16, 17, 18 };
+		const int rate = 22050;
+		const int totalSamples = rate * 8;
+
+		OPL::MAME::FM_OPL *opl = OPL::MAME::makeAdLibOPL(rate);
+		int16 *samples = (int16 *)malloc(totalSamples * sizeof(int16));
+		int pos = 0;
+
+		// The noise of the drums needs to be the same on every run
+		opl->rnd->setSeed(1);
+
+		// Enable waveform selection
+		OPL::MAME::OPLWriteReg(opl, 0x01, 0x20);
+
+		for (int ch = 0; ch < 9; ++ch) {
+			for (int op = 0; op < 2; ++op) {
+				const int slot = slotOffsets[ch] + op * 3;
+				// Tremolo/vibrato on some operators, sustain on others
+				OPL::MAME::OPLWriteReg(opl, 0x20 + slot, ((ch & 1) ? 0xC0 : 0x20) | (1 + ch % 4));
+				OPL::MAME::OPLWriteReg(opl, 0x40 + slot, op ? 0x00 : 0x10 + ch * 2);
+				OPL::MAME::OPLWriteReg(opl, 0x60 + slot, 0xF2 + (ch % 3));
+				OPL::MAME::OPLWriteReg(opl, 0x80 + slot, 0x45 + (ch % 4) * 0x10);
+				OPL::MAME::OPLWriteReg(opl, 0xE0 + slot, (ch + op) % 4);
+			}
+			OPL::MAME::OPLWriteReg(opl, 0xC0 + ch, ((ch % 8) << 1) | (ch & 1));
+		}
+
+		// Deep tremolo and vibrato
+		OPL::MAME::OPLWriteReg(opl, 0xBD, 0xC0 | (rhythm ? 0x20 : 0));
+
+		for (int step = 0; step < 60; ++step) {
+			const int onCh = step % 9;
+			const int offCh = (step + 4) % 9;
+			const int fnum = (0x200 + step * 37) & 0x3FF;
+			const int block = 1 + step % 7;
+
+			OPL::MAME::OPLWriteReg(opl, 0xA0 + onCh, fnum & 0xFF);
+			OPL::MAME::OPLWriteReg(opl, 0xB0 + onCh, 0x20 | (block << 2) | (fnum >> 8));
+			OPL::MAME::OPLWriteReg(opl, 0xB0 + offCh, (block << 2));
+			if (rhythm)
+				OPL::MAME::OPLWriteReg(opl, 0xBD, 0xE0 | ((step * 5) & 0x1F));
+
+			const int length = 100 + (step * 131) % 700;
+			OPL::MAME::YM3812UpdateOne(opl, samples + pos, length);
+			pos += length;
+		}
+
+		// Release everything and let the envelopes run out
+		for (int ch = 0; ch < 9; ++ch)
+			OPL::MAME::OPLWriteReg(opl, 0xB0 + ch, 0x00);
+
+		while (pos < totalSamples) {
+			const int length = MIN(512, totalSamples - pos);
+			OPL::MAME::YM3812UpdateOne(opl, samples + pos, length);
+			pos += length;
+		}
+
+		OPL::MAME::OPLDestroy(opl);
+
+		// Hash the samples in a fixed byte order
+		for (int i = 0; i < totalSamples; ++i)
+			WRITE_LE_UINT16(&samples[i], samples[i]);
+
+		Common::MemoryReadStream stream((const byte *)samples, totalSamples * sizeof(int16), DisposeAfterUse::YES);
+		return Common::computeStreamMD5AsString(stream);
+	}
+
+public:
+	void test_mame_trace() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// The emulator needs a RandomSource, which requires g_system
+		Common::install_null_g_system();
+
+		TS_ASSERT_EQUALS(renderMAMETrace(false), "d442a4b00cdf4a4fdcfc34cb1d4aede0");
+#endif
+	}
+
+	void test_mame_rhythm_trace() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		TS_ASSERT_EQUALS(renderMAMETrace(true), "210221e1de2f1b21d6753a564903bd9f");
+#endif
+	}
+};
@@ -0,0 +1,147 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+#include "audio/decoders/raw.h"
+
+#include "common/scummsys.h"
+
+#include "helper.h"
+
+class RateConverterTestSuite : public CxxTest::TestSuite
+{
+private:
+	/**
+	 * Mix the same stream through the clamping 16-bit path and the 32-bit
+	 * accumulating path and check that both produce identical output.
+	 */
+	void mixTestTemplate(const int inRate, const int outRate, const bool isStereo, const bool reverseStereo, Audio::st_volume_t volL, Audio::st_volume_t volR,
+	                     Audio::RateConverterQuality quality = Audio::kRateConverterDefault) {
+		Audio::SeekableAudioStream *s16 = createSineStream<int16>(inRate, 1, nullptr, true, isStereo);
+		Audio::SeekableAudioStream *s32 = createSineStream<int16>(inRate, 1, nullptr, true, isStereo);
+
+		Audio::RateConverter *conv16 = Audio::makeRateConverter(inRate, outRate, isStereo, reverseStereo, quality);
+		Audio::RateConverter *conv32 = Audio::makeRateConverter(inRate, outRate, isStereo, reverseStereo, quality);
+
+		// Use an odd chunk size so the scalar tail of the vectorized path is exercised
+		const int chunk = 1003;
+		int16 *out16 = new int16[chunk * 2];
+		int16 *out32 = new int16[chunk * 2];
+		Audio::st_mix_t *mix = new Audio::st_mix_t[chunk * 2];
+
+		for (;;) {
+			memset(out16, 0, chunk * 2 * sizeof(int16));
+			memset(mix, 0, chunk * 2 * sizeof(Audio::st_mix_t));
+
+			const int res16 = conv16->flow(*s16, out16, chunk, volL, volR);
+			const int res32 = conv32->flow(*s32, mix, chunk, volL, volR);
+			TS_ASSERT_EQUALS(res16, res32);
+
+			Audio::clampMixBuffer(out32, mix, chunk * 2);
+			TS_ASSERT_EQUALS(memcmp(out16, out32, chunk * 2 * sizeof(int16)), 0);
+
+			if (res16 < chunk)
+				break;
+		}
+
+		delete[] out16;
+		delete[] out32;
+		delete[] mix;
+		delete conv16;
+		delete conv32;
+		delete s16;
+		delete s32;
+	}
+
+	/**
+	 * Feed a constant signal through the sinc converter and check that it
+	 * comes out unchanged once the filter has settled.
+	 */
+	void sincDCTestTemplate(const int inRate, const int outRate, Audio::RateConverterQuality quality) {
+		const int inSamples = inRate / 10;
+		int16 *data = (int16 *)malloc(inSamples * sizeof(int16));
+		for (int i = 0; i < inSamples; ++i)
+			data[i] = 10000;
+
+		Audio::SeekableAudioStream *s = Audio::makeRawStream((const byte *)data, inSamples * sizeof(int16), inRate,
+		                                                     Audio::FLAG_16BITS
+#ifdef SCUMM_LITTLE_ENDIAN
+		                                                     | Audio::FLAG_LITTLE_ENDIAN
+#endif
+		                                                     );
+		Audio::RateConverter *conv = Audio::makeRateConverter(inRate, outRate, false, false, quality);
+
+		const int outSamples = outRate / 20;
+		Audio::st_mix_t *mix = new Audio::st_mix_t[outSamples * 2];
+		memset(mix, 0, outSamples * 2 * sizeof(Audio::st_mix_t));
+
+		TS_ASSERT_EQUALS(conv->flow(*s, mix, outSamples, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume), outSamples);
+
+		// Skip the delay introduced by the filter
+		for (int i = outSamples / 2; i < outSamples; ++i) {
+			TS_ASSERT_DELTA(mix[i * 2 + 0], 10000, 2);
+			TS_ASSERT_DELTA(mix[i * 2 + 1], 10000, 2);
+		}
+
+		delete[] mix;
+		delete conv;
+		delete s;
+	}
+
+public:
+	void test_copy_mono() {
+		mixTestTemplate(22050, 22050, false, false, 200, 97);
+	}
+
+	void test_copy_stereo() {
+		mixTestTemplate(22050, 22050, true, false, 256, 13);
+	}
+
+	void test_copy_stereo_reverse() {
+		mixTestTemplate(22050, 22050, true, true, 31, 180);
+	}
+
+	void test_simple_stereo() {
+		mixTestTemplate(44100, 22050, true, false, 128, 255);
+	}
+
+	void test_linear_mono() {
+		mixTestTemplate(11025, 22050, false, false, 64, 256);
+	}
+
+	void test_sinc_medium_stereo() {
+		mixTestTemplate(22050, 48000, true, false, 256, 77, Audio::kRateConverterMedium);
+	}
+
+	void test_sinc_high_mono() {
+		mixTestTemplate(11127, 44100, false, false, 150, 256, Audio::kRateConverterHigh);
+	}
+
+	void test_sinc_high_downsample() {
+		mixTestTemplate(48000, 22050, true, true, 256, 256, Audio::kRateConverterHigh);
+	}
+
+	void test_sinc_dc_upsample() {
+		sincDCTestTemplate(22050, 48000, Audio::kRateConverterMedium);
+	}
+
+	void test_sinc_dc_downsample() {
+		sincDCTestTemplate(44100, 11025, Audio::kRateConverterHigh);
+	}
+
+	void test_clamp_mix_buffer() {
+		const Audio::st_mix_t mix[11] = { 0, 1, -1, 32767, 32768, -32768, -32769, 100000, -100000, 1234, -4321 };
+		const int16 expected[11] = { 0, 1, -1, 32767, 32767, -32768, -32768, 32767, -32768, 1234, -4321 };
+		int16 out[11];
+
+		Audio::clampMixBuffer(out, mix, 11);
+		for (int i = 0; i < 11; ++i) {
+#ifdef OUTPUT_UNSIGNED_AUDIO
+			TS_ASSERT_EQUALS(out[i], (int16)(expected[i] ^ 0x8000));
+#else
+			TS_ASSERT_EQUALS(out[i], expected[i]);
+#endif
+		}
+	}
+};
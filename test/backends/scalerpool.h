@@ -0,0 +1,70 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+
+#if defined(SDL_BACKEND) && defined(USE_SCALERS)
+#include "backends/graphics/surfacesdl/surfacesdl-scalerpool.h"
+#include "graphics/scaler/sai.h"
+#endif
+
+class ScalerPoolTestSuite : public CxxTest::TestSuite {
+#if defined(SDL_BACKEND) && defined(USE_SCALERS)
+private:
+	static const int kWidth = 320;
+	static const int kHeight = 200;
+	// The scalers read up to two pixels around the rect
+	static const int kPadding = 4;
+
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	/**
+	 * Scale a random 16-bit screen with 2xSaI on a pool of the given number
+	 * of threads, one rect at a time like the SDL backend does.
+	 */
+	void scaleScreen(int numThreads, Common::Array<uint16> &dst) {
+		const Graphics::PixelFormat format(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		const int srcPitch = (kWidth + kPadding * 2) * 2;
+		Common::Array<uint16> src((kWidth + kPadding * 2) * (kHeight + kPadding * 2));
+		_seed = 1;
+		for (uint i = 0; i < src.size(); i++)
+			src[i] = nextRandom();
+
+		const int dstPitch = kWidth * 2 * 2;
+		dst.resize(kWidth * 2 * kHeight * 2);
+		for (uint i = 0; i < dst.size(); i++)
+			dst[i] = 0;
+
+		SdlScalerThreadPool pool(numThreads);
+		TS_ASSERT_EQUALS(pool.getNumThreads(), numThreads);
+
+		SAIScaler scaler(format);
+		const uint8 *srcOrigin = (const uint8 *)&src[kPadding * (kWidth + kPadding * 2) + kPadding];
+		uint8 *dstOrigin = (uint8 *)dst.begin();
+
+		// The whole screen, then rects of various sizes, some of them
+		// smaller than a band
+		static const int rects[][4] = {
+			{ 0, 0, kWidth, kHeight }, { 10, 7, 100, 150 }, { 200, 33, 120, 40 },
+			{ 5, 180, 300, 20 }, { 160, 100, 1, 1 }, { 0, 50, kWidth, 17 }
+		};
+		for (int i = 0; i < ARRAYSIZE(rects); i++) {
+			const int x = rects[i][0], y = rects[i][1];
+			pool.scale(&scaler, srcOrigin + y * srcPitch + x * 2, srcPitch,
+			           dstOrigin + y * 2 * dstPitch + x * 2 * 2, dstPitch, rects[i][2], rects[i][3], x, y);
+		}
+	}
+
+public:
+	void test_pooled_scaling_matches_single_thread() {
+		Common::Array<uint16> single, pooled;
+		scaleScreen(1, single);
+		scaleScreen(4, pooled);
+		TS_ASSERT_EQUALS(memcmp(single.begin(), pooled.begin(), single.size() * sizeof(uint16)), 0);
+	}
+#endif
+};
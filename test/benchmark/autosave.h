@@ -0,0 +1,85 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/chunked-save.h"
+#include "common/debug.h"
+#include "common/memstream.h"
+#include "common/system.h"
+#include "common/zlib.h"
+
+#include "../null_osystem.h"
+
+class AutosaveBenchmarkSuite : public CxxTest::TestSuite
+{
+	static const uint32 kSaveSize = 8 * 1024 * 1024;
+	// The time DefaultSaveFileManager spends encoding per event poll
+	static const uint32 kEncodeMillis = 2;
+
+	static void fillSave(Common::Array<byte> &data) {
+		data.resize(kSaveSize);
+		for (uint32 i = 0; i < kSaveSize; i++)
+			data[i] = (i % 7 == 0) ? (byte)(i * 13 >> 8) : (byte)(i / 1024);
+	}
+
+	/**
+	 * Save the data like DefaultSaveFileManager does with chunked saves,
+	 * and measure the time spent when the savefile is written, the longest
+	 * event poll afterwards and the total time spent.
+	 */
+	static void chunkedSave(const Common::Array<byte> &data, Common::SaveChunkList &chunks, uint32 &saveTime, uint32 &maxPollTime, uint32 &totalTime) {
+		uint32 start = g_system->getMillis();
+		Common::ChunkedSaveWriter writer(&chunks);
+		writer.write(data.begin(), data.size());
+		writer.finalize();
+		saveTime = g_system->getMillis() - start;
+		totalTime = saveTime;
+
+		maxPollTime = 0;
+		while (!writer.isEncoded()) {
+			start = g_system->getMillis();
+			while (writer.encodeChunk()) {
+				if (g_system->getMillis() - start >= kEncodeMillis)
+					break;
+			}
+			const uint32 pollTime = g_system->getMillis() - start;
+			maxPollTime = MAX(maxPollTime, pollTime);
+			totalTime += pollTime;
+		}
+
+		start = g_system->getMillis();
+		Common::MemoryWriteStreamDynamic file(DisposeAfterUse::YES);
+		TS_ASSERT(writer.writeContainer(file));
+		writer.takeChunks(chunks);
+		const uint32 writeTime = g_system->getMillis() - start;
+		maxPollTime = MAX(maxPollTime, writeTime);
+		totalTime += writeTime;
+	}
+
+public:
+	void test_autosave_latency() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(USE_ZLIB)
+		Common::install_null_g_system();
+
+		Common::Array<byte> data;
+		fillSave(data);
+
+		uint32 start = g_system->getMillis();
+		Common::WriteStream *gzip = Common::wrapCompressedWriteStream(new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES));
+		gzip->write(data.begin(), data.size());
+		gzip->finalize();
+		delete gzip;
+		const uint32 gzipTime = g_system->getMillis() - start;
+
+		Common::SaveChunkList chunks;
+		uint32 saveTime, maxPollTime, totalTime;
+		chunkedSave(data, chunks, saveTime, maxPollTime, totalTime);
+		debug("Autosave of %u KB: gzip stream %u ms, chunked %u ms when saving, at most %u ms per poll, %u ms total",
+			kSaveSize / 1024, gzipTime, saveTime, maxPollTime, totalTime);
+
+		// The next autosave changes a single chunk
+		data[kSaveSize / 2] ^= 0xFF;
+		chunkedSave(data, chunks, saveTime, maxPollTime, totalTime);
+		debug("Autosave of %u KB, one chunk changed: chunked %u ms when saving, at most %u ms per poll, %u ms total",
+			kSaveSize / 1024, saveTime, maxPollTime, totalTime);
+#endif
+	}
+};
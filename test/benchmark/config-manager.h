@@ -0,0 +1,98 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/config-manager.h"
+#include "common/debug.h"
+#include "common/hash-str.h"
+#include "common/system.h"
+
+#include "../null_osystem.h"
+
+class ConfigManagerBenchmarkSuite : public CxxTest::TestSuite
+{
+	// The domains as they were stored before config keys were interned
+	struct StringDomains {
+		Common::StringMap transient, active, app, defaults;
+
+		const Common::String &get(const Common::String &key) const {
+			if (transient.contains(key))
+				return transient[key];
+			else if (active.contains(key))
+				return active[key];
+			else if (app.contains(key))
+				return app[key];
+			return defaults.getValOrDefault(key);
+		}
+	};
+
+public:
+	void test_get() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// Keys an engine typically asks for, a few of which are in no domain
+		const char *const keys[] = {
+			"music_volume", "sfx_volume", "speech_volume", "mute", "subtitles",
+			"talkspeed", "speech_mute", "music_driver", "gfx_mode", "fullscreen",
+			"aspect_ratio", "render_mode", "language", "platform", "path",
+			"extrapath", "save_slot", "autosave_period", "enable_gs", "native_mt32",
+			"multi_midi", "midi_gain", "copy_protection", "original_gui", "enable_cd",
+			"not_in_any_domain", "another_missing_key", "Music_Volume", "TALKSPEED", "debuglevel"
+		};
+		const int numKeys = ARRAYSIZE(keys);
+
+		StringDomains strings;
+		ConfMan.addGameDomain("benchmark-game");
+		ConfMan.setActiveDomain("benchmark-game");
+		for (int i = 0; i < numKeys - 5; i++) {
+			const Common::String value = Common::String::format("%d", i);
+			switch (i % 4) {
+			case 0:
+				ConfMan.registerDefault(keys[i], value);
+				strings.defaults[keys[i]] = value;
+				break;
+			case 1:
+				ConfMan.set(keys[i], value, ConfMan.kApplicationDomain);
+				strings.app[keys[i]] = value;
+				break;
+			case 2:
+				ConfMan.set(keys[i], value, "benchmark-game");
+				strings.active[keys[i]] = value;
+				break;
+			default:
+				ConfMan.set(keys[i], value, ConfMan.kTransientDomain);
+				strings.transient[keys[i]] = value;
+				break;
+			}
+		}
+
+		Common::String strKeys[ARRAYSIZE(keys)];
+		for (int i = 0; i < numKeys; i++) {
+			strKeys[i] = keys[i];
+			TS_ASSERT_EQUALS(ConfMan.get(strKeys[i]), strings.get(strKeys[i]));
+		}
+
+		const int rounds = 100000;
+		uint32 checksum = 0;
+		uint32 start = g_system->getMillis();
+		for (int i = 0; i < rounds; i++) {
+			for (int j = 0; j < numKeys; j++)
+				checksum += ConfMan.get(strKeys[j]).size();
+		}
+		const uint32 atomTime = g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		for (int i = 0; i < rounds; i++) {
+			for (int j = 0; j < numKeys; j++)
+				checksum -= strings.get(strKeys[j]).size();
+		}
+		const uint32 stringTime = g_system->getMillis() - start;
+		TS_ASSERT_EQUALS(checksum, 0u);
+
+		debug("ConfMan.get(): %u ms with interned keys, %u ms with String keys for %d lookups",
+			atomTime, stringTime, rounds * numKeys);
+
+		ConfMan.setActiveDomain("");
+		ConfMan.removeGameDomain("benchmark-game");
+#endif
+	}
+};
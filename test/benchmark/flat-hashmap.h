@@ -0,0 +1,105 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/debug.h"
+#include "common/flat-hashmap.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/system.h"
+
+#include "../null_osystem.h"
+
+class FlatHashMapBenchmarkSuite : public CxxTest::TestSuite
+{
+	struct Times {
+		uint32 insert, lookup, miss, erase;
+	};
+
+	/**
+	 * Insert the first half of the keys, look all of them up in a random
+	 * order, so half of the lookups miss, then erase the inserted keys, and
+	 * measure each step.
+	 */
+	template<class Map, class Key>
+	static Times run(const Common::Array<Key> &keys, int rounds, uint32 &checksum) {
+		Times times;
+		Map map;
+		const uint half = keys.size() / 2;
+
+		// Looking keys up in the order of insertion would walk through the
+		// nodes of HashMap in the order they were allocated
+		Common::Array<uint> order(half);
+		uint32 seed = 1;
+		for (uint i = 0; i < half; i++) {
+			seed = seed * 1103515245 + 12345;
+			const uint j = (seed >> 8) % (i + 1);
+			order[i] = order[j];
+			order[j] = i;
+		}
+
+		uint32 start = g_system->getMillis();
+		for (uint i = 0; i < half; i++)
+			map[keys[i]] = i;
+		times.insert = g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		for (int r = 0; r < rounds; r++) {
+			for (uint i = 0; i < half; i++)
+				checksum += map.getValOrDefault(keys[order[i]]);
+		}
+		times.lookup = g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		for (int r = 0; r < rounds; r++) {
+			for (uint i = 0; i < half; i++)
+				checksum += map.contains(keys[half + order[i]]);
+		}
+		times.miss = g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		for (uint i = 0; i < half; i++)
+			map.erase(keys[i]);
+		times.erase = g_system->getMillis() - start;
+
+		TS_ASSERT(map.empty());
+		return times;
+	}
+
+	template<class Key, class HashFunc, class EqualFunc>
+	static void compare(const char *name, const Common::Array<Key> &keys, int rounds) {
+		uint32 hashSum = 0, flatSum = 0;
+		const Times hash = run<Common::HashMap<Key, uint, HashFunc, EqualFunc> >(keys, rounds, hashSum);
+		const Times flat = run<Common::FlatHashMap<Key, uint, HashFunc, EqualFunc> >(keys, rounds, flatSum);
+		TS_ASSERT_EQUALS(hashSum, flatSum);
+
+		debug("%s, %u keys: insert %u / %u ms, %d lookups %u / %u ms, %d misses %u / %u ms, erase %u / %u ms (HashMap / FlatHashMap)",
+			name, keys.size() / 2, hash.insert, flat.insert, rounds * (int)(keys.size() / 2), hash.lookup, flat.lookup,
+			rounds * (int)(keys.size() / 2), hash.miss, flat.miss, hash.erase, flat.erase);
+	}
+
+public:
+	void test_flat_hashmap() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		uint32 seed = 1;
+		Common::Array<uint32> intKeys;
+		for (int i = 0; i < 2 * 1000000; i++) {
+			seed = seed * 1103515245 + 12345;
+			intKeys.push_back(seed);
+		}
+		compare<uint32, Common::Hash<uint32>, Common::EqualTo<uint32> >("uint32", intKeys, 5);
+
+		// Strings of the length of typical config keys and resource names
+		Common::Array<Common::String> strKeys;
+		for (int i = 0; i < 2 * 200000; i++)
+			strKeys.push_back(Common::String::format("resource_key_%u", i * 7919u));
+		compare<Common::String, Common::Hash<Common::String>, Common::EqualTo<Common::String> >("String", strKeys, 5);
+
+		// Small tables, like the domains of the config manager
+		Common::Array<Common::String> smallKeys;
+		for (int i = 0; i < 2 * 30; i++)
+			smallKeys.push_back(Common::String::format("config_key_%d", i));
+		compare<Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo>("String, ignoring case", smallKeys, 100000);
+#endif
+	}
+};
@@ -0,0 +1,91 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/debug.h"
+#include "common/fs.h"
+#include "common/memstream.h"
+#include "common/system.h"
+
+#include "../null_osystem.h"
+
+class MappedFileBenchmarkSuite : public CxxTest::TestSuite
+{
+	static const uint32 kFileSize = 128 * 1024 * 1024;
+	static const uint32 kPageSize = 4096;
+	static const int kRuns = 5;
+
+	/**
+	 * Load the whole file, like a resource manager does, and touch every
+	 * page of it. A stdio stream is read into a buffer, while the contents
+	 * of a mapped file are used in place.
+	 */
+	static uint32 loadFile(const Common::FSNode &node, bool mapped) {
+		const uint32 start = g_system->getMillis();
+		Common::SeekableReadStream *stream = mapped ? node.createMappedReadStream() : node.createReadStream();
+		TS_ASSERT(stream);
+		if (!stream)
+			return 0;
+
+		Common::MemoryReadStream *memoryStream = dynamic_cast<Common::MemoryReadStream *>(stream);
+		TS_ASSERT_EQUALS(memoryStream != nullptr, mapped);
+
+		byte *buffer = nullptr;
+		const byte *data;
+		if (memoryStream) {
+			data = memoryStream->getData();
+		} else {
+			buffer = (byte *)malloc(kFileSize);
+			stream->read(buffer, kFileSize);
+			data = buffer;
+		}
+
+		uint32 sum = 0;
+		for (uint32 i = 0; i < kFileSize; i += kPageSize)
+			sum += data[i];
+		TS_ASSERT_EQUALS(sum, kFileSize / kPageSize * 0x5A);
+
+		free(buffer);
+		delete stream;
+		return g_system->getMillis() - start;
+	}
+
+	static void benchmarkLoad(const char *name, const Common::String &path, bool mapped) {
+		const Common::FSNode node(path);
+		uint32 coldTime = 0, warmTime = 0;
+		bool cold = true;
+		for (int i = 0; i < kRuns; i++) {
+			cold = cold && Common::evictTestFileCache(path);
+			coldTime += loadFile(node, mapped);
+		}
+		for (int i = 0; i < kRuns; i++)
+			warmTime += loadFile(node, mapped);
+
+		if (cold)
+			debug("%s: %u MB, cold %u ms, warm %u ms", name, kFileSize / (1024 * 1024), coldTime / kRuns, warmTime / kRuns);
+		else
+			debug("%s: %u MB, %u ms", name, kFileSize / (1024 * 1024), warmTime / kRuns);
+	}
+
+public:
+	void test_mapped_file() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(HAS_MMAP)
+		Common::install_null_g_system();
+
+		const Common::String path = Common::getTestTempPath("scummvm-mapped-file-benchmark.dat");
+		Common::SeekableWriteStream *out = Common::FSNode(path).createWriteStream();
+		TS_ASSERT(out);
+		if (!out)
+			return;
+		byte *page = (byte *)malloc(kPageSize);
+		memset(page, 0x5A, kPageSize);
+		for (uint32 i = 0; i < kFileSize; i += kPageSize)
+			out->write(page, kPageSize);
+		free(page);
+		delete out;
+
+		benchmarkLoad("stdio, read into a buffer", path, false);
+		benchmarkLoad("mmap, used in place", path, true);
+
+		remove(path.c_str());
+#endif
+	}
+};
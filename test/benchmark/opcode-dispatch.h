@@ -0,0 +1,110 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/debug.h"
+#include "common/func.h"
+#include "common/system.h"
+
+#include "../null_osystem.h"
+
+/**
+ * Dispatch of script opcodes like the SCUMM engine does it: a table of 256
+ * handlers indexed by the opcode byte, with the functors it used before and
+ * the member function pointers it uses now, with and without the check of
+ * the opcode profiling flag.
+ */
+class OpcodeDispatchBenchmarkSuite : public CxxTest::TestSuite
+{
+	static const uint32 kScriptSize = 1 << 16;
+	static const uint32 kRuns = 1000;
+
+	class Interpreter;
+	typedef void (Interpreter::*Opcode)();
+
+	class Interpreter {
+	public:
+		Interpreter() : _value(0), _pos(0), _profileOpcodes(false) {
+			static const Opcode handlers[] = {
+				&Interpreter::opPush, &Interpreter::opAdd, &Interpreter::opXor, &Interpreter::opShift
+			};
+			for (int i = 0; i < 256; i++) {
+				_procs[i] = handlers[i % ARRAYSIZE(handlers)];
+				_functors[i] = new Common::Functor0Mem<void, Interpreter>(this, handlers[i % ARRAYSIZE(handlers)]);
+			}
+			memset(_opcodeCounts, 0, sizeof(_opcodeCounts));
+
+			uint32 seed = 1;
+			for (uint32 i = 0; i < kScriptSize; i++) {
+				seed = seed * 1103515245 + 12345;
+				_script[i] = seed >> 16;
+			}
+		}
+
+		~Interpreter() {
+			for (int i = 0; i < 256; i++)
+				delete _functors[i];
+		}
+
+		void executeFunctor(byte i) {
+			if (_functors[i]->isValid())
+				(*_functors[i])();
+		}
+
+		void executeProc(byte i) {
+			(this->*_procs[i])();
+		}
+
+		void executeProfiled(byte i) {
+			if (_profileOpcodes)
+				_opcodeCounts[i]++;
+			(this->*_procs[i])();
+		}
+
+		/** Run the script with one of the execute methods and return the time spent in ms. */
+		uint32 run(void (Interpreter::*execute)(byte)) {
+			_value = 0;
+			const uint32 start = g_system->getMillis();
+			for (uint32 run = 0; run < kRuns; run++) {
+				for (_pos = 0; _pos < kScriptSize; )
+					(this->*execute)(_script[_pos++]);
+			}
+			return g_system->getMillis() - start;
+		}
+
+		uint32 _value;
+		uint32 _pos;
+		bool _profileOpcodes;
+		uint32 _opcodeCounts[256];
+
+	private:
+		void opPush() { _value = _value * 31 + _pos; }
+		void opAdd() { _value += _script[_pos & (kScriptSize - 1)]; }
+		void opXor() { _value ^= _value >> 7; }
+		void opShift() { _value = (_value << 3) | (_value >> 29); }
+
+		Opcode _procs[256];
+		Common::Functor0<void> *_functors[256];
+		byte _script[kScriptSize];
+	};
+
+public:
+	void test_dispatch() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Interpreter *interpreter = new Interpreter();
+		const uint32 functorTime = interpreter->run(&Interpreter::executeFunctor);
+		const uint32 functorValue = interpreter->_value;
+		const uint32 procTime = interpreter->run(&Interpreter::executeProc);
+		TS_ASSERT_EQUALS(interpreter->_value, functorValue);
+		const uint32 unprofiledTime = interpreter->run(&Interpreter::executeProfiled);
+		interpreter->_profileOpcodes = true;
+		const uint32 profiledTime = interpreter->run(&Interpreter::executeProfiled);
+		TS_ASSERT_EQUALS(interpreter->_value, functorValue);
+
+		debug("Dispatching %u opcodes: functors %u ms, member pointers %u ms, "
+			"with profiling off %u ms, with profiling on %u ms",
+			kScriptSize * kRuns, functorTime, procTime, unprofiledTime, profiledTime);
+		delete interpreter;
+#endif
+	}
+};
@@ -0,0 +1,77 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/softsynth/opl/mame.h"
+
+#include "common/debug.h"
+#include "common/system.h"
+
+#include "../null_osystem.h"
+
+class OPLBenchmarkSuite : public CxxTest::TestSuite
+{
+	static const int kRate = 44100;
+	static const int kSeconds = 120;
+	// The number of samples EmulatedOPL renders per timer callback at 70 Hz
+	static const int kBlock = kRate / 70;
+
+	/**
+	 * Play notes on the given number of channels, with rhythm mode on or
+	 * off, and return the time spent rendering in ms.
+	 */
+	static uint32 render(int channels, bool rhythm) {
+		static const int slotOffsets[9] = { 0, 1, 2, 8, 9, 10, 16, 17, 18 };
+
+		OPL::MAME::FM_OPL *opl = OPL::MAME::makeAdLibOPL(kRate);
+		int16 *samples = new int16[kBlock];
+
+		OPL::MAME::OPLWriteReg(opl, 0x01, 0x20);
+		for (int ch = 0; ch < 9; ++ch) {
+			for (int op = 0; op < 2; ++op) {
+				const int slot = slotOffsets[ch] + op * 3;
+				OPL::MAME::OPLWriteReg(opl, 0x20 + slot, ((ch & 1) ? 0xE0 : 0x20) | (1 + ch % 4));
+				OPL::MAME::OPLWriteReg(opl, 0x40 + slot, op ? 0x00 : 0x10 + ch * 2);
+				OPL::MAME::OPLWriteReg(opl, 0x60 + slot, 0xF4);
+				OPL::MAME::OPLWriteReg(opl, 0x80 + slot, 0x24);
+				OPL::MAME::OPLWriteReg(opl, 0xE0 + slot, (ch + op) % 4);
+			}
+			OPL::MAME::OPLWriteReg(opl, 0xC0 + ch, ((ch % 8) << 1) | (ch & 1));
+		}
+		OPL::MAME::OPLWriteReg(opl, 0xBD, 0xC0 | (rhythm ? 0x3F : 0));
+
+		const uint32 start = g_system->getMillis();
+		for (int block = 0; block < kSeconds * 70; ++block) {
+			// A new note on every channel twice per second
+			if (block % 35 == 0) {
+				for (int ch = 0; ch < channels; ++ch) {
+					const int fnum = 0x200 + ((block / 35 + ch) * 37) % 0x100;
+					OPL::MAME::OPLWriteReg(opl, 0xB0 + ch, 0x00);
+					OPL::MAME::OPLWriteReg(opl, 0xA0 + ch, fnum & 0xFF);
+					OPL::MAME::OPLWriteReg(opl, 0xB0 + ch, 0x20 | (4 << 2) | (fnum >> 8));
+				}
+			}
+			OPL::MAME::YM3812UpdateOne(opl, samples, kBlock);
+		}
+		const uint32 time = g_system->getMillis() - start;
+
+		delete[] samples;
+		OPL::MAME::OPLDestroy(opl);
+		return time;
+	}
+
+public:
+	void test_mame_render() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// The best of three runs, to leave out the noise of other processes
+		uint32 full = 0xFFFFFFFF, rhythm = 0xFFFFFFFF, few = 0xFFFFFFFF;
+		for (int run = 0; run < 3; ++run) {
+			full = MIN(full, render(9, false));
+			rhythm = MIN(rhythm, render(6, true));
+			few = MIN(few, render(3, false));
+		}
+		debug("MAME OPL, %d s at %d Hz: 9 channels %u ms, 6 channels and rhythm %u ms, 3 channels %u ms",
+			kSeconds, kRate, full, rhythm, few);
+#endif
+	}
+};
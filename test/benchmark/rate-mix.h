@@ -0,0 +1,91 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+#include "audio/decoders/raw.h"
+
+#include "common/debug.h"
+#include "common/system.h"
+
+#include "../null_osystem.h"
+
+class RateMixBenchmarkSuite : public CxxTest::TestSuite
+{
+	static const uint32 kRate = 44100;
+	static const uint32 kSeconds = 600;
+	// The number of sample pairs the mixer requests per callback
+	static const uint32 kChunk = 1024;
+
+	/**
+	 * Mix the samples into 32-bit accumulators like the mixer does, with the
+	 * vectorized or the scalar code, and return the time spent in ms.
+	 */
+	static uint32 mix(const int16 *data, uint32 samples, bool stereo, bool useSIMD, int64 &checksum) {
+		Audio::setUseSIMDMixing(useSIMD);
+
+		byte flags = Audio::FLAG_16BITS;
+#ifdef SCUMM_LITTLE_ENDIAN
+		flags |= Audio::FLAG_LITTLE_ENDIAN;
+#endif
+		if (stereo)
+			flags |= Audio::FLAG_STEREO;
+		Audio::SeekableAudioStream *stream = Audio::makeRawStream((const byte *)data, samples * sizeof(int16), kRate, flags, DisposeAfterUse::NO);
+		Audio::RateConverter *conv = Audio::makeRateConverter(kRate, kRate, stereo);
+
+		Audio::st_mix_t *mixBuf = new Audio::st_mix_t[kChunk * 2];
+		int16 *outBuf = new int16[kChunk * 2];
+
+		checksum = 0;
+		const uint32 start = g_system->getMillis();
+		for (;;) {
+			memset(mixBuf, 0, kChunk * 2 * sizeof(Audio::st_mix_t));
+			// Different volumes for both sides, like a panned channel
+			const int res = conv->flow(*stream, mixBuf, kChunk, 200, 97);
+			Audio::clampMixBuffer(outBuf, mixBuf, res * 2);
+			for (int i = 0; i < res * 2; i += 64)
+				checksum += outBuf[i];
+			if (res < (int)kChunk)
+				break;
+		}
+		const uint32 time = g_system->getMillis() - start;
+
+		delete[] mixBuf;
+		delete[] outBuf;
+		delete conv;
+		delete stream;
+
+		Audio::setUseSIMDMixing(true);
+		return time;
+	}
+
+	static void benchmark(const int16 *data, uint32 samples, bool stereo) {
+		int64 scalarSum, simdSum;
+		const uint32 scalarTime = mix(data, samples, stereo, false, scalarSum);
+		const uint32 simdTime = mix(data, samples, stereo, true, simdSum);
+		TS_ASSERT_EQUALS(scalarSum, simdSum);
+
+		debug("Mixing %u s of %s audio: scalar %u ms, vectorized %u ms",
+			kSeconds, stereo ? "stereo" : "mono", scalarTime, simdTime);
+	}
+
+public:
+	void test_mix_block() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		const uint32 samples = kRate * kSeconds * 2;
+		int16 *data = new int16[samples];
+		uint32 seed = 1;
+		for (uint32 i = 0; i < samples; i++) {
+			seed = seed * 1103515245 + 12345;
+			data[i] = (int16)(seed >> 16);
+		}
+
+		benchmark(data, samples / 2, false);
+		benchmark(data, samples, true);
+
+		delete[] data;
+#endif
+	}
+};
@@ -0,0 +1,84 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/debug.h"
+#include "common/memstream.h"
+#include "common/substream.h"
+#include "common/system.h"
+
+#include "../null_osystem.h"
+
+class SharedBufferBenchmarkSuite : public CxxTest::TestSuite
+{
+	static const uint32 kStreamSize = 4 * 1024 * 1024;
+	static const uint32 kSliceSize = 1024;
+
+	/**
+	 * Count the bytes of the slices which were copied from the data instead
+	 * of pointing into it.
+	 */
+	static uint32 copiedBytes(const Common::Array<Common::SeekableReadStream *> &slices, const byte *data) {
+		uint32 copied = 0;
+		for (uint32 i = 0; i < slices.size(); i++) {
+			const Common::MemoryReadStream *slice = dynamic_cast<const Common::MemoryReadStream *>(slices[i]);
+			if (!slice || slice->getData() < data || slice->getData() >= data + kStreamSize)
+				copied += slices[i]->size();
+		}
+		return copied;
+	}
+
+	/**
+	 * Cut the stream into slices with readStream(), directly and through
+	 * a SeekableSubReadStream, and report the bytes copied and the time.
+	 */
+	static void sliceStream(const char *name, Common::SeekableReadStream &stream, const byte *data) {
+		const uint32 count = stream.size() / kSliceSize;
+		Common::Array<Common::SeekableReadStream *> slices;
+		slices.reserve(count);
+
+		stream.seek(0);
+		uint32 start = g_system->getMillis();
+		for (uint32 i = 0; i < count; i++)
+			slices.push_back(stream.readStream(kSliceSize));
+		const uint32 time = g_system->getMillis() - start;
+		const uint32 copied = copiedBytes(slices, data);
+
+		for (uint32 i = 0; i < count; i++) {
+			TS_ASSERT_EQUALS(slices[i]->size(), (int64)kSliceSize);
+			delete slices[i];
+		}
+		slices.clear();
+		slices.reserve(count);
+
+		stream.seek(0);
+		Common::SeekableSubReadStream subStream(&stream, 0, stream.size());
+		start = g_system->getMillis();
+		for (uint32 i = 0; i < count; i++)
+			slices.push_back(subStream.readStream(kSliceSize));
+		const uint32 subTime = g_system->getMillis() - start;
+		const uint32 subCopied = copiedBytes(slices, data);
+
+		for (uint32 i = 0; i < count; i++)
+			delete slices[i];
+
+		debug("%s: %u slices, %u KB copied in %u ms, through a substream %u KB copied in %u ms",
+			name, count, copied / 1024, time, subCopied / 1024, subTime);
+	}
+
+public:
+	void test_read_stream() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		byte *data = (byte *)malloc(kStreamSize);
+		for (uint32 i = 0; i < kStreamSize; i++)
+			data[i] = (byte)(i * 7);
+
+		Common::MemoryReadStream memoryStream(data, kStreamSize);
+		sliceStream("MemoryReadStream", memoryStream, data);
+
+		// Takes over the data
+		Common::SharedBufferReadStream sharedStream(data, kStreamSize);
+		sliceStream("SharedBufferReadStream", sharedStream, data);
+#endif
+	}
+};
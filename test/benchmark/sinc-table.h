@@ -0,0 +1,44 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/rate.h"
+
+#include "common/debug.h"
+#include "common/system.h"
+
+#include "../null_osystem.h"
+
+class SincTableBenchmarkSuite : public CxxTest::TestSuite
+{
+	static const int kConverters = 200;
+
+	/**
+	 * Create and delete sinc converters one after the other, and return the
+	 * time spent in ms. Unless another converter holds on to it, the filter
+	 * table is computed again every time.
+	 */
+	static uint32 createConverters(Audio::RateConverterQuality quality) {
+		const uint32 start = g_system->getMillis();
+		for (int i = 0; i < kConverters; i++)
+			delete Audio::makeRateConverter(22050, 44100, true, false, quality);
+		return g_system->getMillis() - start;
+	}
+
+public:
+	void test_sinc_table_setup() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		const Audio::RateConverterQuality qualities[] = { Audio::kRateConverterMedium, Audio::kRateConverterHigh };
+		for (int i = 0; i < ARRAYSIZE(qualities); i++) {
+			const uint32 computedTime = createConverters(qualities[i]);
+
+			Audio::RateConverter *playing = Audio::makeRateConverter(22050, 44100, true, false, qualities[i]);
+			const uint32 sharedTime = createConverters(qualities[i]);
+			delete playing;
+
+			debug("%d sinc converters with %d taps: %u ms with the table computed, %u ms with the table shared",
+				kConverters, qualities[i] == Audio::kRateConverterHigh ? 32 : 16, computedTime, sharedTime);
+		}
+#endif
+	}
+};
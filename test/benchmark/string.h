@@ -0,0 +1,79 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/debug.h"
+#include "common/str.h"
+#include "common/system.h"
+
+#include "../null_osystem.h"
+
+class StringBenchmarkSuite : public CxxTest::TestSuite
+{
+	/** Return whether the characters of a string are stored on the heap. */
+	static bool isOnHeap(const Common::String &str) {
+		const char *data = str.c_str();
+		return data < (const char *)&str || data >= (const char *)(&str + 1);
+	}
+
+	/**
+	 * Strings like an engine creates: config keys, file names of game data
+	 * and saves, paths and messages.
+	 */
+	static void createStrings(Common::Array<Common::String> &strings) {
+		static const char *const keys[] = {
+			"music_volume", "sfx_volume", "speech_volume", "subtitles", "talkspeed",
+			"autosave_period", "native_mt32", "original_gui", "gfx_mode", "render_mode"
+		};
+		for (int i = 0; i < 1000; i++) {
+			strings.push_back(keys[i % ARRAYSIZE(keys)]);
+			strings.push_back(Common::String::format("MONKEY%d.%03d", 1 + i % 2, i % 100));
+			strings.push_back(Common::String::format("monkey2-%d.s%02d", i % 3, i % 100));
+			strings.push_back(Common::String::format("Resource %d of room %d", i % 200, i % 90));
+			strings.push_back(Common::String::format("engines/scumm/data/%d/costume%04d.bin", i % 10, i));
+			strings.push_back(Common::String::format("/home/user/.local/share/scummvm/saves/monkey2.s%02d", i % 100));
+		}
+	}
+
+public:
+	void test_string_storage() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Array<Common::String> strings;
+		createStrings(strings);
+
+		uint heapStrings = 0;
+		for (uint i = 0; i < strings.size(); i++)
+			heapStrings += isOnHeap(strings[i]);
+
+		// Copies, assignments and appends, as done when passing around
+		// names and building paths
+		const int rounds = 500;
+		uint32 checksum = 0;
+		uint32 start = g_system->getMillis();
+		for (int r = 0; r < rounds; r++) {
+			for (uint i = 0; i < strings.size(); i++) {
+				Common::String copy(strings[i]);
+				Common::String path = "saves/";
+				path += copy;
+				path += ".bak";
+				checksum += path.size() + copy.size();
+			}
+		}
+		const uint32 copyTime = g_system->getMillis() - start;
+
+		// Growing arrays of strings, where the object size matters
+		start = g_system->getMillis();
+		for (int r = 0; r < rounds / 10; r++) {
+			Common::Array<Common::String> array;
+			for (uint i = 0; i < strings.size(); i++)
+				array.push_back(strings[i]);
+			checksum += array.size();
+		}
+		const uint32 arrayTime = g_system->getMillis() - start;
+
+		debug("String (%u bytes): %u of %u strings on the heap, copies and appends %u ms, array growth %u ms (checksum %u)",
+			(uint)sizeof(Common::String), heapStrings, strings.size(), copyTime, arrayTime, checksum);
+#endif
+	}
+};
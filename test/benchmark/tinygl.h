@@ -0,0 +1,106 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/debug.h"
+#include "common/system.h"
+
+#include "../null_osystem.h"
+
+#ifdef USE_TINYGL
+#include "graphics/tinygl/tinygl.h"
+#include "graphics/tinygl/zgl.h"
+#endif
+
+class TinyGLBenchmarkSuite : public CxxTest::TestSuite
+{
+#ifdef USE_TINYGL
+	static const int kWidth = 640;
+	static const int kHeight = 480;
+	static const int kFrames = 200;
+
+	/**
+	 * Render frames of large overlapping triangles, with or without a
+	 * nearest-sampled texture and blending, and return the time spent in ms.
+	 */
+	static uint32 render(bool textured, bool blended, bool useSIMD) {
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 0, 8, 16, 24);
+		TinyGL::createContext(kWidth, kHeight, format, 256, false, false);
+		TinyGL::gl_get_context()->fb->setUseSIMD(useSIMD);
+
+		byte texels[64 * 64 * 4];
+		for (int i = 0; i < 64 * 64; i++) {
+			texels[i * 4 + 0] = i;
+			texels[i * 4 + 1] = 255 - i;
+			texels[i * 4 + 2] = (i % 64) * 4;
+			texels[i * 4 + 3] = 255;
+		}
+		TGLuint texture;
+		tglGenTextures(1, &texture);
+		tglBindTexture(TGL_TEXTURE_2D, texture);
+		tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_MIN_FILTER, TGL_NEAREST);
+		tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_MAG_FILTER, TGL_NEAREST);
+		tglTexImage2D(TGL_TEXTURE_2D, 0, TGL_RGBA, 64, 64, 0, TGL_RGBA, TGL_UNSIGNED_BYTE, texels);
+
+		const uint32 start = g_system->getMillis();
+		for (int frame = 0; frame < kFrames; frame++) {
+			tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+			tglMatrixMode(TGL_PROJECTION);
+			tglLoadIdentity();
+			tglOrtho(0, kWidth, kHeight, 0, -10, 10);
+			tglMatrixMode(TGL_MODELVIEW);
+			tglLoadIdentity();
+
+			tglEnable(TGL_DEPTH_TEST);
+			tglShadeModel(TGL_SMOOTH);
+			if (textured)
+				tglEnable(TGL_TEXTURE_2D);
+			if (blended) {
+				tglEnable(TGL_BLEND);
+				tglBlendFunc(TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA);
+			}
+
+			tglBegin(TGL_TRIANGLES);
+			for (int i = 0; i < 16; i++) {
+				const float x = (float)((i * 97 + frame) % kWidth) - 200.0f;
+				const float y = (float)((i * 61) % kHeight) - 150.0f;
+				tglColor4f(1.0f, (i % 3) / 2.0f, 0.5f, 0.75f);
+				tglTexCoord2f(0.0f, 0.0f);
+				tglVertex3f(x, y, (float)(i % 7) - 3.0f);
+				tglColor4f(0.25f, 1.0f, 1.0f, 0.5f);
+				tglTexCoord2f(4.0f, 0.5f);
+				tglVertex3f(x + 500.0f, y + 50.0f, 2.0f);
+				tglColor4f(0.5f, 0.25f, 1.0f, 1.0f);
+				tglTexCoord2f(1.0f, 3.0f);
+				tglVertex3f(x + 100.0f, y + 400.0f, -2.0f);
+			}
+			tglEnd();
+
+			tglDisable(TGL_BLEND);
+			tglDisable(TGL_TEXTURE_2D);
+			TinyGL::presentBuffer();
+		}
+		const uint32 time = g_system->getMillis() - start;
+
+		tglDeleteTextures(1, &texture);
+		TinyGL::destroyContext();
+		return time;
+	}
+
+	static void benchmark(const char *name, bool textured, bool blended) {
+		const uint32 scalarTime = render(textured, blended, false);
+		const uint32 simdTime = render(textured, blended, true);
+		debug("Rendering %d frames of %s triangles: scalar %u ms, vectorized %u ms",
+			kFrames, name, scalarTime, simdTime);
+	}
+#endif
+
+public:
+	void test_spans() {
+#if defined(USE_TINYGL) && NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		benchmark("smooth shaded", false, false);
+		benchmark("textured", true, false);
+		benchmark("textured and blended", true, true);
+#endif
+	}
+};
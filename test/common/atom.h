@@ -0,0 +1,79 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/atom.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+
+class AtomTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_interning() {
+		Common::Atom a("atom_test_key");
+		Common::Atom b(Common::String("atom_test_key"));
+		Common::Atom c("atom_test_other_key");
+
+		TS_ASSERT(a == b);
+		TS_ASSERT(a != c);
+		TS_ASSERT(!a.isNull());
+		TS_ASSERT_EQUALS(a.str(), "atom_test_key");
+		TS_ASSERT_EQUALS(c.str(), "atom_test_other_key");
+		TS_ASSERT_EQUALS(a.hash(), Common::hashit_lower("atom_test_key"));
+	}
+
+	void test_case_insensitive() {
+		Common::Atom a("Atom_Test_Mixed");
+		Common::Atom b("ATOM_TEST_MIXED");
+
+		// Each atom keeps its own spelling
+		TS_ASSERT(a == b);
+		TS_ASSERT_EQUALS(a.str(), "Atom_Test_Mixed");
+		TS_ASSERT_EQUALS(b.str(), "ATOM_TEST_MIXED");
+		TS_ASSERT_EQUALS(a.hash(), b.hash());
+
+		// A spelling which was never interned finds the first one
+		Common::Atom c;
+		TS_ASSERT(Common::Atom::find("atom_test_MIXED", c));
+		TS_ASSERT(c == a);
+		TS_ASSERT_EQUALS(c.str(), "Atom_Test_Mixed");
+	}
+
+	void test_find() {
+		Common::Atom atom;
+		TS_ASSERT(atom.isNull());
+		TS_ASSERT(atom.str().empty());
+
+		// Looking up a string must not intern it
+		TS_ASSERT(!Common::Atom::find("atom_test_never_interned", atom));
+		TS_ASSERT(atom.isNull());
+		TS_ASSERT(!Common::Atom::find("atom_test_never_interned", atom));
+
+		Common::Atom interned("atom_test_interned");
+		TS_ASSERT(Common::Atom::find("ATOM_TEST_INTERNED", atom));
+		TS_ASSERT(atom == interned);
+	}
+
+	void test_hashmap_key() {
+		Common::HashMap<Common::Atom, int> map;
+		map[Common::Atom("atom_test_one")] = 1;
+		map[Common::Atom("atom_test_two")] = 2;
+
+		TS_ASSERT_EQUALS(map.size(), 2u);
+		TS_ASSERT_EQUALS(map[Common::Atom("ATOM_TEST_ONE")], 1);
+		TS_ASSERT_EQUALS(map[Common::Atom("atom_test_two")], 2);
+		TS_ASSERT(!map.contains(Common::Atom()));
+
+		// The map keeps the spelling of the key it was given first
+		map[Common::Atom("ATOM_TEST_TWO")] = 3;
+		TS_ASSERT_EQUALS(map.size(), 2u);
+		TS_ASSERT_EQUALS(map[Common::Atom("atom_test_two")], 3);
+
+		Common::HashMap<Common::Atom, int> other;
+		other[Common::Atom("ATOM_TEST_TWO")] = 4;
+		other[Common::Atom("atom_test_two")] = 5;
+		TS_ASSERT_EQUALS(other.begin()->_key.str(), "ATOM_TEST_TWO");
+		for (Common::HashMap<Common::Atom, int>::const_iterator i = map.begin(); i != map.end(); ++i) {
+			if (i->_value == 3)
+				TS_ASSERT_EQUALS(i->_key.str(), "atom_test_two");
+		}
+	}
+};
@@ -0,0 +1,125 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/chunked-save.h"
+#include "common/memstream.h"
+
+class ChunkedSaveTestSuite : public CxxTest::TestSuite
+{
+	static const uint32 kChunkSize = Common::ChunkedSaveWriter::kChunkSize;
+
+	static void fillSave(Common::Array<byte> &data, uint32 size, uint seed) {
+		data.resize(size);
+		for (uint32 i = 0; i < size; i++)
+			data[i] = (i % 7 == 0) ? (byte)(i * seed >> 8) : (byte)(i / 1024);
+	}
+
+	static bool writeSave(const Common::Array<byte> &data, Common::SaveChunkList &chunks, Common::MemoryWriteStreamDynamic &out, uint *reusedChunks = nullptr) {
+		Common::ChunkedSaveWriter writer(&chunks);
+		writer.write(data.begin(), data.size());
+		writer.finalize();
+		if (!writer.writeContainer(out))
+			return false;
+		if (reusedChunks)
+			*reusedChunks = writer.getReusedChunks();
+		writer.takeChunks(chunks);
+		return true;
+	}
+
+	static bool readSave(Common::MemoryWriteStreamDynamic &out, const Common::Array<byte> &expected) {
+		Common::SeekableReadStream *stream = Common::wrapChunkedReadStream(new Common::MemoryReadStream(out.getData(), out.size()));
+		if (!stream)
+			return false;
+
+		bool result = stream->size() == (int64)expected.size();
+		for (uint32 i = 0; i < expected.size() && result; i++)
+			result = stream->readByte() == expected[i];
+		delete stream;
+		return result;
+	}
+
+public:
+	void test_roundtrip() {
+		const uint32 sizes[] = { 0, 1, 1000, kChunkSize, kChunkSize + 1, 3 * kChunkSize + 12345 };
+		for (int i = 0; i < ARRAYSIZE(sizes); i++) {
+			Common::Array<byte> data;
+			fillSave(data, sizes[i], i + 1);
+
+			Common::SaveChunkList chunks;
+			Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+			TS_ASSERT(writeSave(data, chunks, out));
+			TS_ASSERT_EQUALS(chunks.size(), (sizes[i] + kChunkSize - 1) / kChunkSize);
+			TS_ASSERT(readSave(out, data));
+		}
+	}
+
+	void test_unchanged_chunks() {
+		Common::Array<byte> data;
+		fillSave(data, 5 * kChunkSize + 100, 3);
+
+		Common::SaveChunkList chunks;
+		Common::MemoryWriteStreamDynamic first(DisposeAfterUse::YES);
+		uint reused = 0;
+		TS_ASSERT(writeSave(data, chunks, first, &reused));
+		TS_ASSERT_EQUALS(reused, 0u);
+
+		// Only the changed chunk is encoded again
+		data[2 * kChunkSize + 10] ^= 0xFF;
+		Common::MemoryWriteStreamDynamic second(DisposeAfterUse::YES);
+		TS_ASSERT(writeSave(data, chunks, second, &reused));
+		TS_ASSERT_EQUALS(reused, 5u);
+		TS_ASSERT(readSave(second, data));
+
+		// So does a changed size of the last chunk
+		data.resize(data.size() - 1);
+		Common::MemoryWriteStreamDynamic third(DisposeAfterUse::YES);
+		TS_ASSERT(writeSave(data, chunks, third, &reused));
+		TS_ASSERT_EQUALS(reused, 5u);
+		TS_ASSERT(readSave(third, data));
+	}
+
+	void test_damaged_save() {
+		Common::Array<byte> data;
+		fillSave(data, 2 * kChunkSize, 5);
+
+		Common::SaveChunkList chunks;
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+		TS_ASSERT(writeSave(data, chunks, out));
+
+		out.getData()[out.size() - 5] ^= 0x01;
+		TS_ASSERT(!readSave(out, data));
+
+		TS_ASSERT(!Common::wrapChunkedReadStream(new Common::MemoryReadStream(out.getData(), out.size() - 5)));
+
+		// A stored size larger than the chunk is rejected before allocating it
+		out.getData()[out.size() - 5] ^= 0x01;
+		WRITE_LE_UINT32(out.getData() + 20, 0xFFFFFFF0);
+		TS_ASSERT(!readSave(out, data));
+	}
+
+	void test_errors() {
+		Common::Array<byte> data;
+		fillSave(data, kChunkSize + 10, 7);
+
+		// Writing past the end of the data fails
+		Common::ChunkedSaveWriter writer;
+		writer.write(data.begin(), data.size());
+		TS_ASSERT(!writer.err());
+		writer.finalize();
+		TS_ASSERT_EQUALS(writer.write(data.begin(), 1), 0u);
+		TS_ASSERT(writer.err());
+
+		// So does writing the container to a stream which runs out of space
+		byte buffer[64];
+		Common::MemoryWriteStream out(buffer, sizeof(buffer));
+		TS_ASSERT(!writer.writeContainer(out));
+	}
+
+	void test_other_streams() {
+		// Streams which aren't chunked saves are returned as they are
+		const byte raw[] = { 'S', 'C', 'H', 'X', 1, 2, 3 };
+		Common::SeekableReadStream *stream = new Common::MemoryReadStream(raw, sizeof(raw));
+		TS_ASSERT_EQUALS(Common::wrapChunkedReadStream(stream), stream);
+		TS_ASSERT_EQUALS(stream->pos(), 0);
+		delete stream;
+	}
+};
@@ -0,0 +1,52 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/fs.h"
+#include "common/memstream.h"
+
+#include "../null_osystem.h"
+
+class FileTestSuite : public CxxTest::TestSuite
+{
+public:
+	void test_mapped_file() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(HAS_MMAP)
+		Common::install_null_g_system();
+
+		const Common::String path = Common::getTestTempPath("scummvm-file-test.dat");
+		Common::FSNode node(path);
+		Common::SeekableWriteStream *out = node.createWriteStream();
+		TS_ASSERT(out);
+		if (!out)
+			return;
+		for (uint32 i = 0; i < 64 * 1024; ++i)
+			out->writeUint32LE(i);
+		delete out;
+
+		// Only the streams meant for game data are mapped into memory
+		Common::SeekableReadStream *in = node.createReadStream();
+		TS_ASSERT(!dynamic_cast<Common::MemoryReadStream *>(in));
+		delete in;
+
+		in = node.createMappedReadStream();
+		Common::MemoryReadStream *mapped = dynamic_cast<Common::MemoryReadStream *>(in);
+		TS_ASSERT(mapped);
+		TS_ASSERT_EQUALS(in->size(), 256 * 1024);
+		if (mapped)
+			TS_ASSERT_EQUALS(READ_LE_UINT32(mapped->getData() + 4000 * 4), 4000u);
+
+		in->seek(-8, SEEK_END);
+		TS_ASSERT_EQUALS(in->readUint32LE(), 64u * 1024 - 2);
+
+		// Seeking outside of the file fails instead of asserting
+		TS_ASSERT(!in->seek(1, SEEK_END));
+		TS_ASSERT_EQUALS(in->pos(), 256 * 1024 - 4);
+		TS_ASSERT_EQUALS(in->readUint32LE(), 64u * 1024 - 1);
+		TS_ASSERT(!in->eos());
+		in->readByte();
+		TS_ASSERT(in->eos());
+
+		delete in;
+		remove(path.c_str());
+#endif
+	}
+};
@@ -0,0 +1,197 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/flat-hashmap.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+
+class FlatHashMapTestSuite : public CxxTest::TestSuite
+{
+	typedef Common::FlatHashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> FlatStringMap;
+
+	/**
+	 * Apply the same pseudo-random sequence of insertions, lookups and
+	 * erasures to a HashMap and a FlatHashMap, and check that both always
+	 * agree on their content.
+	 */
+	template<class Key>
+	void compareWithHashMap(Key (*makeKey)(uint32), int numOps, uint32 keyRange) {
+		Common::HashMap<Key, int> reference;
+		Common::FlatHashMap<Key, int> container;
+		uint32 seed = 12345;
+
+		for (int i = 0; i < numOps; ++i) {
+			seed = seed * 1103515245 + 12345;
+			const Key key = makeKey((seed >> 8) % keyRange);
+
+			switch ((seed >> 28) % 4) {
+			case 0:
+			case 1:
+				reference[key] = i;
+				container[key] = i;
+				break;
+			case 2:
+				reference.erase(key);
+				container.erase(key);
+				break;
+			default:
+				TS_ASSERT_EQUALS(reference.contains(key), container.contains(key));
+				TS_ASSERT_EQUALS(reference.getValOrDefault(key, -1), container.getValOrDefault(key, -1));
+				break;
+			}
+
+			TS_ASSERT_EQUALS(reference.size(), container.size());
+		}
+
+		// Every element must be visited exactly once by the iterators
+		uint count = 0;
+		for (typename Common::FlatHashMap<Key, int>::const_iterator j = container.begin(); j != container.end(); ++j) {
+			TS_ASSERT(reference.contains(j->_key));
+			TS_ASSERT_EQUALS(reference[j->_key], j->_value);
+			count++;
+		}
+		TS_ASSERT_EQUALS(count, container.size());
+	}
+
+	static int makeIntKey(uint32 n) { return (int)(n * 16); }
+	static Common::String makeStringKey(uint32 n) { return Common::String::format("key%u", n); }
+
+	public:
+	void test_empty_clear() {
+		Common::FlatHashMap<int, int> container;
+		TS_ASSERT(container.empty());
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(!container.empty());
+		container.clear();
+		TS_ASSERT(container.empty());
+
+		FlatStringMap container2;
+		TS_ASSERT(container2.empty());
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(!container2.empty());
+		container2.clear(true);
+		TS_ASSERT(container2.empty());
+		TS_ASSERT(!container2.contains("foo"));
+	}
+
+	void test_contains() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(container.contains(0));
+		TS_ASSERT(container.contains(1));
+		TS_ASSERT(!container.contains(17));
+		TS_ASSERT(!container.contains(-1));
+
+		FlatStringMap container2;
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(container2.contains("foo"));
+		TS_ASSERT(container2.contains("QUUX"));
+		TS_ASSERT(!container2.contains("bar"));
+		TS_ASSERT(!container2.contains("asdf"));
+	}
+
+	void test_add_remove_iterator() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		TS_ASSERT(container.contains(1));
+		container.erase(container.find(1));
+		TS_ASSERT(!container.contains(1));
+		container[1] = 42;
+		TS_ASSERT_EQUALS(container[1], 42);
+		container.erase(container.find(0));
+		container.erase(container.find(1));
+		container.erase(2);
+		TS_ASSERT(container.empty());
+		TS_ASSERT_EQUALS(container.find(2), container.end());
+	}
+
+	void test_lookup_with_default() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = -1;
+
+		const Common::FlatHashMap<int, int> &containerRef = container;
+
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(0), 17);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(17), 0);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(1, -10), -1);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(17, -10), -10);
+
+		int val = 0;
+		TS_ASSERT(containerRef.tryGetVal(1, val));
+		TS_ASSERT_EQUALS(val, -1);
+		TS_ASSERT(!containerRef.tryGetVal(2, val));
+	}
+
+	void test_iterator_begin_end() {
+		Common::FlatHashMap<int, int> container;
+
+		// The container is initially empty ...
+		TS_ASSERT_EQUALS(container.begin(), container.end());
+
+		// ... then non-empty ...
+		container[324] = 33;
+		TS_ASSERT_DIFFERS(container.begin(), container.end());
+
+		// ... and again empty.
+		container.clear();
+		TS_ASSERT_EQUALS(container.begin(), container.end());
+	}
+
+	void test_copy() {
+		FlatStringMap map1, map2;
+		for (int i = 0; i < 100; ++i)
+			map1[Common::String::format("%d", i)] = Common::String::format("value %d", i);
+		map1.erase("50");
+
+		map2 = map1;
+		FlatStringMap map3(map1);
+		map1.clear();
+
+		TS_ASSERT_EQUALS(map2.size(), 99u);
+		TS_ASSERT_EQUALS(map3.size(), 99u);
+		TS_ASSERT_EQUALS(map2["42"], "value 42");
+		TS_ASSERT_EQUALS(map3["99"], "value 99");
+		TS_ASSERT(!map3.contains("50"));
+	}
+
+	void test_growth() {
+		// Consecutive keys must be spread over the groups, and the storage
+		// has to grow several times
+		Common::FlatHashMap<uint, uint> container;
+		for (uint i = 0; i < 10000; ++i)
+			container[i] = i * 3;
+
+		TS_ASSERT_EQUALS(container.size(), 10000u);
+		for (uint i = 0; i < 10000; ++i)
+			TS_ASSERT_EQUALS(container.getValOrDefault(i, 0), i * 3);
+		TS_ASSERT(!container.contains(10000));
+	}
+
+	void test_erase_churn() {
+		// Repeatedly filling and erasing must not fill the table with
+		// deleted slots
+		Common::FlatHashMap<int, int> container;
+		for (int round = 0; round < 50; ++round) {
+			for (int i = 0; i < 100; ++i)
+				container[round * 100 + i] = i;
+			for (int i = 0; i < 100; ++i)
+				container.erase(round * 100 + i);
+		}
+		TS_ASSERT(container.empty());
+		TS_ASSERT_EQUALS(container.begin(), container.end());
+	}
+
+	void test_compare_int_keys() {
+		compareWithHashMap<int>(makeIntKey, 20000, 3000);
+	}
+
+	void test_compare_string_keys() {
+		compareWithHashMap<Common::String>(makeStringKey, 20000, 3000);
+	}
+};
@@ -0,0 +1,128 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/fs-index.h"
+#include "common/memstream.h"
+
+#include "../null_osystem.h"
+
+class FSIndexTestSuite : public CxxTest::TestSuite
+{
+	static bool writeFile(const Common::FSNode &node) {
+		Common::SeekableWriteStream *out = node.createWriteStream();
+		if (!out)
+			return false;
+		out->writeByte(0);
+		delete out;
+		return true;
+	}
+
+	static void removeTestDirectory(const Common::String &path) {
+		remove((path + "/a.dat").c_str());
+		remove((path + "/b.dat").c_str());
+		remove(path.c_str());
+	}
+
+public:
+	void test_index_roundtrip() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// A directory which was last changed a minute ago
+		const Common::String path = Common::getTestTempPath("scummvm-fs-index-test");
+		Common::FSNode dir(path);
+		TS_ASSERT(dir.exists() || dir.createDirectory());
+		TS_ASSERT(writeFile(dir.getChild("a.dat")));
+		if (!Common::setTestFileAge(path, 60)) {
+			removeTestDirectory(path);
+			return;
+		}
+		dir = Common::FSNode(path);
+
+		// Enable the index without ever writing it to disk
+		Common::FSIndex &index = FSIndexMan;
+		index.open(Common::FSNode(Common::getTestTempPath("scummvm-fs-index-test.dat")), true);
+
+		Common::FSList scanned, indexed;
+
+		TS_ASSERT(index.getChildren(dir, scanned));
+		TS_ASSERT_EQUALS(index.getScans(), 1u);
+		TS_ASSERT_EQUALS(index.getHits(), 0u);
+		TS_ASSERT_EQUALS(scanned.size(), 1u);
+
+		// The second listing comes from the index and matches the first one
+		TS_ASSERT(index.getChildren(dir, indexed));
+		TS_ASSERT_EQUALS(index.getScans(), 1u);
+		TS_ASSERT_EQUALS(index.getHits(), 1u);
+		TS_ASSERT_EQUALS(indexed.size(), scanned.size());
+		for (uint i = 0; i < indexed.size() && i < scanned.size(); ++i) {
+			TS_ASSERT_EQUALS(indexed[i].getPath(), scanned[i].getPath());
+			TS_ASSERT_EQUALS(indexed[i].isDirectory(), scanned[i].isDirectory());
+		}
+
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+		TS_ASSERT(index.save(out));
+
+		Common::MemoryReadStream in(out.getData(), out.size());
+		TS_ASSERT(index.load(in));
+		TS_ASSERT_EQUALS(index.size(), 1u);
+
+		// A damaged name only drops the record of its directory
+		byte *data = out.getData();
+		const uint nameOffset = 12 + 4 + dir.getPath().size() + 16 + 5;
+		data[nameOffset] ^= 0x20;
+		Common::MemoryReadStream damaged(data, out.size());
+		TS_ASSERT(index.load(damaged));
+		TS_ASSERT_EQUALS(index.size(), 0u);
+
+		// A truncated file is rejected as a whole
+		Common::MemoryReadStream truncated(data, out.size() - 1);
+		TS_ASSERT(!index.load(truncated));
+		TS_ASSERT_EQUALS(index.size(), 0u);
+
+		Common::FSIndex::destroy();
+		removeTestDirectory(path);
+#endif
+	}
+
+	void test_recently_modified() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		const Common::String path = Common::getTestTempPath("scummvm-fs-index-test");
+		Common::FSNode dir(path);
+		TS_ASSERT(dir.exists() || dir.createDirectory());
+		TS_ASSERT(writeFile(dir.getChild("a.dat")));
+
+		Common::FSIndex &index = FSIndexMan;
+		index.open(Common::FSNode(Common::getTestTempPath("scummvm-fs-index-test.dat")), true);
+
+		// Another change within the same second would keep the modification
+		// time, so the directory is listed again every time
+		Common::FSList list;
+		TS_ASSERT(index.getChildren(dir, list));
+		TS_ASSERT(writeFile(dir.getChild("b.dat")));
+		TS_ASSERT(index.getChildren(dir, list));
+		TS_ASSERT_EQUALS(list.size(), 2u);
+		TS_ASSERT_EQUALS(index.getHits(), 0u);
+		TS_ASSERT_EQUALS(index.size(), 0u);
+
+		Common::FSIndex::destroy();
+		removeTestDirectory(path);
+#endif
+	}
+
+	void test_disabled_index() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::FSIndex &index = FSIndexMan;
+		Common::FSList list;
+		TS_ASSERT(!index.isEnabled());
+		TS_ASSERT(index.getChildren(Common::FSNode("."), list));
+		TS_ASSERT_EQUALS(index.getScans(), 0u);
+		TS_ASSERT_EQUALS(index.size(), 0u);
+
+		Common::FSIndex::destroy();
+#endif
+	}
+};
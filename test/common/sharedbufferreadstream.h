@@ -0,0 +1,81 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/substream.h"
+
+class SharedBufferReadStreamTestSuite : public CxxTest::TestSuite {
+	private:
+	static Common::SharedBufferReadStream *createStream() {
+		byte *data = (byte *)malloc(10);
+		for (int i = 0; i < 10; ++i)
+			data[i] = i;
+		return new Common::SharedBufferReadStream(data, 10);
+	}
+
+	public:
+	void test_read_stream() {
+		Common::SharedBufferReadStream *stream = createStream();
+		stream->seek(2);
+
+		// The returned stream reads the memory of its parent
+		Common::SeekableReadStream *slice = stream->readStream(5);
+		TS_ASSERT_EQUALS(stream->pos(), 7);
+		TS_ASSERT_EQUALS(slice->size(), 5);
+		TS_ASSERT_EQUALS(dynamic_cast<Common::SharedBufferReadStream *>(slice)->getData(), stream->getData() + 2);
+
+		// and keeps it alive
+		delete stream;
+		TS_ASSERT_EQUALS(slice->readByte(), 2);
+		slice->seek(4);
+		TS_ASSERT_EQUALS(slice->readByte(), 6);
+		TS_ASSERT(!slice->eos());
+		slice->readByte();
+		TS_ASSERT(slice->eos());
+		delete slice;
+	}
+
+	void test_read_stream_end() {
+		Common::SharedBufferReadStream *stream = createStream();
+		stream->seek(8);
+
+		Common::SeekableReadStream *slice = stream->readStream(5);
+		TS_ASSERT_EQUALS(slice->size(), 2);
+		TS_ASSERT_EQUALS(stream->pos(), 10);
+		TS_ASSERT(stream->eos());
+
+		delete slice;
+		delete stream;
+	}
+
+	void test_slice() {
+		Common::SharedBufferReadStream *stream = createStream();
+		Common::SharedBufferReadStream *slice = stream->slice(3, 6);
+		delete stream;
+
+		// Slices of slices still share the memory
+		Common::SharedBufferReadStream *inner = slice->slice(1, 3);
+		TS_ASSERT_EQUALS(inner->getData(), slice->getData() + 1);
+		delete slice;
+
+		TS_ASSERT_EQUALS(inner->size(), 2);
+		TS_ASSERT_EQUALS(inner->readByte(), 4);
+		TS_ASSERT_EQUALS(inner->readByte(), 5);
+		delete inner;
+	}
+
+	void test_sub_stream() {
+		Common::SharedBufferReadStream *stream = createStream();
+		Common::SeekableSubReadStream sub(stream, 2, 8, DisposeAfterUse::YES);
+		sub.seek(1);
+
+		// Only the range of the sub stream is returned
+		Common::SeekableReadStream *slice = sub.readStream(10);
+		TS_ASSERT_EQUALS(slice->size(), 5);
+		TS_ASSERT_EQUALS(dynamic_cast<Common::SharedBufferReadStream *>(slice)->getData(), stream->getData() + 3);
+		TS_ASSERT_EQUALS(sub.pos(), 6);
+		TS_ASSERT(sub.eos());
+
+		TS_ASSERT_EQUALS(slice->readByte(), 3);
+		delete slice;
+	}
+};
@@ -152,6 +152,53 @@ class StringTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_EQUALS(foo2, "hhhhh");
 	}
 
+	void test_storage_inline() {
+		// Up to 19 characters are stored inside the object
+		Common::String foo1("0123456789abcdefghi");
+		const char *data = foo1.c_str();
+		TS_ASSERT_EQUALS(foo1.size(), 19u);
+		TS_ASSERT(data >= (const char *)&foo1 && data < (const char *)(&foo1 + 1));
+
+		Common::String foo2(foo1);
+		TS_ASSERT_DIFFERS(foo2.c_str(), foo1.c_str());
+		TS_ASSERT_EQUALS(foo2, foo1);
+	}
+
+	void test_storage_shared() {
+		// Copies of heap strings share the buffer until one is modified
+		Common::String foo1;
+		for (int i = 0; i < 200; ++i)
+			foo1 += 'x';
+		Common::String foo2(foo1);
+		TS_ASSERT_EQUALS(foo2.c_str(), foo1.c_str());
+
+		foo2.setChar('y', 100);
+		TS_ASSERT_DIFFERS(foo2.c_str(), foo1.c_str());
+		TS_ASSERT_EQUALS(foo1[100], 'x');
+		TS_ASSERT_EQUALS(foo2[100], 'y');
+
+		// Grow through several reallocations
+		Common::String foo3;
+		Common::String copies[8];
+		for (int i = 0; i < 2000; ++i) {
+			foo3 += (char)('a' + i % 26);
+			if (i % 250 == 0)
+				copies[i / 250] = foo3;
+		}
+		TS_ASSERT_EQUALS(foo3.size(), 2000u);
+		for (int i = 0; i < 2000; ++i)
+			TS_ASSERT_EQUALS(foo3[i], (char)('a' + i % 26));
+		for (int i = 0; i < 8; ++i)
+			TS_ASSERT(foo3.hasPrefix(copies[i]) && copies[i].size() == (uint)(i * 250 + 1));
+
+		Common::U32String foo4(foo3);
+		Common::U32String foo5(foo4);
+		foo5 += Common::U32String("!");
+		TS_ASSERT_EQUALS(foo4.size(), 2000u);
+		TS_ASSERT_EQUALS(foo5.size(), 2001u);
+		TS_ASSERT_EQUALS(foo4.encode(), foo3);
+	}
+
 	void test_self_asignment() {
 		Common::String foo1("12345678901234567890123456789012");
 		foo1 = foo1.c_str() + 2;
@@ -0,0 +1,127 @@
+#include <cxxtest/TestSuite.h>
+
+#include "backends/timer/default/default-timer.h"
+
+#include "../null_osystem.h"
+
+class TimerTestSuite : public CxxTest::TestSuite
+{
+#if NULL_OSYSTEM_IS_AVAILABLE
+	// Scheduling timers on a clock set by the test
+	class TestTimerManager : public DefaultTimerManager {
+	public:
+		uint32 _millis;
+
+		TestTimerManager() : _millis(0xFFFFFF00) {}
+
+	protected:
+		virtual uint32 getMillis(bool skipRecord) { return _millis; }
+	};
+
+	static Common::Array<int> *_calls;
+
+	static void timerA(void *refCon) { _calls->push_back(1); }
+	static void timerB(void *refCon) { _calls->push_back(2); }
+	static void timerC(void *refCon) {
+		_calls->push_back(3);
+		// Removing the running timer is allowed
+		((TestTimerManager *)refCon)->removeTimerProc(timerC);
+	}
+#endif
+
+public:
+	void test_schedule() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Array<int> calls;
+		_calls = &calls;
+
+		// The clock wraps around while the timers run
+		TestTimerManager manager;
+		manager.installTimerProc(timerA, 10000, nullptr, "a");
+		manager.installTimerProc(timerB, 2500, nullptr, "b");
+		manager.installTimerProc(timerC, 10000, &manager, "c");
+
+		manager._millis += 10;
+		manager.handler();
+		TS_ASSERT_EQUALS(calls.size(), 3u);
+
+		manager._millis += 1;
+		manager.handler();
+		// Timers with the same deadline fire in the order they were scheduled
+		const int expected[] = { 2, 2, 2, 1, 3, 2 };
+		TS_ASSERT_EQUALS(calls.size(), (uint)ARRAYSIZE(expected));
+		for (uint i = 0; i < calls.size() && i < ARRAYSIZE(expected); i++)
+			TS_ASSERT_EQUALS(calls[i], expected[i]);
+
+		Common::Array<Common::TimerManager::TimerStats> stats;
+		TS_ASSERT(manager.getTimerStats(stats));
+		TS_ASSERT_EQUALS(stats.size(), 2u);
+		for (uint i = 0; i < stats.size(); i++) {
+			if (stats[i].id == "b") {
+				TS_ASSERT_EQUALS(stats[i].calls, 4u);
+				// Only the last call was less than an interval late
+				TS_ASSERT_EQUALS(stats[i].overruns, 3u);
+				TS_ASSERT_EQUALS(stats[i].maxLatency, 7500u);
+				TS_ASSERT_EQUALS(stats[i].latencies[1], 1u);
+				TS_ASSERT_EQUALS(stats[i].latencies[2], 1u);
+				TS_ASSERT_EQUALS(stats[i].latencies[3], 2u);
+			} else {
+				TS_ASSERT_EQUALS(stats[i].id, "a");
+				TS_ASSERT_EQUALS(stats[i].calls, 1u);
+				TS_ASSERT_EQUALS(stats[i].overruns, 0u);
+				TS_ASSERT_EQUALS(stats[i].maxLatency, 1000u);
+			}
+		}
+
+		_calls = nullptr;
+#endif
+	}
+
+	void test_catch_up() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Array<int> calls;
+		_calls = &calls;
+
+		TestTimerManager manager;
+		manager.installTimerProc(timerA, 1000, nullptr, "a");
+
+		// A timer falling behind by a second is invoked for every missed
+		// deadline
+		manager._millis += 1000;
+		manager.handler();
+		TS_ASSERT_EQUALS(calls.size(), 999u);
+
+		Common::Array<Common::TimerManager::TimerStats> stats;
+		manager.getTimerStats(stats);
+		TS_ASSERT_EQUALS(stats.size(), 1u);
+		TS_ASSERT_EQUALS(stats[0].calls, 999u);
+		TS_ASSERT_EQUALS(stats[0].overruns, 999u);
+		TS_ASSERT_EQUALS(stats[0].maxLatency, 999000u);
+
+		// Back on schedule afterwards
+		calls.clear();
+		manager._millis += 5;
+		manager.handler();
+		TS_ASSERT_EQUALS(calls.size(), 5u);
+
+		manager.resetTimerStats();
+		manager.getTimerStats(stats);
+		TS_ASSERT_EQUALS(stats[0].id, "a");
+		TS_ASSERT_EQUALS(stats[0].calls, 0u);
+
+		manager.removeTimerProc(timerA);
+		manager.getTimerStats(stats);
+		TS_ASSERT(stats.empty());
+
+		_calls = nullptr;
+#endif
+	}
+};
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+Common::Array<int> *TimerTestSuite::_calls = nullptr;
+#endif
@@ -0,0 +1,101 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/unzip.h"
+
+// A zip file with a stored member "stored.txt", a deflated member
+// "Dir/Deflated.TXT" and an empty member "empty"
+static const byte zipData[] = {
+	0x50, 0x4b, 0x03, 0x04, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x00, 0xdc, 0xc9,
+	0xde, 0x8f, 0x3f, 0x00, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x73, 0x74,
+	0x6f, 0x72, 0x65, 0x64, 0x2e, 0x74, 0x78, 0x74, 0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x2c, 0x20, 0x73,
+	0x74, 0x6f, 0x72, 0x65, 0x64, 0x20, 0x77, 0x6f, 0x72, 0x6c, 0x64, 0x21, 0x0a, 0x48, 0x65, 0x6c,
+	0x6c, 0x6f, 0x2c, 0x20, 0x73, 0x74, 0x6f, 0x72, 0x65, 0x64, 0x20, 0x77, 0x6f, 0x72, 0x6c, 0x64,
+	0x21, 0x0a, 0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x2c, 0x20, 0x73, 0x74, 0x6f, 0x72, 0x65, 0x64, 0x20,
+	0x77, 0x6f, 0x72, 0x6c, 0x64, 0x21, 0x0a, 0x50, 0x4b, 0x03, 0x04, 0x14, 0x00, 0x00, 0x00, 0x08,
+	0x00, 0x00, 0x00, 0x21, 0x00, 0x54, 0xff, 0xfa, 0x6b, 0x0e, 0x00, 0x00, 0x00, 0x40, 0x01, 0x00,
+	0x00, 0x10, 0x00, 0x00, 0x00, 0x44, 0x69, 0x72, 0x2f, 0x44, 0x65, 0x66, 0x6c, 0x61, 0x74, 0x65,
+	0x64, 0x2e, 0x54, 0x58, 0x54, 0x0b, 0x4e, 0x2e, 0xcd, 0xcd, 0x0d, 0xf3, 0x55, 0x08, 0x1e, 0xa5,
+	0xc9, 0xa2, 0x01, 0x50, 0x4b, 0x03, 0x04, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00,
+	0x00, 0x65, 0x6d, 0x70, 0x74, 0x79, 0x50, 0x4b, 0x01, 0x02, 0x14, 0x03, 0x14, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x21, 0x00, 0xdc, 0xc9, 0xde, 0x8f, 0x3f, 0x00, 0x00, 0x00, 0x3f, 0x00,
+	0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01,
+	0x00, 0x00, 0x00, 0x00, 0x73, 0x74, 0x6f, 0x72, 0x65, 0x64, 0x2e, 0x74, 0x78, 0x74, 0x50, 0x4b,
+	0x01, 0x02, 0x14, 0x03, 0x14, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x21, 0x00, 0x54, 0xff,
+	0xfa, 0x6b, 0x0e, 0x00, 0x00, 0x00, 0x40, 0x01, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0x67, 0x00, 0x00, 0x00, 0x44, 0x69, 0x72, 0x2f,
+	0x44, 0x65, 0x66, 0x6c, 0x61, 0x74, 0x65, 0x64, 0x2e, 0x54, 0x58, 0x54, 0x50, 0x4b, 0x01, 0x02,
+	0x14, 0x03, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0xa3, 0x00, 0x00, 0x00, 0x65, 0x6d, 0x70, 0x74, 0x79, 0x50,
+	0x4b, 0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x03, 0x00, 0xa9, 0x00, 0x00, 0x00, 0xc6,
+	0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+class ZipTestSuite : public CxxTest::TestSuite
+{
+	Common::Archive *openZip() {
+		return Common::makeZipArchive(new Common::MemoryReadStream(zipData, sizeof(zipData)));
+	}
+
+	public:
+	void test_index() {
+		Common::ScopedPtr<Common::Archive> zip(openZip());
+		TS_ASSERT(zip);
+
+		Common::ArchiveMemberList list;
+		TS_ASSERT_EQUALS(zip->listMembers(list), 3);
+
+		TS_ASSERT(zip->hasFile("stored.txt"));
+		TS_ASSERT(zip->hasFile("dir/deflated.txt"));
+		TS_ASSERT(zip->hasFile("empty"));
+		TS_ASSERT(!zip->hasFile("missing"));
+	}
+
+	void test_stored() {
+		Common::ScopedPtr<Common::Archive> zip(openZip());
+		Common::ScopedPtr<Common::SeekableReadStream> stream(zip->createReadStreamForMember("STORED.TXT"));
+		TS_ASSERT(stream);
+
+		Common::String expected;
+		for (int i = 0; i < 3; ++i)
+			expected += "Hello, stored world!\n";
+
+		TS_ASSERT_EQUALS(stream->size(), (int64)expected.size());
+		TS_ASSERT_EQUALS(stream->readString(0, expected.size()), expected);
+	}
+
+	void test_deflated() {
+#ifdef USE_ZLIB
+		Common::ScopedPtr<Common::Archive> zip(openZip());
+		Common::ScopedPtr<Common::SeekableReadStream> stream(zip->createReadStreamForMember("Dir/Deflated.TXT"));
+		TS_ASSERT(stream);
+
+		Common::String expected;
+		for (int i = 0; i < 40; ++i)
+			expected += "ScummVM ";
+
+		TS_ASSERT_EQUALS(stream->size(), (int64)expected.size());
+		TS_ASSERT_EQUALS(stream->readString(0, expected.size()), expected);
+#endif
+	}
+
+	void test_corrupted() {
+#ifdef USE_ZLIB
+		// Damage the stored data, the CRC check has to catch it
+		byte *data = (byte *)malloc(sizeof(zipData));
+		memcpy(data, zipData, sizeof(zipData));
+		data[0x30] ^= 0xFF;
+
+		Common::ScopedPtr<Common::Archive> zip(Common::makeZipArchive(new Common::MemoryReadStream(data, sizeof(zipData), DisposeAfterUse::YES)));
+		TS_ASSERT(zip);
+		TS_ASSERT(zip->hasFile("stored.txt"));
+
+		Common::ScopedPtr<Common::SeekableReadStream> stream(zip->createReadStreamForMember("stored.txt"));
+		TS_ASSERT(!stream);
+#endif
+	}
+};
@@ -0,0 +1,114 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mixer_intern.h"
+#include "engines/scumm/imuse_digi/dimuse_engine.h"
+#include "engines/scumm/imuse_digi/dimuse_internalmixer.h"
+
+#include "../../null_osystem.h"
+
+class DiMUSEInternalMixerTestSuite : public CxxTest::TestSuite {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(ENABLE_SCUMM_7_8)
+private:
+	static const int kMixBufSize = 20480;
+
+	/**
+	 * Mix the same buffers with the vectorized and with the table based
+	 * kernels and return whether both end up with the same mix buffer.
+	 */
+	static bool mixMatches(Scumm::IMuseDigiInternalMixer &mixer, byte *mixBuf, const byte *initialMixBuf, const byte *src,
+	                       int32 inFrameCount, int wordSize, int channelCount, int feedSize, int volume, int pan) {
+		byte reference[kMixBufSize];
+		memcpy(mixBuf, initialMixBuf, kMixBufSize);
+		mixer.setUseSIMD(false);
+		mixer.mix(const_cast<byte *>(src), inFrameCount, wordSize, channelCount, feedSize, 3, volume, pan);
+		memcpy(reference, mixBuf, kMixBufSize);
+
+		memcpy(mixBuf, initialMixBuf, kMixBufSize);
+		mixer.setUseSIMD(true);
+		mixer.mix(const_cast<byte *>(src), inFrameCount, wordSize, channelCount, feedSize, 3, volume, pan);
+		return !memcmp(reference, mixBuf, kMixBufSize);
+	}
+
+public:
+	void test_equal_rate_kernels() {
+		// Every combination of word size, channel count and output channels is
+		// mixed at all volume levels onto a mix buffer filled with noise
+		Common::install_null_g_system();
+		Audio::MixerImpl audioMixer(22050);
+		audioMixer.setReady(true);
+
+		byte src[4096], initialMixBuf[kMixBufSize], mixBuf[kMixBufSize];
+		uint32 seed = 1;
+		for (int i = 0; i < ARRAYSIZE(src); ++i) {
+			seed = seed * 1103515245 + 12345;
+			src[i] = (seed >> 16) & 0xFF;
+		}
+		for (int i = 0; i < kMixBufSize; ++i) {
+			seed = seed * 1103515245 + 12345;
+			initialMixBuf[i] = (seed >> 16) & 0xFF;
+		}
+
+		const int wordSizes[] = { 8, 12, 16 };
+		const int frameCounts[] = { 1, 2, 7, 16, 203, 600 };
+		for (int outChannelCount = 1; outChannelCount <= 2; ++outChannelCount) {
+			Scumm::IMuseDigiInternalMixer mixer(&audioMixer);
+			TS_ASSERT_EQUALS(mixer.init(16, outChannelCount, mixBuf, kMixBufSize, 0, 8), 0);
+
+			int mismatches = 0;
+			for (int radioChatter = 0; radioChatter <= 1; ++radioChatter) {
+				if (radioChatter)
+					mixer.setRadioChatter();
+				else
+					mixer.clearRadioChatter();
+
+				for (int w = 0; w < ARRAYSIZE(wordSizes); ++w) {
+					for (int channelCount = 1; channelCount <= 2; ++channelCount) {
+						for (int f = 0; f < ARRAYSIZE(frameCounts); ++f) {
+							for (int volume = 0; volume <= 127; volume += 7) {
+								const int pan = (volume * 5) % 128;
+								if (!mixMatches(mixer, mixBuf, initialMixBuf, src, frameCounts[f], wordSizes[w], channelCount, frameCounts[f], volume, pan))
+									++mismatches;
+							}
+						}
+					}
+				}
+			}
+			TS_ASSERT_EQUALS(mismatches, 0);
+		}
+	}
+
+	void test_amplitudes() {
+		// All 12-bit and 16-bit sample values at every volume level and pan
+		// position, which covers every cell of the amplitude tables
+		Common::install_null_g_system();
+		Audio::MixerImpl audioMixer(22050);
+		audioMixer.setReady(true);
+
+		byte samples12[4096 / 2 * 3], samples16[4096 * 2], initialMixBuf[kMixBufSize], mixBuf[kMixBufSize];
+		for (int i = 0; i < 4096; i += 2) {
+			samples12[i / 2 * 3] = i & 0xFF;
+			samples12[i / 2 * 3 + 1] = ((i >> 8) & 0xF) | ((((i + 1) >> 8) & 0xF) << 4);
+			samples12[i / 2 * 3 + 2] = (i + 1) & 0xFF;
+		}
+		for (int i = 0; i < 4096; ++i)
+			((int16 *)samples16)[i] = (i - 2048) * 16 + (i & 15);
+		memset(initialMixBuf, 0, kMixBufSize);
+
+		for (int outChannelCount = 1; outChannelCount <= 2; ++outChannelCount) {
+			Scumm::IMuseDigiInternalMixer mixer(&audioMixer);
+			TS_ASSERT_EQUALS(mixer.init(16, outChannelCount, mixBuf, kMixBufSize, 0, 8), 0);
+
+			int mismatches = 0;
+			for (int volume = 0; volume <= 127; volume += 8) {
+				for (int pan = 0; pan <= 127; pan += 8) {
+					if (!mixMatches(mixer, mixBuf, initialMixBuf, samples12, 4096, 12, 1, 4096, volume, pan))
+						++mismatches;
+					if (!mixMatches(mixer, mixBuf, initialMixBuf, samples16, 4096, 16, 1, 4096, volume, pan))
+						++mismatches;
+				}
+			}
+			TS_ASSERT_EQUALS(mismatches, 0);
+		}
+	}
+#endif
+};
@@ -0,0 +1,88 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "engines/scumm/gfx.h"
+
+class ScummDirtyStripsTestSuite : public CxxTest::TestSuite {
+	/**
+	 * Merge strips 8 pixels wide, whose dirty parts go from tops[i] to
+	 * bottoms[i], like ScummEngine::updateDirtyScreen() does.
+	 */
+	static Common::Array<Common::Rect> mergeStrips(const int *tops, const int *bottoms, int count) {
+		Scumm::DirtyStripMerger merger;
+		Common::Array<Common::Rect> rects;
+		Common::Rect rect;
+		for (int i = 0; i < count; i++) {
+			if (bottoms[i] > tops[i] && merger.addStrip(Common::Rect(i * 8, tops[i], i * 8 + 8, bottoms[i]), rect))
+				rects.push_back(rect);
+		}
+		if (merger.finish(rect))
+			rects.push_back(rect);
+		return rects;
+	}
+
+public:
+	void test_identical_strips() {
+		const int tops[] = { 10, 10, 10, 10 };
+		const int bottoms[] = { 50, 50, 50, 50 };
+		const Common::Array<Common::Rect> rects = mergeStrips(tops, bottoms, ARRAYSIZE(tops));
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT_EQUALS(rects[0], Common::Rect(0, 10, 32, 50));
+	}
+
+	void test_similar_strips() {
+		// Strips of different heights are merged, since at most a quarter
+		// of the rectangle is clean
+		const int tops[] = { 10, 12, 10, 14 };
+		const int bottoms[] = { 50, 50, 48, 50 };
+		const Common::Array<Common::Rect> rects = mergeStrips(tops, bottoms, ARRAYSIZE(tops));
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT_EQUALS(rects[0], Common::Rect(0, 10, 32, 50));
+	}
+
+	void test_quarter_limit() {
+		// 8x40 and 8x20 pixels dirty in 16x40: exactly a quarter is clean
+		const int tops[] = { 0, 0 };
+		const int bottoms[] = { 40, 20 };
+		Common::Array<Common::Rect> rects = mergeStrips(tops, bottoms, ARRAYSIZE(tops));
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT_EQUALS(rects[0], Common::Rect(0, 0, 16, 40));
+
+		// One more clean line is too much
+		const int tops2[] = { 0, 0 };
+		const int bottoms2[] = { 40, 19 };
+		rects = mergeStrips(tops2, bottoms2, ARRAYSIZE(tops2));
+		TS_ASSERT_EQUALS(rects.size(), 2u);
+		TS_ASSERT_EQUALS(rects[0], Common::Rect(0, 0, 8, 40));
+		TS_ASSERT_EQUALS(rects[1], Common::Rect(8, 0, 16, 19));
+	}
+
+	void test_disjoint_strips() {
+		// Strips at different heights and strips with a clean one between
+		// them are kept apart
+		const int tops[] = { 0, 100, 0, 0, 0 };
+		const int bottoms[] = { 10, 110, 0, 10, 10 };
+		const Common::Array<Common::Rect> rects = mergeStrips(tops, bottoms, ARRAYSIZE(tops));
+		TS_ASSERT_EQUALS(rects.size(), 3u);
+		TS_ASSERT_EQUALS(rects[0], Common::Rect(0, 0, 8, 10));
+		TS_ASSERT_EQUALS(rects[1], Common::Rect(8, 100, 16, 110));
+		TS_ASSERT_EQUALS(rects[2], Common::Rect(24, 0, 40, 10));
+	}
+
+	void test_clean_area_accumulates() {
+		// The clean area of the merged rectangle grows with every strip,
+		// the third one is one too many
+		const int tops[] = { 0, 20, 20, 20, 20 };
+		const int bottoms[] = { 40, 40, 40, 40, 40 };
+		const Common::Array<Common::Rect> rects = mergeStrips(tops, bottoms, ARRAYSIZE(tops));
+		TS_ASSERT_EQUALS(rects.size(), 2u);
+		TS_ASSERT_EQUALS(rects[0], Common::Rect(0, 0, 16, 40));
+		TS_ASSERT_EQUALS(rects[1], Common::Rect(16, 20, 40, 40));
+	}
+
+	void test_no_dirty_strips() {
+		const int tops[] = { 0, 20 };
+		const int bottoms[] = { 0, 20 };
+		TS_ASSERT(mergeStrips(tops, bottoms, ARRAYSIZE(tops)).empty());
+	}
+};
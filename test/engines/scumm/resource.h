@@ -0,0 +1,46 @@
+#include <cxxtest/TestSuite.h>
+
+#include "engines/scumm/resource.h"
+
+class ScummResourceTestSuite : public CxxTest::TestSuite {
+	typedef Scumm::ResourceManager ResourceManager;
+
+public:
+	void test_expiry_score() {
+		const uint64 score = ResourceManager::getExpiryScore(2, 1000, 3);
+
+		// Old, large and rarely used resources are expired first
+		TS_ASSERT_LESS_THAN(score, ResourceManager::getExpiryScore(8, 1000, 3));
+		TS_ASSERT_LESS_THAN(score, ResourceManager::getExpiryScore(2, 50000, 3));
+		TS_ASSERT_LESS_THAN(ResourceManager::getExpiryScore(2, 1000, 40), score);
+
+		// Resources with a counter of 0 aren't loaded and score nothing,
+		// and the score of the largest ones doesn't overflow
+		TS_ASSERT_EQUALS(ResourceManager::getExpiryScore(0, 1000000, 0), 0u);
+		TS_ASSERT_EQUALS(ResourceManager::getExpiryScore(127, 0xFFFFFFFF, 0), 127ULL << 32);
+		TS_ASSERT_EQUALS(ResourceManager::getExpiryScore(1, 0, 0xFFFF), 0u);
+	}
+
+	void test_access_aging() {
+		ResourceManager::Resource res;
+		res._size = 1000;
+		for (int i = 0; i < 40; i++)
+			res.markAccessed();
+		TS_ASSERT_EQUALS(res.getAccesses(), 40);
+
+		// Old accesses weigh less than recent ones
+		const uint64 busyScore = ResourceManager::getExpiryScore(4, res._size, res.getAccesses());
+		res.ageAccesses();
+		TS_ASSERT_EQUALS(res.getAccesses(), 20);
+		TS_ASSERT_LESS_THAN(busyScore, ResourceManager::getExpiryScore(4, res._size, res.getAccesses()));
+
+		for (int i = 0; i < 5; i++)
+			res.ageAccesses();
+		TS_ASSERT_EQUALS(res.getAccesses(), 0);
+
+		// The count doesn't overflow
+		for (int i = 0; i < 0x10010; i++)
+			res.markAccessed();
+		TS_ASSERT_EQUALS(res.getAccesses(), 0xFFFF);
+	}
+};
@@ -0,0 +1,140 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "engines/scumm/he/wiz_he.h"
+
+class WizTestSuite : public CxxTest::TestSuite {
+#if defined(ENABLE_HE)
+private:
+	static const int kDstWidth = 64;
+	static const int kDstHeight = 48;
+
+	uint32 _seed;
+
+	uint32 nextRandom(uint32 max) {
+		_seed = _seed * 1103515245 + 12345;
+		return (_seed >> 8) % max;
+	}
+
+	/**
+	 * Create a random RLE compressed image, whose lines are made of
+	 * transparent, repeated and literal runs.
+	 */
+	void createImage(Common::Array<uint8> &data, int width, int height, int bytesPerPixel) {
+		data.clear();
+		for (int y = 0; y < height; y++) {
+			const uint lineStart = data.size();
+			data.push_back(0);
+			data.push_back(0);
+			if (nextRandom(8) == 0)
+				continue;
+
+			int x = 0;
+			while (x < width) {
+				const int count = MIN<int>(1 + nextRandom(nextRandom(2) ? 8 : 64), width - x);
+				switch (nextRandom(3)) {
+				case 0:
+					data.push_back((count << 1) | 1);
+					break;
+				case 1:
+					data.push_back(((count - 1) << 2) | 2);
+					for (int i = 0; i < bytesPerPixel; i++)
+						data.push_back(nextRandom(256));
+					break;
+				default:
+					data.push_back((count - 1) << 2);
+					for (int i = 0; i < count * bytesPerPixel; i++)
+						data.push_back(nextRandom(256));
+					break;
+				}
+				x += count;
+			}
+			const uint16 lineSize = data.size() - lineStart - 2;
+			data[lineStart] = lineSize & 0xFF;
+			data[lineStart + 1] = lineSize >> 8;
+		}
+	}
+
+	/**
+	 * Draw random images with random positions, clip rectangles, flips and
+	 * modes from their compressed data and from their decoded runs, and
+	 * return how many of them were drawn differently.
+	 */
+	int compareDraws(int bytesPerPixel, uint8 bitDepth, int count) {
+		Common::Array<uint8> palette(512), xmap(256 * 256), data;
+		for (uint i = 0; i < palette.size(); i++)
+			palette[i] = nextRandom(256);
+		for (uint i = 0; i < xmap.size(); i++)
+			xmap[i] = nextRandom(256);
+
+		const int dstPitch = kDstWidth * bitDepth;
+		Common::Array<uint8> background(dstPitch * kDstHeight), expected, actual;
+		int mismatches = 0;
+
+		for (int i = 0; i < count; i++) {
+			const int width = 1 + nextRandom(80);
+			const int height = 1 + nextRandom(60);
+			createImage(data, width, height, bytesPerPixel);
+
+			Scumm::WizDecodedImage image;
+			TS_ASSERT(Scumm::Wiz::decodeWizImage(image, data.begin(), width, height, bytesPerPixel));
+
+			const int srcx = (int)nextRandom(kDstWidth + 80) - 80;
+			const int srcy = (int)nextRandom(kDstHeight + 60) - 60;
+			Common::Rect clip;
+			clip.left = nextRandom(kDstWidth);
+			clip.top = nextRandom(kDstHeight);
+			clip.right = clip.left + 1 + nextRandom(kDstWidth);
+			clip.bottom = clip.top + 1 + nextRandom(kDstHeight);
+			const Common::Rect *rect = nextRandom(2) ? &clip : nullptr;
+
+			// A clip rectangle can cut a flipped image on both sides, which
+			// moves the part to draw past the end of its lines, where the
+			// compressed data can't be decoded. Flipped images are only
+			// clipped to the destination.
+			const int flags = rect ? 0 : nextRandom(4) * Scumm::kWIFFlipX;
+
+			const uint mode = nextRandom(3);
+			const uint8 *palPtr = (mode != 0) ? palette.begin() : nullptr;
+			const uint8 *xmapPtr = (mode == 2) ? xmap.begin() : nullptr;
+
+			for (uint j = 0; j < background.size(); j++)
+				background[j] = nextRandom(256);
+			expected = background;
+			actual = background;
+
+			if (bytesPerPixel == 2) {
+				Scumm::Wiz::copy16BitWizImage(expected.begin(), data.begin(), dstPitch, Scumm::kDstMemory, kDstWidth, kDstHeight,
+					srcx, srcy, width, height, rect, flags, xmapPtr);
+			} else {
+				Scumm::Wiz::copyWizImage(expected.begin(), data.begin(), dstPitch, Scumm::kDstMemory, kDstWidth, kDstHeight,
+					srcx, srcy, width, height, rect, flags, palPtr, xmapPtr, bitDepth);
+			}
+			Scumm::Wiz::copyDecodedWizImage(actual.begin(), image, dstPitch, Scumm::kDstMemory, kDstWidth, kDstHeight,
+				srcx, srcy, width, height, rect, flags, palPtr, xmapPtr, bitDepth);
+
+			if (memcmp(expected.begin(), actual.begin(), expected.size()))
+				mismatches++;
+		}
+		return mismatches;
+	}
+
+public:
+	void test_decoded_8bit_images() {
+		_seed = 1;
+		TS_ASSERT_EQUALS(compareDraws(1, 1, 8000), 0);
+	}
+
+	void test_decoded_8bit_images_on_16bit_screen() {
+		_seed = 2;
+		TS_ASSERT_EQUALS(compareDraws(1, 2, 8000), 0);
+	}
+
+#ifdef USE_RGB_COLOR
+	void test_decoded_16bit_images() {
+		_seed = 3;
+		TS_ASSERT_EQUALS(compareDraws(2, 2, 8000), 0);
+	}
+#endif
+#endif
+};
@@ -0,0 +1,116 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/scaler.h"
+#include "graphics/surface.h"
+
+class ThumbnailTestSuite : public CxxTest::TestSuite
+{
+private:
+	static uint16 average565(uint16 p1, uint16 p2, uint16 p3, uint16 p4) {
+		const uint r = ((p1 >> 11) + (p2 >> 11) + (p3 >> 11) + (p4 >> 11)) / 4;
+		const uint g = (((p1 >> 5) & 0x3F) + ((p2 >> 5) & 0x3F) + ((p3 >> 5) & 0x3F) + ((p4 >> 5) & 0x3F)) / 4;
+		const uint b = ((p1 & 0x1F) + (p2 & 0x1F) + (p3 & 0x1F) + (p4 & 0x1F)) / 4;
+		return (r << 11) | (g << 5) | b;
+	}
+
+	static void halve(Graphics::Surface &surf) {
+		for (int y = 0; y < surf.h / 2; ++y) {
+			for (int x = 0; x < surf.w / 2; ++x) {
+				*(uint16 *)surf.getBasePtr(x, y) = average565(*(uint16 *)surf.getBasePtr(2 * x, 2 * y),
+				                                              *(uint16 *)surf.getBasePtr(2 * x + 1, 2 * y),
+				                                              *(uint16 *)surf.getBasePtr(2 * x, 2 * y + 1),
+				                                              *(uint16 *)surf.getBasePtr(2 * x + 1, 2 * y + 1));
+			}
+		}
+		surf.w /= 2;
+		surf.h /= 2;
+	}
+
+public:
+	void test_halving() {
+		// A 640x400 screen is halved twice, which must average the channels of
+		// every 2x2 block in two steps
+		byte palette[256 * 3];
+		uint32 seed = 1;
+		for (int i = 0; i < 256 * 3; ++i) {
+			seed = seed * 1103515245 + 12345;
+			palette[i] = (seed >> 16) & 0xFF;
+		}
+
+		byte pixels[640 * 400];
+		for (int i = 0; i < 640 * 400; ++i) {
+			seed = seed * 1103515245 + 12345;
+			pixels[i] = (seed >> 16) & 0xFF;
+		}
+
+		Graphics::Surface reference;
+		reference.create(640, 400, Graphics::createPixelFormat<565>());
+		for (int i = 0; i < 640 * 400; ++i)
+			((uint16 *)reference.getPixels())[i] = reference.format.RGBToColor(palette[pixels[i] * 3], palette[pixels[i] * 3 + 1], palette[pixels[i] * 3 + 2]);
+		halve(reference);
+		halve(reference);
+
+		Graphics::Surface thumb;
+		TS_ASSERT(createThumbnail(&thumb, pixels, 640, 400, palette));
+		TS_ASSERT_EQUALS(thumb.w, kThumbnailWidth);
+		TS_ASSERT_EQUALS(thumb.h, kThumbnailHeight1);
+
+		bool matches = true;
+		for (int y = 0; y < thumb.h; ++y) {
+			for (int x = 0; x < thumb.w; ++x)
+				matches = matches && *(const uint16 *)thumb.getBasePtr(x, y) == *(const uint16 *)reference.getBasePtr(x, y);
+		}
+		TS_ASSERT(matches);
+
+		thumb.free();
+		reference.free();
+	}
+
+	void test_box_filter() {
+		// 500x350 is halved to 250x175 and then scaled to 160x112, centered in
+		// the thumbnail, which keeps a plain color as it is
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		Graphics::Surface screen;
+		screen.create(500, 350, format);
+		screen.fillRect(Common::Rect(500, 350), format.RGBToColor(200, 100, 40));
+
+		Graphics::Surface thumb;
+		TS_ASSERT(createThumbnail(&thumb, screen, nullptr));
+		TS_ASSERT_EQUALS(thumb.w, kThumbnailWidth);
+		TS_ASSERT_EQUALS(thumb.h, kThumbnailHeight2);
+
+		const uint16 color = thumb.format.RGBToColor(200, 100, 40);
+		int colored = 0, black = 0;
+		for (int y = 0; y < thumb.h; ++y) {
+			for (int x = 0; x < thumb.w; ++x) {
+				const uint16 pixel = *(const uint16 *)thumb.getBasePtr(x, y);
+				if (y >= 4 && y < 116)
+					colored += (pixel == color);
+				else
+					black += (pixel == 0);
+			}
+		}
+		TS_ASSERT_EQUALS(colored, 160 * 112);
+		TS_ASSERT_EQUALS(black, 160 * 8);
+
+		thumb.free();
+		screen.free();
+	}
+
+	void test_same_size() {
+		// A screen of the size of the thumbnail is copied as it is
+		Graphics::Surface screen;
+		screen.create(kThumbnailWidth, kThumbnailHeight2, Graphics::createPixelFormat<565>());
+		for (int i = 0; i < screen.w * screen.h; ++i)
+			((uint16 *)screen.getPixels())[i] = i * 2654435761u >> 16;
+
+		Graphics::Surface thumb;
+		TS_ASSERT(createThumbnail(&thumb, screen, nullptr));
+		TS_ASSERT_EQUALS(thumb.w, screen.w);
+		TS_ASSERT_EQUALS(thumb.h, screen.h);
+		TS_ASSERT(!memcmp(thumb.getPixels(), screen.getPixels(), screen.pitch * screen.h));
+
+		thumb.free();
+		screen.free();
+	}
+};
@@ -0,0 +1,236 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/surface.h"
+
+#ifdef USE_TINYGL
+#include "graphics/tinygl/tinygl.h"
+#include "graphics/tinygl/zgl.h"
+#endif
+
+class TinyGLTestSuite : public CxxTest::TestSuite
+{
+#ifdef USE_TINYGL
+private:
+	static const int kWidth = 160;
+	static const int kHeight = 120;
+
+	static void drawScene(TGLuint texture, TinyGL::BlitImage *image, int frame) {
+		tglClearColor(0.1f, 0.2f, 0.3f, 1.0f);
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+
+		tglMatrixMode(TGL_PROJECTION);
+		tglLoadIdentity();
+		tglOrtho(0, kWidth, kHeight, 0, -10, 10);
+		tglMatrixMode(TGL_MODELVIEW);
+		tglLoadIdentity();
+
+		tglEnable(TGL_DEPTH_TEST);
+		tglShadeModel(TGL_SMOOTH);
+
+		// Overlapping triangles, some of them crossing the screen borders
+		tglBegin(TGL_TRIANGLES);
+		for (int i = 0; i < 12; i++) {
+			const float x = (float)((i * 37 + frame * 5) % (kWidth + 40)) - 20.0f;
+			const float y = (float)((i * 53) % (kHeight + 40)) - 20.0f;
+			tglColor4f(1.0f, (i % 3) / 2.0f, (i % 5) / 4.0f, 1.0f);
+			tglVertex3f(x, y, (float)(i % 7) - 3.0f);
+			tglColor4f(0.0f, 1.0f, (i % 2) ? 1.0f : 0.0f, 1.0f);
+			tglVertex3f(x + 70.0f, y + 15.0f, 2.0f);
+			tglColor4f(0.5f, 0.0f, 1.0f, 1.0f);
+			tglVertex3f(x + 20.0f, y + 60.0f, -2.0f);
+		}
+		tglEnd();
+
+		// A blended, textured quad
+		tglEnable(TGL_TEXTURE_2D);
+		tglBindTexture(TGL_TEXTURE_2D, texture);
+		tglEnable(TGL_BLEND);
+		tglBlendFunc(TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA);
+		tglBegin(TGL_QUADS);
+		tglColor4f(1.0f, 1.0f, 0.0f, 0.5f);
+		tglTexCoord2f(0.0f, 0.0f);
+		tglVertex3f(30.0f + frame, 30.0f, 5.0f);
+		tglTexCoord2f(1.0f, 0.0f);
+		tglVertex3f(130.0f, 25.0f, 5.0f);
+		tglTexCoord2f(1.0f, 1.0f);
+		tglVertex3f(125.0f, 95.0f, 5.0f);
+		tglTexCoord2f(0.0f, 1.0f);
+		tglVertex3f(25.0f, 100.0f, 5.0f);
+		tglEnd();
+		tglDisable(TGL_BLEND);
+
+		// An opaque, smooth shaded triangle with a repeated texture
+		tglBegin(TGL_TRIANGLES);
+		tglColor4f(1.0f, 0.5f, 0.25f, 1.0f);
+		tglTexCoord2f(-1.0f, 0.5f);
+		tglVertex3f(5.0f, 60.0f + frame, 3.0f);
+		tglColor4f(0.25f, 1.0f, 1.0f, 1.0f);
+		tglTexCoord2f(2.5f, 0.0f);
+		tglVertex3f(150.0f, 70.0f, -1.0f);
+		tglColor4f(0.5f, 0.5f, 1.0f, 0.5f);
+		tglTexCoord2f(0.0f, 3.0f);
+		tglVertex3f(60.0f, 118.0f, 3.0f);
+		tglEnd();
+		tglDisable(TGL_TEXTURE_2D);
+
+		// Flat shaded, blended triangles, tested but not written to the depth buffer
+		tglShadeModel(TGL_FLAT);
+		tglEnable(TGL_BLEND);
+		tglBlendFunc(TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA);
+		tglDepthFunc(TGL_GEQUAL);
+		tglDepthMask(TGL_FALSE);
+		tglBegin(TGL_TRIANGLES);
+		for (int i = 0; i < 4; i++) {
+			tglColor4f(0.2f * i, 1.0f, 0.5f, 0.25f * (i + 1));
+			tglVertex3f(10.0f + i * 30.0f, 10.0f, 0.0f);
+			tglVertex3f(70.0f + i * 25.0f, 50.0f + frame, 0.0f);
+			tglVertex3f(5.0f + i * 35.0f, 110.0f, 0.0f);
+		}
+		tglEnd();
+		tglDepthMask(TGL_TRUE);
+		tglDepthFunc(TGL_LESS);
+		tglDisable(TGL_BLEND);
+		tglShadeModel(TGL_SMOOTH);
+
+		// A triangle which is only drawn to the depth buffer
+		tglColorMask(TGL_FALSE, TGL_FALSE, TGL_FALSE, TGL_FALSE);
+		tglBegin(TGL_TRIANGLES);
+		tglVertex3f(80.0f, 0.0f, 7.0f);
+		tglVertex3f(160.0f, 60.0f, -7.0f);
+		tglVertex3f(90.0f, 120.0f, 7.0f);
+		tglEnd();
+		tglColorMask(TGL_TRUE, TGL_TRUE, TGL_TRUE, TGL_TRUE);
+
+		tglBegin(TGL_LINES);
+		tglColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+		tglVertex3f(0.0f, 0.0f, 9.0f);
+		tglVertex3f((float)kWidth, (float)kHeight - frame, 9.0f);
+		tglEnd();
+
+		tglDisable(TGL_DEPTH_TEST);
+		tglBlit(image, 100 - frame * 3, 70);
+	}
+
+	/**
+	 * Render a few frames and return the contents of the color and depth
+	 * buffers after each one of them. The second frame is repeated.
+	 */
+	static Common::Array<byte> render(const Graphics::PixelFormat &format, bool dirtyRects, bool useSIMD) {
+		TinyGL::createContext(kWidth, kHeight, format, 256, true, dirtyRects);
+		TinyGL::gl_get_context()->fb->setUseSIMD(useSIMD);
+
+		Graphics::Surface sprite;
+		sprite.create(24, 16, format);
+		for (int y = 0; y < sprite.h; y++) {
+			for (int x = 0; x < sprite.w; x++)
+				sprite.setPixel(x, y, format.ARGBToColor((x + y) % 3 ? 255 : 0, x * 10, y * 15, 128));
+		}
+		byte texels[16 * 16 * 4];
+		for (int i = 0; i < 16 * 16; i++) {
+			texels[i * 4 + 0] = i;
+			texels[i * 4 + 1] = 255 - i;
+			texels[i * 4 + 2] = (i % 16) * 16;
+			texels[i * 4 + 3] = 200;
+		}
+		TGLuint texture;
+		tglGenTextures(1, &texture);
+		tglBindTexture(TGL_TEXTURE_2D, texture);
+		tglTexImage2D(TGL_TEXTURE_2D, 0, TGL_RGBA, 16, 16, 0, TGL_RGBA, TGL_UNSIGNED_BYTE, texels);
+
+		TinyGL::BlitImage *image = tglGenBlitImage();
+		tglUploadBlitImage(image, sprite, 0, false);
+		sprite.free();
+
+		Common::Array<byte> frames;
+		const int sequence[] = { 0, 1, 1, 2 };
+		for (int i = 0; i < ARRAYSIZE(sequence); i++) {
+			drawScene(texture, image, sequence[i]);
+			TinyGL::presentBuffer();
+
+			Graphics::Surface surface;
+			TinyGL::getSurfaceRef(surface);
+			const byte *pixels = (const byte *)surface.getPixels();
+			frames.push_back(Common::Array<byte>(pixels, surface.pitch * surface.h));
+
+			const byte *depth = (const byte *)TinyGL::gl_get_context()->fb->getZBuffer();
+			frames.push_back(Common::Array<byte>(depth, kWidth * kHeight * sizeof(uint)));
+		}
+
+		tglDeleteBlitImage(image);
+		tglDeleteTextures(1, &texture);
+		TinyGL::destroyContext();
+		return frames;
+	}
+
+public:
+	void test_dirty_rects() {
+		// Redrawing only the dirty rectangles must give the same frames as
+		// redrawing the whole screen
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 0, 8, 16, 24);
+		TS_ASSERT(render(format, true, true) == render(format, false, true));
+	}
+
+	void test_dirty_tiles() {
+		// A small triangle showing up before a large static one shifts all the
+		// draw calls after it in the queue. Only the tiles the small triangle
+		// touches must be redrawn, and nothing when a frame is repeated.
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 0, 8, 16, 24);
+		TinyGL::createContext(kWidth, kHeight, format, 256, true, true);
+
+		const bool showSmall[] = { false, false, true };
+		int dirtyPixels[ARRAYSIZE(showSmall)];
+		for (int i = 0; i < ARRAYSIZE(showSmall); i++) {
+			tglClearColor(0.1f, 0.2f, 0.3f, 1.0f);
+			tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+			tglMatrixMode(TGL_PROJECTION);
+			tglLoadIdentity();
+			tglOrtho(0, kWidth, kHeight, 0, -10, 10);
+			tglMatrixMode(TGL_MODELVIEW);
+			tglLoadIdentity();
+
+			if (showSmall[i]) {
+				tglBegin(TGL_TRIANGLES);
+				tglColor4f(0.0f, 1.0f, 0.0f, 1.0f);
+				tglVertex3f(120.0f, 90.0f, 1.0f);
+				tglVertex3f(150.0f, 100.0f, 1.0f);
+				tglVertex3f(130.0f, 115.0f, 1.0f);
+				tglEnd();
+			}
+
+			tglBegin(TGL_TRIANGLES);
+			tglColor4f(1.0f, 0.0f, 0.0f, 1.0f);
+			tglVertex3f(0.0f, 0.0f, 0.0f);
+			tglVertex3f((float)kWidth, 0.0f, 0.0f);
+			tglVertex3f(0.0f, (float)kHeight, 0.0f);
+			tglEnd();
+
+			Common::List<Common::Rect> dirtyAreas;
+			TinyGL::presentBuffer(dirtyAreas);
+			dirtyPixels[i] = 0;
+			for (Common::List<Common::Rect>::const_iterator it = dirtyAreas.begin(); it != dirtyAreas.end(); ++it)
+				dirtyPixels[i] += it->width() * it->height();
+		}
+
+		TinyGL::destroyContext();
+
+		TS_ASSERT_EQUALS(dirtyPixels[0], kWidth * kHeight);
+		TS_ASSERT_EQUALS(dirtyPixels[1], 0);
+		TS_ASSERT_LESS_THAN(0, dirtyPixels[2]);
+		TS_ASSERT_LESS_THAN(dirtyPixels[2], kWidth * kHeight / 4);
+	}
+
+	void test_simd_spans() {
+		// The vectorized spans must match the scalar ones byte for byte
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 24, 16, 8, 0),
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0)
+		};
+		for (int i = 0; i < ARRAYSIZE(formats); i++) {
+			TS_ASSERT(render(formats[i], false, true) == render(formats[i], false, false));
+		}
+	}
+
+#endif
+};
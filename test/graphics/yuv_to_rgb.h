@@ -0,0 +1,110 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite
+{
+private:
+	enum Subsampling {
+		k444,
+		k420,
+		k420Alpha
+	};
+
+	static void fillPlane(byte *plane, int width, int height, int pitch, uint32 seed) {
+		for (int y = 0; y < height; ++y) {
+			for (int x = 0; x < width; ++x) {
+				seed = seed * 1103515245 + 12345;
+				plane[y * pitch + x] = (seed >> 16) & 0xFF;
+			}
+		}
+	}
+
+	static void convert(Graphics::Surface &dst, Subsampling mode, Graphics::YUVToRGBManager::LuminanceScale scale,
+	                    const byte *y, const byte *u, const byte *v, const byte *a, int width, int height, int yPitch, int uvPitch) {
+		switch (mode) {
+		case k444:
+			YUVToRGBMan.convert444(&dst, scale, y, u, v, width, height, yPitch, uvPitch);
+			break;
+		case k420:
+			YUVToRGBMan.convert420(&dst, scale, y, u, v, width, height, yPitch, uvPitch);
+			break;
+		case k420Alpha:
+			YUVToRGBMan.convert420Alpha(&dst, scale, y, u, v, a, width, height, yPitch, uvPitch);
+			break;
+		}
+	}
+
+	/**
+	 * Convert the same image with the lookup table routines and the
+	 * vectorized routines, and compare the output byte for byte.
+	 */
+	void compareTemplate(Subsampling mode, const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale, int width, int height) {
+		const int yPitch = width + 5;
+		const int uvWidth = (mode == k444) ? width : width / 2;
+		const int uvHeight = (mode == k444) ? height : height / 2;
+		const int uvPitch = uvWidth + 3;
+
+		byte *y = new byte[yPitch * height];
+		byte *a = new byte[yPitch * height];
+		byte *u = new byte[uvPitch * uvHeight];
+		byte *v = new byte[uvPitch * uvHeight];
+		fillPlane(y, width, height, yPitch, 1);
+		fillPlane(a, width, height, yPitch, 2);
+		fillPlane(u, uvWidth, uvHeight, uvPitch, 3);
+		fillPlane(v, uvWidth, uvHeight, uvPitch, 4);
+
+		Graphics::Surface reference, simd;
+		reference.create(width, height, format);
+		simd.create(width, height, format);
+
+		YUVToRGBMan.setUseSIMD(false);
+		convert(reference, mode, scale, y, u, v, a, width, height, yPitch, uvPitch);
+		YUVToRGBMan.setUseSIMD(true);
+		convert(simd, mode, scale, y, u, v, a, width, height, yPitch, uvPitch);
+
+		for (int row = 0; row < height; ++row)
+			TS_ASSERT_EQUALS(memcmp(reference.getBasePtr(0, row), simd.getBasePtr(0, row), width * format.bytesPerPixel), 0);
+
+		reference.free();
+		simd.free();
+		delete[] y;
+		delete[] a;
+		delete[] u;
+		delete[] v;
+	}
+
+	void compareAllFormats(Subsampling mode, int width, int height) {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 0, 8, 16, 0)
+		};
+
+		for (int i = 0; i < ARRAYSIZE(formats); ++i) {
+			compareTemplate(mode, formats[i], Graphics::YUVToRGBManager::kScaleFull, width, height);
+			compareTemplate(mode, formats[i], Graphics::YUVToRGBManager::kScaleITU, width, height);
+		}
+	}
+
+public:
+	void test_convert444() {
+		compareAllFormats(k444, 262, 16);
+	}
+
+	void test_convert420() {
+		compareAllFormats(k420, 262, 16);
+	}
+
+	void test_convert420_alpha() {
+		compareAllFormats(k420Alpha, 262, 16);
+	}
+
+	void test_convert_narrow() {
+		compareAllFormats(k420, 6, 4);
+		compareAllFormats(k444, 8, 2);
+	}
+};
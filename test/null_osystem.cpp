@@ -1,12 +1,56 @@
 #define USE_NULL_DRIVER 1
 #define NULL_DRIVER_USE_FOR_TEST 1
-#include "null_osystem.h"
+#define FORBIDDEN_SYMBOL_EXCEPTION_getenv
+#if defined(POSIX)
+#include <fcntl.h>
+#endif
 #include "../backends/platform/null/null.cpp"
+#include "null_osystem.h"
 
 void Common::install_null_g_system() {
 	g_system = OSystem_NULL_create();
 }
 
+Common::String Common::getTestTempPath(const char *name) {
+#if defined(POSIX)
+	const char *dir = getenv("TMPDIR");
+	Common::String path = (dir && *dir) ? dir : "/tmp";
+	if (path.lastChar() != '/')
+		path += '/';
+	return path + name;
+#elif defined(WIN32)
+	char dir[MAX_PATH + 1];
+	if (!GetTempPathA(sizeof(dir), dir))
+		return name;
+	return Common::String(dir) + name;
+#endif
+}
+
+bool Common::setTestFileAge(const Common::String &path, int seconds) {
+#if defined(POSIX)
+	timeval times[2];
+	gettimeofday(&times[0], nullptr);
+	times[0].tv_sec -= seconds;
+	times[1] = times[0];
+	return utimes(path.c_str(), times) == 0;
+#else
+	return false;
+#endif
+}
+
+bool Common::evictTestFileCache(const Common::String &path) {
+#if defined(POSIX) && defined(POSIX_FADV_DONTNEED)
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd == -1)
+		return false;
+	const bool evicted = fsync(fd) == 0 && posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+	close(fd);
+	return evicted;
+#else
+	return false;
+#endif
+}
+
 bool BaseBackend::setScaler(const char *name, int factor) {
 	return false;
 }
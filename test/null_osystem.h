@@ -1,8 +1,17 @@
 #ifndef TEST_NULL_OSYSTEM
 #define TEST_NULL_OSYSTEM 1
 namespace Common {
+class String;
 #if defined(POSIX) || defined(WIN32)
 void install_null_g_system();
+// Return the path of a scratch file or directory in the temporary directory
+String getTestTempPath(const char *name);
+// Set the modification time of a file or directory to the given number of
+// seconds ago, returns false if that is not supported
+bool setTestFileAge(const String &path, int seconds);
+// Evict the contents of a file from the page cache, returns false if that
+// is not supported
+bool evictTestFileCache(const String &path);
 #define NULL_OSYSTEM_IS_AVAILABLE 1
 #else
 #define NULL_OSYSTEM_IS_AVAILABLE 0
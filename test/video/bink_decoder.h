@@ -0,0 +1,103 @@
+#include <cxxtest/TestSuite.h>
+
+#include "video/bink_decoder.h"
+
+class BinkDecoderTestSuite : public CxxTest::TestSuite
+{
+#ifdef USE_BINK
+private:
+	static const int kPitch = 11;
+
+	uint32 _seed;
+
+	uint32 nextRandom(uint32 max) {
+		_seed = _seed * 1103515245 + 12345;
+		return (_seed >> 8) % max;
+	}
+
+	/**
+	 * Fill a block with random coefficients: sparse ones like in most
+	 * blocks of real videos, dense small ones, and dense large ones which
+	 * still keep the intermediate values of the C version in range.
+	 */
+	void createBlock(int32 *block) {
+		const int kind = nextRandom(3);
+		for (int i = 0; i < 64; i++) {
+			if (kind == 0)
+				block[i] = (i == 0 || nextRandom(4) == 0) ? (int32)nextRandom(2048) - 1024 : 0;
+			else if (kind == 1)
+				block[i] = (int32)nextRandom(256) - 128;
+			else
+				block[i] = (int32)nextRandom(8192) - 4096;
+		}
+	}
+
+	void createPlane(byte *plane) {
+		for (int i = 0; i < 8 * kPitch; i++)
+			plane[i] = nextRandom(256);
+	}
+
+public:
+	void test_idct() {
+		_seed = 1;
+		for (int n = 0; n < 20000; n++) {
+			int32 expected[64], actual[64];
+			createBlock(expected);
+			memcpy(actual, expected, sizeof(actual));
+
+			Video::BinkDecoder::setUseSIMD(false);
+			Video::BinkDecoder::IDCT(expected);
+			Video::BinkDecoder::setUseSIMD(true);
+			Video::BinkDecoder::IDCT(actual);
+
+			TS_ASSERT_SAME_DATA(expected, actual, sizeof(actual));
+		}
+	}
+
+	void test_idct_put_add() {
+		_seed = 2;
+		for (int n = 0; n < 20000; n++) {
+			const bool add = nextRandom(2);
+			int32 block[64], expectedBlock[64], actualBlock[64];
+			byte expected[8 * kPitch], actual[8 * kPitch];
+			createBlock(block);
+			createPlane(expected);
+			memcpy(actual, expected, sizeof(actual));
+			memcpy(expectedBlock, block, sizeof(block));
+			memcpy(actualBlock, block, sizeof(block));
+
+			Video::BinkDecoder::setUseSIMD(false);
+			if (add)
+				Video::BinkDecoder::IDCTAdd(expected, kPitch, expectedBlock);
+			else
+				Video::BinkDecoder::IDCTPut(expected, kPitch, expectedBlock);
+			Video::BinkDecoder::setUseSIMD(true);
+			if (add)
+				Video::BinkDecoder::IDCTAdd(actual, kPitch, actualBlock);
+			else
+				Video::BinkDecoder::IDCTPut(actual, kPitch, actualBlock);
+
+			TS_ASSERT_SAME_DATA(expected, actual, sizeof(actual));
+		}
+	}
+
+	void test_add_residue() {
+		_seed = 3;
+		for (int n = 0; n < 20000; n++) {
+			int16 block[64];
+			byte expected[8 * kPitch], actual[8 * kPitch];
+			for (int i = 0; i < 64; i++)
+				block[i] = (int16)nextRandom(0x10000);
+			createPlane(expected);
+			memcpy(actual, expected, sizeof(actual));
+
+			Video::BinkDecoder::setUseSIMD(false);
+			Video::BinkDecoder::addResidue(expected, kPitch, block);
+			Video::BinkDecoder::setUseSIMD(true);
+			Video::BinkDecoder::addResidue(actual, kPitch, block);
+
+			TS_ASSERT_SAME_DATA(expected, actual, sizeof(actual));
+		}
+	}
+#endif
+};
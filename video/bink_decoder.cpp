@@ -45,6 +45,14 @@
 #include "video/binkdata.h"
 #include "video/bink_decoder.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define BINK_SIMD_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define BINK_SIMD_NEON
+#endif
+
 static const uint32 kBIKfID = MKTAG('B', 'I', 'K', 'f');
 static const uint32 kBIKgID = MKTAG('B', 'I', 'K', 'g');
 static const uint32 kBIKhID = MKTAG('B', 'I', 'K', 'h');
@@ -952,11 +960,7 @@ void BinkDecoder::BinkVideoTrack::blockResidue(DecodeContext &ctx) {
 
 	readResidue(*ctx.video, block, v);
 
-	byte  *dst = ctx.dest;
-	int16 *src = block;
-	for (int i = 0; i < 8; i++, dst += ctx.pitch, src += 8)
-		for (int j = 0; j < 8; j++)
-			dst[j] += src[j];
+	addResidue(ctx.dest, ctx.pitch, block);
 }
 
 void BinkDecoder::BinkVideoTrack::blockIntra(DecodeContext &ctx) {
@@ -967,7 +971,7 @@ void BinkDecoder::BinkVideoTrack::blockIntra(DecodeContext &ctx) {
 
 	readDCTCoeffs(*ctx.video, block, true);
 
-	IDCTPut(ctx, block);
+	IDCTPut(ctx.dest, ctx.pitch, block);
 }
 
 void BinkDecoder::BinkVideoTrack::blockFill(DecodeContext &ctx) {
@@ -988,7 +992,7 @@ void BinkDecoder::BinkVideoTrack::blockInter(DecodeContext &ctx) {
 
 	readDCTCoeffs(*ctx.video, block, false);
 
-	IDCTAdd(ctx, block);
+	IDCTAdd(ctx.dest, ctx.pitch, block);
 }
 
 void BinkDecoder::BinkVideoTrack::blockPattern(DecodeContext &ctx) {
@@ -1467,7 +1471,192 @@ static inline void IDCTCol(int32 *dest, const int32 *src) {
 	}
 }
 
-void BinkDecoder::BinkVideoTrack::IDCT(int32 *block) {
+#if defined(BINK_SIMD_SSE2) || defined(BINK_SIMD_NEON)
+
+// The IDCT on four columns or rows at once. Integer overflow wraps around
+// like in the scalar version, so the results are identical.
+
+#if defined(BINK_SIMD_SSE2)
+
+typedef __m128i IDCTVec;
+
+static inline IDCTVec idctLoad(const int32 *src) { return _mm_loadu_si128((const __m128i *)src); }
+static inline void idctStore(int32 *dst, IDCTVec v) { _mm_storeu_si128((__m128i *)dst, v); }
+static inline IDCTVec idctAdd(IDCTVec a, IDCTVec b) { return _mm_add_epi32(a, b); }
+static inline IDCTVec idctSub(IDCTVec a, IDCTVec b) { return _mm_sub_epi32(a, b); }
+template<int shift> static inline IDCTVec idctShr(IDCTVec a) { return _mm_srai_epi32(a, shift); }
+static inline IDCTVec idctRound(IDCTVec a) { return _mm_srai_epi32(_mm_add_epi32(a, _mm_set1_epi32(0x7F)), 8); }
+
+// SSE2 only multiplies two 32-bit lanes at a time, the low halves of the
+// products are the same for signed and unsigned factors
+static inline IDCTVec idctMul(IDCTVec a, int32 factor) {
+	const __m128i f = _mm_set1_epi32(factor);
+	const __m128i even = _mm_mul_epu32(a, f);
+	const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), f);
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+static inline void idctTranspose(IDCTVec &r0, IDCTVec &r1, IDCTVec &r2, IDCTVec &r3) {
+	const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+	const __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+	const __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+	const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+	r0 = _mm_unpacklo_epi64(t0, t1);
+	r1 = _mm_unpackhi_epi64(t0, t1);
+	r2 = _mm_unpacklo_epi64(t2, t3);
+	r3 = _mm_unpackhi_epi64(t2, t3);
+}
+
+// Store the low bytes of eight values, like assigning them to a byte does
+static inline void idctPutBytes(byte *dst, IDCTVec lo, IDCTVec hi) {
+	const __m128i mask = _mm_set1_epi32(0xFF);
+	const __m128i words = _mm_packs_epi32(_mm_and_si128(lo, mask), _mm_and_si128(hi, mask));
+	_mm_storel_epi64((__m128i *)dst, _mm_packus_epi16(words, words));
+}
+
+static inline void addBytes(byte *dst, __m128i words) {
+	const __m128i sum = _mm_add_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)dst), _mm_setzero_si128()), words);
+	const __m128i bytes = _mm_and_si128(sum, _mm_set1_epi16(0xFF));
+	_mm_storel_epi64((__m128i *)dst, _mm_packus_epi16(bytes, bytes));
+}
+
+static inline void idctAddBytes(byte *dst, IDCTVec lo, IDCTVec hi) {
+	const __m128i mask = _mm_set1_epi32(0xFF);
+	addBytes(dst, _mm_packs_epi32(_mm_and_si128(lo, mask), _mm_and_si128(hi, mask)));
+}
+
+static inline void residueAddBytes(byte *dst, const int16 *src) {
+	addBytes(dst, _mm_loadu_si128((const __m128i *)src));
+}
+
+#elif defined(BINK_SIMD_NEON)
+
+typedef int32x4_t IDCTVec;
+
+static inline IDCTVec idctLoad(const int32 *src) { return vld1q_s32(src); }
+static inline void idctStore(int32 *dst, IDCTVec v) { vst1q_s32(dst, v); }
+static inline IDCTVec idctAdd(IDCTVec a, IDCTVec b) { return vaddq_s32(a, b); }
+static inline IDCTVec idctSub(IDCTVec a, IDCTVec b) { return vsubq_s32(a, b); }
+template<int shift> static inline IDCTVec idctShr(IDCTVec a) { return vshrq_n_s32(a, shift); }
+static inline IDCTVec idctRound(IDCTVec a) { return vshrq_n_s32(vaddq_s32(a, vdupq_n_s32(0x7F)), 8); }
+static inline IDCTVec idctMul(IDCTVec a, int32 factor) { return vmulq_n_s32(a, factor); }
+
+static inline void idctTranspose(IDCTVec &r0, IDCTVec &r1, IDCTVec &r2, IDCTVec &r3) {
+	const int32x4x2_t t01 = vtrnq_s32(r0, r1);
+	const int32x4x2_t t23 = vtrnq_s32(r2, r3);
+	r0 = vcombine_s32(vget_low_s32(t01.val[0]), vget_low_s32(t23.val[0]));
+	r1 = vcombine_s32(vget_low_s32(t01.val[1]), vget_low_s32(t23.val[1]));
+	r2 = vcombine_s32(vget_high_s32(t01.val[0]), vget_high_s32(t23.val[0]));
+	r3 = vcombine_s32(vget_high_s32(t01.val[1]), vget_high_s32(t23.val[1]));
+}
+
+// Narrowing keeps the low bytes, like assigning the values to a byte does
+static inline void idctPutBytes(byte *dst, IDCTVec lo, IDCTVec hi) {
+	const int16x8_t words = vcombine_s16(vmovn_s32(lo), vmovn_s32(hi));
+	vst1_u8(dst, vmovn_u16(vreinterpretq_u16_s16(words)));
+}
+
+static inline void addBytes(byte *dst, uint16x8_t words) {
+	vst1_u8(dst, vmovn_u16(vaddq_u16(vmovl_u8(vld1_u8(dst)), words)));
+}
+
+static inline void idctAddBytes(byte *dst, IDCTVec lo, IDCTVec hi) {
+	addBytes(dst, vreinterpretq_u16_s16(vcombine_s16(vmovn_s32(lo), vmovn_s32(hi))));
+}
+
+static inline void residueAddBytes(byte *dst, const int16 *src) {
+	addBytes(dst, vreinterpretq_u16_s16(vld1q_s16(src)));
+}
+
+#endif
+
+template<bool kRow>
+static inline IDCTVec idctMunge(IDCTVec v) {
+	return kRow ? idctRound(v) : v;
+}
+
+// IDCT_TRANSFORM on vectors
+template<bool kRow>
+static inline void idctTransform(IDCTVec *d, const IDCTVec *s) {
+	const IDCTVec a0 = idctAdd(s[0], s[4]);
+	const IDCTVec a1 = idctSub(s[0], s[4]);
+	const IDCTVec a2 = idctAdd(s[2], s[6]);
+	const IDCTVec a3 = idctShr<11>(idctMul(idctSub(s[2], s[6]), A1));
+	const IDCTVec a4 = idctAdd(s[5], s[3]);
+	const IDCTVec a5 = idctSub(s[5], s[3]);
+	const IDCTVec a6 = idctAdd(s[1], s[7]);
+	const IDCTVec a7 = idctSub(s[1], s[7]);
+	const IDCTVec b0 = idctAdd(a4, a6);
+	const IDCTVec b1 = idctShr<11>(idctMul(idctAdd(a5, a7), A3));
+	const IDCTVec b2 = idctAdd(idctSub(idctShr<11>(idctMul(a5, A4)), b0), b1);
+	const IDCTVec b3 = idctSub(idctShr<11>(idctMul(idctSub(a6, a4), A1)), b2);
+	const IDCTVec b4 = idctSub(idctAdd(idctShr<11>(idctMul(a7, A2)), b3), b1);
+	const IDCTVec c0 = idctAdd(a0, a2);
+	const IDCTVec c1 = idctSub(idctAdd(a1, a3), a2);
+	const IDCTVec c2 = idctAdd(idctSub(a1, a3), a2);
+	const IDCTVec c3 = idctSub(a0, a2);
+	d[0] = idctMunge<kRow>(idctAdd(c0, b0));
+	d[1] = idctMunge<kRow>(idctAdd(c1, b2));
+	d[2] = idctMunge<kRow>(idctAdd(c2, b3));
+	d[3] = idctMunge<kRow>(idctSub(c3, b4));
+	d[4] = idctMunge<kRow>(idctAdd(c3, b4));
+	d[5] = idctMunge<kRow>(idctSub(c2, b3));
+	d[6] = idctMunge<kRow>(idctSub(c1, b2));
+	d[7] = idctMunge<kRow>(idctSub(c0, b0));
+}
+
+/**
+ * Transform a block, out[2 * i] and out[2 * i + 1] receive the left and
+ * right half of row i. The columns are transformed first, four at a time,
+ * then the rows, after transposing them into columns.
+ */
+static inline void idctBlock(IDCTVec *out, const int32 *block) {
+	IDCTVec src[8], cols[2][8], rows[8];
+
+	// Columns 4 * h to 4 * h + 3, one vector per row
+	for (int h = 0; h < 2; h++) {
+		for (int i = 0; i < 8; i++)
+			src[i] = idctLoad(block + 8 * i + 4 * h);
+		idctTransform<false>(cols[h], src);
+	}
+
+	for (int g = 0; g < 2; g++) {
+		// Rows 4 * g to 4 * g + 3, one vector per column
+		for (int h = 0; h < 2; h++) {
+			for (int i = 0; i < 4; i++)
+				src[4 * h + i] = cols[h][4 * g + i];
+			idctTranspose(src[4 * h], src[4 * h + 1], src[4 * h + 2], src[4 * h + 3]);
+		}
+
+		idctTransform<true>(rows, src);
+
+		for (int h = 0; h < 2; h++) {
+			idctTranspose(rows[4 * h], rows[4 * h + 1], rows[4 * h + 2], rows[4 * h + 3]);
+			for (int i = 0; i < 4; i++)
+				out[2 * (4 * g + i) + h] = rows[4 * h + i];
+		}
+	}
+}
+
+#endif
+
+static bool s_useSIMD = true;
+
+void BinkDecoder::setUseSIMD(bool useSIMD) {
+	s_useSIMD = useSIMD;
+}
+
+void BinkDecoder::IDCT(int32 *block) {
+#if defined(BINK_SIMD_SSE2) || defined(BINK_SIMD_NEON)
+	if (s_useSIMD) {
+		IDCTVec rows[16];
+		idctBlock(rows, block);
+		for (int i = 0; i < 16; i++)
+			idctStore(block + 4 * i, rows[i]);
+		return;
+	}
+#endif
+
 	int i;
 	int32 temp[64];
 
@@ -1478,26 +1667,59 @@ void BinkDecoder::BinkVideoTrack::IDCT(int32 *block) {
 	}
 }
 
-void BinkDecoder::BinkVideoTrack::IDCTAdd(DecodeContext &ctx, int32 *block) {
+void BinkDecoder::IDCTAdd(byte *dest, uint32 pitch, int32 *block) {
+#if defined(BINK_SIMD_SSE2) || defined(BINK_SIMD_NEON)
+	if (s_useSIMD) {
+		IDCTVec rows[16];
+		idctBlock(rows, block);
+		for (int i = 0; i < 8; i++)
+			idctAddBytes(dest + i * pitch, rows[2 * i], rows[2 * i + 1]);
+		return;
+	}
+#endif
+
 	int i, j;
 
 	IDCT(block);
-	byte *dest = ctx.dest;
-	for (i = 0; i < 8; i++, dest += ctx.pitch, block += 8)
+	for (i = 0; i < 8; i++, dest += pitch, block += 8)
 		for (j = 0; j < 8; j++)
 			 dest[j] += block[j];
 }
 
-void BinkDecoder::BinkVideoTrack::IDCTPut(DecodeContext &ctx, int32 *block) {
+void BinkDecoder::IDCTPut(byte *dest, uint32 pitch, int32 *block) {
+#if defined(BINK_SIMD_SSE2) || defined(BINK_SIMD_NEON)
+	if (s_useSIMD) {
+		IDCTVec rows[16];
+		idctBlock(rows, block);
+		for (int i = 0; i < 8; i++)
+			idctPutBytes(dest + i * pitch, rows[2 * i], rows[2 * i + 1]);
+		return;
+	}
+#endif
+
 	int i;
 	int32 temp[64];
 	for (i = 0; i < 8; i++)
 		IDCTCol(&temp[i], &block[i]);
 	for (i = 0; i < 8; i++) {
-		IDCT_ROW( (&ctx.dest[i*ctx.pitch]), (&temp[8*i]) );
+		IDCT_ROW( (&dest[i*pitch]), (&temp[8*i]) );
 	}
 }
 
+void BinkDecoder::addResidue(byte *dest, uint32 pitch, const int16 *block) {
+#if defined(BINK_SIMD_SSE2) || defined(BINK_SIMD_NEON)
+	if (s_useSIMD) {
+		for (int i = 0; i < 8; i++, dest += pitch, block += 8)
+			residueAddBytes(dest, block);
+		return;
+	}
+#endif
+
+	for (int i = 0; i < 8; i++, dest += pitch, block += 8)
+		for (int j = 0; j < 8; j++)
+			dest[j] += block[j];
+}
+
 BinkDecoder::BinkAudioTrack::BinkAudioTrack(BinkDecoder::AudioInfo &audio, Audio::Mixer::SoundType soundType) :
 		AudioTrack(soundType),
 		_audioInfo(&audio) {
@@ -74,6 +74,21 @@ public:
 
 	Common::Rational getFrameRate();
 
+	/**
+	 * Enable or disable the SSE2/NEON versions of the IDCT and residue
+	 * kernels. They are enabled by default where available, and produce the
+	 * same output as the C versions.
+	 */
+	static void setUseSIMD(bool useSIMD);
+
+	// Bink video IDCT of an 8x8 block, in place or into the destination
+	static void IDCT(int32 *block);
+	static void IDCTPut(byte *dest, uint32 pitch, int32 *block);
+	static void IDCTAdd(byte *dest, uint32 pitch, int32 *block);
+
+	/** Add an 8x8 residue block to the destination. */
+	static void addResidue(byte *dest, uint32 pitch, const int16 *block);
+
 protected:
 	void readNextPacket();
 	bool supportsAudioTrackSwitching() const { return true; }
@@ -323,11 +338,6 @@ private:
 		void readDCS         (VideoFrame &video, Bundle &bundle, int startBits, bool hasSign);
 		void readDCTCoeffs   (VideoFrame &video, int32 *block, bool isIntra);
 		void readResidue     (VideoFrame &video, int16 *block, int masksCount);
-
-		// Bink video IDCT
-		void IDCT(int32 *block);
-		void IDCTPut(DecodeContext &ctx, int32 *block);
-		void IDCTAdd(DecodeContext &ctx, int32 *block);
 	};
 
 	class BinkAudioTrack : public AudioTrack {